@@ -0,0 +1,162 @@
+/*
+Autoscaling under changing load: threshold balancer vs sojourn-time controller
+
+Feeds a pool with paced blocking tasks (sleep, so extra workers help even on one core):
+a base rate the core workers handle, then 4 s of either
+  step    a sudden jump to a rate that needs several times as many workers
+  sine    a rate swinging between base and the step rate with a 2 s period
+Each load runs once per autoscale_mode. Thresholds uses the ThreadPoolConfig defaults
+(100 ms sampling, 3 debounce hits, 500 ms cooldown); Sojourn the default 2 ms queue-wait
+target and gains. Reported:
+  grown (ms)      time from the step until the pool has the workers the step needs
+  recover (ms)    time from the step until the backlog first drops back under pending_hi
+  peak pending    largest backlog seen
+  wait p50/p99    queue wait over the 4 s (histogram bucket bounds)
+  avg threads     mean worker count over the 4 s
+
+Usage: autoscale_benchmark [step_rate_per_s] [task_us] [max_threads]
+*/
+
+#include "thread_pool/thread_pool.hpp"
+#include "logger.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Result {
+    double      grown_ms{-1.0};
+    double      recover_ms{-1.0};
+    std::size_t peak_pending{0};
+    double      wait_p50_us{0.0};
+    double      wait_p99_us{0.0};
+    double      avg_threads{0.0};
+};
+
+enum class Load { Step, Sine };
+
+Result Run(thread_pool::AutoscaleMode mode, Load load, std::size_t base_rate, std::size_t step_rate,
+           std::chrono::microseconds task, std::size_t max_threads) {
+    thread_pool::ThreadPoolConfig cfg;
+    cfg.core_threads = 2;
+    cfg.max_threads = max_threads;
+    cfg.queue_cap = 65536;
+    cfg.autoscale_mode = mode;
+    thread_pool::ThreadPool pool(cfg);
+    pool.Start();
+
+    const auto needed = std::min<std::size_t>(
+        max_threads, static_cast<std::size_t>(std::ceil(static_cast<double>(step_rate) * task.count() * 1e-6)));
+    std::atomic<bool> stop_sampling{false};
+    std::atomic<long long> step_at_ns{0};
+    Result r;
+
+    // Sampler: backlog and worker count every millisecond once the load changes
+    std::thread sampler([&] {
+        bool exceeded = false;
+        double thread_sum = 0.0;
+        std::size_t samples = 0;
+        while (!stop_sampling.load(std::memory_order_acquire)) {
+            const auto step_ns = step_at_ns.load(std::memory_order_acquire);
+            if (step_ns != 0) {
+                const double ms = (Clock::now().time_since_epoch().count() - step_ns) * 1e-6;
+                const auto pending = pool.Pending();
+                const auto threads = pool.CurrentThreads();
+                r.peak_pending = std::max(r.peak_pending, pending);
+                thread_sum += static_cast<double>(threads);
+                ++samples;
+                if (r.grown_ms < 0 && threads >= needed) {
+                    r.grown_ms = ms;
+                }
+                if (pending >= cfg.pending_hi) {
+                    exceeded = true;
+                } else if (exceeded && r.recover_ms < 0) {
+                    r.recover_ms = ms;
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        if (!exceeded) {
+            r.recover_ms = 0.0;
+        }
+        r.avg_threads = samples == 0 ? 0.0 : thread_sum / static_cast<double>(samples);
+    });
+
+    // Paced submitter: one batch per millisecond at rate(t) tasks/s
+    auto run_phase = [&](auto rate, std::chrono::milliseconds length) {
+        const auto begin = Clock::now();
+        double owed = 0.0;
+        for (auto tick = begin; tick - begin < length; tick += std::chrono::milliseconds(1)) {
+            std::this_thread::sleep_until(tick);
+            owed += rate(std::chrono::duration<double>(tick - begin).count()) / 1000.0;
+            for (; owed >= 1.0; owed -= 1.0) {
+                pool.Post([task] { std::this_thread::sleep_for(task); });
+            }
+        }
+    };
+    const double base = static_cast<double>(base_rate);
+    const double peak = static_cast<double>(step_rate);
+    run_phase([&](double) { return base; }, std::chrono::milliseconds(1000));
+    pool.ResetStatistics();
+    step_at_ns.store(Clock::now().time_since_epoch().count(), std::memory_order_release);
+    if (load == Load::Step) {
+        run_phase([&](double) { return peak; }, std::chrono::milliseconds(4000));
+    } else {
+        const double two_pi = 2.0 * std::acos(-1.0);
+        run_phase([&](double t) { return base + (peak - base) * 0.5 * (1.0 - std::cos(two_pi * t / 2.0)); },
+                  std::chrono::milliseconds(4000));
+    }
+
+    stop_sampling.store(true, std::memory_order_release);
+    sampler.join();
+    const auto hist = pool.GetLatencyHistograms();
+    r.wait_p50_us = std::chrono::duration<double, std::micro>(hist.queue_wait.Percentile(0.50)).count();
+    r.wait_p99_us = std::chrono::duration<double, std::micro>(hist.queue_wait.Percentile(0.99)).count();
+    pool.Stop(thread_pool::StopMode::Graceful);
+    return r;
+}
+
+}
+
+int main(int argc, char** argv) {
+    thread_pool::log::SetLevel("warn");
+    const std::size_t step_rate = argc > 1 ? static_cast<std::size_t>(std::stoul(argv[1])) : 6000;
+    const auto task = std::chrono::microseconds(argc > 2 ? std::stol(argv[2]) : 1000);
+    const std::size_t max_threads = argc > 3 ? static_cast<std::size_t>(std::stoul(argv[3])) : 16;
+    const std::size_t base_rate = 500;
+
+    std::cout << "=== Autoscaling: load step and sine ===\n"
+              << "Task: sleep " << task.count() << "us, rate " << base_rate << "/s -> " << step_rate
+              << "/s, core 2, max " << max_threads
+              << ", Hardware threads: " << std::thread::hardware_concurrency() << "\n\n";
+    std::cout << std::left << std::setw(18) << "Scenario"
+              << std::right << std::setw(12) << "grown (ms)" << std::setw(14) << "recover (ms)"
+              << std::setw(14) << "peak pending" << std::setw(16) << "wait p50 (us)"
+              << std::setw(16) << "wait p99 (us)" << std::setw(13) << "avg threads" << std::endl;
+
+    for (const auto load : {Load::Step, Load::Sine}) {
+        for (const auto mode : {thread_pool::AutoscaleMode::Thresholds, thread_pool::AutoscaleMode::Sojourn}) {
+            const auto r = Run(mode, load, base_rate, step_rate, task, max_threads);
+            const std::string name = std::string(load == Load::Step ? "step " : "sine ")
+                                   + (mode == thread_pool::AutoscaleMode::Sojourn ? "Sojourn" : "Thresholds");
+            std::cout << std::left << std::setw(18) << name
+                      << std::right << std::fixed << std::setprecision(0)
+                      << std::setw(12) << r.grown_ms << std::setw(14) << r.recover_ms
+                      << std::setw(14) << r.peak_pending << std::setw(16) << r.wait_p50_us
+                      << std::setw(16) << r.wait_p99_us
+                      << std::setw(13) << std::setprecision(1) << r.avg_threads << std::endl;
+        }
+    }
+    std::cout << "\n(-1 = not reached during the 4 s)\n";
+    return 0;
+}
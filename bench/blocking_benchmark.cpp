@@ -0,0 +1,125 @@
+/*
+Managed blocking: mixed CPU / blocking workload with and without RunBlocking
+
+Posts a batch where every Nth task blocks (sleeps block_us, standing in for file I/O or a
+lock) and the rest do cpu_us of calibrated CPU work. The pool has 4 core / 8 max workers
+and the default Thresholds balancer. The same batch runs with the blocking call made
+plainly and then wrapped in ThreadPool::RunBlocking. Reported:
+  tasks/s         batch size / wall time
+  peak threads    most workers alive at once
+  compensations   compensating workers started by BlockingRegion
+
+Usage: blocking_benchmark [tasks] [block_every] [block_us] [cpu_us]
+*/
+
+#include "thread_pool/thread_pool.hpp"
+#include "logger.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+std::size_t g_iters_per_us = 1;
+
+void Burn(std::size_t iterations) {
+    volatile std::size_t sink = 0;
+    for (std::size_t i = 0; i < iterations; ++i) {
+        sink = sink + i;
+    }
+}
+
+// Fastest of several probes, so a preempted probe does not shrink the work per task
+void Calibrate() {
+    constexpr std::size_t kProbe = 10'000'000;
+    double best_us = 1e300;
+    for (int i = 0; i < 7; ++i) {
+        const auto start = Clock::now();
+        Burn(kProbe);
+        best_us = std::min(best_us, std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+    }
+    g_iters_per_us = std::max<std::size_t>(1, static_cast<std::size_t>(kProbe / best_us));
+}
+
+struct Result {
+    double      tasks_per_s{0.0};
+    std::size_t peak_threads{0};
+    std::size_t compensations{0};
+};
+
+Result Run(bool managed, std::size_t tasks, std::size_t block_every, std::chrono::microseconds block,
+           std::chrono::microseconds cpu) {
+    thread_pool::ThreadPoolConfig cfg;
+    cfg.core_threads = 4;
+    cfg.max_threads = 8;
+    cfg.queue_cap = 65536;
+    thread_pool::ThreadPool pool(cfg);
+    pool.Start();
+
+    std::atomic<std::size_t> done{0};
+    const auto cpu_iters = g_iters_per_us * static_cast<std::size_t>(cpu.count());
+    const auto start = Clock::now();
+    for (std::size_t i = 0; i < tasks; ++i) {
+        if (i % block_every == 0) {
+            pool.Post([&pool, &done, managed, block] {
+                if (managed) {
+                    pool.RunBlocking([block] { std::this_thread::sleep_for(block); });
+                } else {
+                    std::this_thread::sleep_for(block);
+                }
+                done.fetch_add(1, std::memory_order_release);
+            });
+        } else {
+            pool.Post([&done, cpu_iters] {
+                Burn(cpu_iters);
+                done.fetch_add(1, std::memory_order_release);
+            });
+        }
+    }
+    while (done.load(std::memory_order_acquire) < tasks) {
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    Result r;
+    r.tasks_per_s = static_cast<double>(tasks) / std::chrono::duration<double>(Clock::now() - start).count();
+    const auto stats = pool.GetStatistics();
+    r.peak_threads = stats.statistic_peak_threads;
+    r.compensations = stats.statistic_blocking_compensations;
+    pool.Stop(thread_pool::StopMode::Graceful);
+    return r;
+}
+
+}
+
+int main(int argc, char** argv) {
+    thread_pool::log::SetLevel("warn");
+    const std::size_t tasks = argc > 1 ? static_cast<std::size_t>(std::stoul(argv[1])) : 20000;
+    const std::size_t block_every = argc > 2 ? std::max<std::size_t>(1, std::stoul(argv[2])) : 4;
+    const auto block = std::chrono::microseconds(argc > 3 ? std::stol(argv[3]) : 2000);
+    const auto cpu = std::chrono::microseconds(argc > 4 ? std::stol(argv[4]) : 20);
+    Calibrate();
+
+    std::cout << "=== Managed blocking: mixed workload ===\n"
+              << "Tasks: " << tasks << ", every " << block_every << " blocks " << block.count()
+              << "us, others " << cpu.count() << "us CPU, core 4, max 8"
+              << ", Hardware threads: " << std::thread::hardware_concurrency() << "\n\n";
+    std::cout << std::left << std::setw(14) << "Blocking call"
+              << std::right << std::setw(14) << "tasks/s" << std::setw(15) << "peak threads"
+              << std::setw(16) << "compensations" << std::endl;
+
+    for (bool managed : {false, true}) {
+        const auto r = Run(managed, tasks, block_every, block, cpu);
+        std::cout << std::left << std::setw(14) << (managed ? "RunBlocking" : "plain")
+                  << std::right << std::fixed << std::setprecision(0)
+                  << std::setw(14) << r.tasks_per_s << std::setw(15) << r.peak_threads
+                  << std::setw(16) << r.compensations << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,166 @@
+/*
+Producer/consumer cardinality policies: specialised rings vs the MPMC ring
+
+Each shape runs once on BoundedCircularQueue<MultiProducer, MultiConsumer> and once on the
+variant it allows:
+  SPSC   1 producer, 1 consumer             SingleProducer, SingleConsumer
+  MPSC   `threads` producers, 1 consumer    MultiProducer, SingleConsumer
+  SPMC   1 producer, `threads` consumers    SingleProducer, MultiConsumer
+Producers push std::uint64_t one at a time (or in batches of `batch` with TryPushBatch);
+consumers drain with TryPop (or TryConsumeBatch). Then one submitter Posts empty tasks to a
+4-worker pool with single_submitter off and on. Reported:
+  Mops/s    items through the queue per second (pool: tasks Posted and run per second)
+  speedup   variant / MPMC
+
+Usage: cardinality_benchmark [items] [threads] [cap] [batch]
+*/
+
+#include "mpmc/bounded_circular_queue.hpp"
+#include "thread_pool/thread_pool.hpp"
+#include "logger.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+template <typename Producers, typename Consumers>
+double RunQueue(std::size_t items, std::size_t producers, std::size_t consumers, std::size_t cap,
+                std::size_t batch) {
+    BoundedCircularQueue<std::uint64_t, PaddedCellLayout, Producers, Consumers> queue(cap);
+    const std::size_t per_producer = items / producers;
+    const std::size_t total = per_producer * producers;
+    std::atomic<bool> go{false};
+    std::atomic<std::size_t> popped{0};
+    std::vector<std::thread> threads;
+    for (std::size_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            std::vector<std::uint64_t> buf;
+            std::size_t i = 0;
+            while (i < per_producer) {
+                std::size_t pushed = 0;
+                if (batch <= 1) {
+                    pushed = queue.TryPush(static_cast<std::uint64_t>(p * per_producer + i)) ? 1 : 0;
+                } else {
+                    buf.clear();
+                    for (std::size_t j = i; j < std::min(i + batch, per_producer); ++j) {
+                        buf.push_back(static_cast<std::uint64_t>(p * per_producer + j));
+                    }
+                    pushed = queue.TryPushBatch(buf.begin(), buf.end());
+                }
+                if (pushed == 0) {
+                    std::this_thread::yield();
+                }
+                i += pushed;
+            }
+        });
+    }
+    for (std::size_t c = 0; c < consumers; ++c) {
+        threads.emplace_back([&] {
+            std::uint64_t sink = 0;
+            std::uint64_t v = 0;
+            while (popped.load(std::memory_order_relaxed) < total) {
+                std::size_t n = 0;
+                if (batch <= 1) {
+                    if (queue.TryPop(v)) {
+                        sink += v;
+                        n = 1;
+                    }
+                } else {
+                    n = queue.TryConsumeBatch([&](std::uint64_t&& x) { sink += x; }, batch);
+                }
+                if (n == 0) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                popped.fetch_add(n, std::memory_order_relaxed);
+            }
+            static_cast<void>(sink);
+        });
+    }
+    const auto start = Clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& t : threads) {
+        t.join();
+    }
+    return static_cast<double>(total) / std::chrono::duration<double>(Clock::now() - start).count() / 1e6;
+}
+
+double RunPool(bool single_submitter, std::size_t items, std::size_t cap) {
+    thread_pool::ThreadPoolConfig cfg;
+    cfg.core_threads = 4;
+    cfg.max_threads = 4;
+    cfg.queue_cap = cap;
+    cfg.single_submitter = single_submitter;
+    thread_pool::ThreadPool pool(cfg);
+    pool.Start();
+
+    std::atomic<std::size_t> ran{0};
+    const auto start = Clock::now();
+    for (std::size_t i = 0; i < items; ++i) {
+        pool.Post([&ran] { ran.fetch_add(1, std::memory_order_relaxed); });
+    }
+    while (ran.load(std::memory_order_relaxed) < items) {
+        std::this_thread::yield();
+    }
+    const double secs = std::chrono::duration<double>(Clock::now() - start).count();
+    pool.Stop(thread_pool::StopMode::Graceful);
+    return static_cast<double>(items) / secs / 1e6;
+}
+
+}
+
+int main(int argc, char** argv) {
+    thread_pool::log::SetLevel("error");
+    const std::size_t items = argc > 1 ? static_cast<std::size_t>(std::stoul(argv[1])) : 4000000;
+    const std::size_t threads = argc > 2 ? std::max<std::size_t>(1, std::stoul(argv[2])) : 4;
+    const std::size_t cap = argc > 3 ? static_cast<std::size_t>(std::stoul(argv[3])) : 1024;
+    const std::size_t batch = argc > 4 ? std::max<std::size_t>(1, std::stoul(argv[4])) : 1;
+
+    std::cout << "=== Cardinality policies vs MPMC ===\n"
+              << "Items: " << items << ", threads " << threads << ", capacity " << cap << ", batch " << batch
+              << ", Hardware threads: " << std::thread::hardware_concurrency() << "\n\n";
+    std::cout << std::left << std::setw(8) << "Shape" << std::setw(22) << "Queue"
+              << std::right << std::setw(10) << "Mops/s" << std::setw(10) << "speedup" << std::endl;
+
+    auto print = [](const char* shape, const char* queue, double mops, double base) {
+        std::cout << std::left << std::setw(8) << shape << std::setw(22) << queue
+                  << std::right << std::fixed << std::setprecision(2) << std::setw(10) << mops
+                  << std::setw(9) << mops / base << "x" << std::endl;
+    };
+    {
+        const double base = RunQueue<MultiProducer, MultiConsumer>(items, 1, 1, cap, batch);
+        print("SPSC", "MultiP/MultiC", base, base);
+        print("SPSC", "SingleP/SingleC", RunQueue<SingleProducer, SingleConsumer>(items, 1, 1, cap, batch), base);
+    }
+    {
+        const double base = RunQueue<MultiProducer, MultiConsumer>(items, threads, 1, cap, batch);
+        print("MPSC", "MultiP/MultiC", base, base);
+        print("MPSC", "MultiP/SingleC", RunQueue<MultiProducer, SingleConsumer>(items, threads, 1, cap, batch), base);
+    }
+    {
+        const double base = RunQueue<MultiProducer, MultiConsumer>(items, 1, threads, cap, batch);
+        print("SPMC", "MultiP/MultiC", base, base);
+        print("SPMC", "SingleP/MultiC", RunQueue<SingleProducer, MultiConsumer>(items, 1, threads, cap, batch), base);
+    }
+    {
+        const std::size_t tasks = items / 4;
+        const double base = RunPool(false, tasks, cap);
+        print("pool", "shared ring", base, base);
+        print("pool", "single_submitter", RunPool(true, tasks, cap), base);
+    }
+    return 0;
+}
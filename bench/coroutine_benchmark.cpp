@@ -0,0 +1,138 @@
+/*
+Coroutine resumption microbenchmark (THREADPOOL_ENABLE_COROUTINES builds)
+
+Compares ways of chaining N short steps, each one continuing on a pool worker:
+  co_await Schedule   one coroutine hopping onto the pool N times
+  Post chain          each task posts its successor (the callback style)
+  Submit + Get        the caller blocks on a future per step
+  co_await Task<int>  N awaits of a trivial coroutine (frame + hand-off, no hop)
+plus many coroutines hopping concurrently.
+
+Usage: coroutine_benchmark [steps] [workers]
+*/
+
+#include "thread_pool/coroutine.hpp"
+#include "logger.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+namespace coro = thread_pool::coro;
+
+coro::Task<void> Hop(thread_pool::ThreadPool& pool, std::size_t steps) {
+    for (std::size_t i = 0; i < steps; ++i) {
+        co_await pool.Schedule();
+    }
+}
+
+coro::Task<int> One() {
+    co_return 1;
+}
+
+coro::Task<std::size_t> AwaitMany(std::size_t steps) {
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < steps; ++i) {
+        total += static_cast<std::size_t>(co_await One());
+    }
+    co_return total;
+}
+
+struct PostChain {
+    thread_pool::ThreadPool* pool;
+    std::size_t              left;
+    std::atomic<bool>*       done;
+    void operator()() {
+        if (--left == 0) {
+            done->store(true, std::memory_order_release);
+            return;
+        }
+        pool->Post(PostChain{pool, left, done});
+    }
+};
+
+template <typename Fn>
+double NsPerStep(std::size_t steps, Fn&& fn) {
+    const auto start = Clock::now();
+    fn();
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / static_cast<double>(steps);
+}
+
+void PrintRow(const std::string& name, double ns) {
+    std::cout << std::left << std::setw(24) << name
+              << std::right << std::fixed << std::setprecision(1) << std::setw(14) << ns
+              << std::setw(16) << std::setprecision(0) << 1e9 / ns << std::endl;
+}
+
+}
+
+int main(int argc, char** argv) {
+    thread_pool::log::SetLevel("warn");
+    const std::size_t steps = argc > 1 ? static_cast<std::size_t>(std::stoul(argv[1])) : 200000;
+    const std::size_t workers = argc > 2 ? static_cast<std::size_t>(std::stoul(argv[2])) : 2;
+
+    thread_pool::ThreadPoolConfig cfg;
+    cfg.core_threads = workers;
+    cfg.max_threads = workers;
+    cfg.queue_cap = 65536;
+    cfg.pending_hi = cfg.queue_cap; // Fixed worker count: never trip the balancer
+    cfg.pending_low = 0;
+    cfg.scale_up_threshold = 2.0;
+    cfg.scale_down_threshold = -1.0;
+    thread_pool::ThreadPool pool(cfg);
+    pool.Start();
+
+    std::cout << "=== Coroutine resumption benchmark ===\n"
+              << "Steps: " << steps << ", Workers: " << workers
+              << ", Hardware threads: " << std::thread::hardware_concurrency() << "\n\n";
+    std::cout << std::left << std::setw(24) << "Chain"
+              << std::right << std::setw(14) << "ns/step" << std::setw(16) << "steps/s" << std::endl;
+
+    PrintRow("co_await Schedule", NsPerStep(steps, [&] { coro::SyncWait(Hop(pool, steps)); }));
+
+    PrintRow("Post chain", NsPerStep(steps, [&] {
+        std::atomic<bool> done{false};
+        pool.Post(PostChain{&pool, steps, &done});
+        while (!done.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+    }));
+
+    const std::size_t blocking_steps = steps / 10;
+    PrintRow("Submit + Get", NsPerStep(blocking_steps, [&] {
+        for (std::size_t i = 0; i < blocking_steps; ++i) {
+            pool.Submit([] {}).Get();
+        }
+    }));
+
+    std::size_t sink = 0;
+    PrintRow("co_await Task<int>", NsPerStep(steps, [&] { sink += coro::SyncWait(AwaitMany(steps)); }));
+
+    // Many independent coroutines hopping at once
+    constexpr std::size_t kCoroutines = 64;
+    const std::size_t per = steps / kCoroutines;
+    PrintRow("64 x co_await Schedule", NsPerStep(per * kCoroutines, [&] {
+        std::atomic<std::size_t> finished{0};
+        auto run = [](thread_pool::ThreadPool& p, std::size_t n, std::atomic<std::size_t>& fin) -> coro::Task<void> {
+            co_await Hop(p, n);
+            fin.fetch_add(1, std::memory_order_release);
+        };
+        for (std::size_t c = 0; c < kCoroutines; ++c) {
+            coro::Spawn(pool, run(pool, per, finished));
+        }
+        while (finished.load(std::memory_order_acquire) < kCoroutines) {
+            std::this_thread::yield();
+        }
+    }));
+
+    pool.Stop(thread_pool::StopMode::Graceful);
+    std::cout << "\n(checksum " << sink << ")\n";
+    return 0;
+}
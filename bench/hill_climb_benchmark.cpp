@@ -0,0 +1,155 @@
+/*
+Hill-climbing concurrency tuner vs hand-picked thread counts
+
+Keeps a backlog of tasks queued and measures completed tasks per second for three kinds of
+task:
+  blocking   sleep task_us (I/O stand-in: more workers help until max_threads)
+  cpu        task_us of calibrated CPU work (no gain past the CPU count)
+  mixed      a fifth of task_us of CPU work, then sleep the rest
+Each workload runs on fixed pools of 2, 4 and 16 workers (core = max, Thresholds balancer
+pinned), then on a HillClimb pool that starts at 2 with max_threads 32. The HillClimb pool
+gets warmup_s to converge before the measurement. Reported:
+  tasks/s    completions per second during the measurement
+  threads    worker count at the end (HillClimb: the tuner's choice)
+
+Usage: hill_climb_benchmark [task_us] [warmup_s] [measure_s]
+*/
+
+#include "thread_pool/thread_pool.hpp"
+#include "logger.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+enum class Work { Blocking, Cpu, Mixed };
+
+// Fixed amount of CPU work (a wall-clock spin would finish early when preempted)
+std::size_t g_iters_per_us = 1;
+
+void Burn(std::size_t iterations) {
+    volatile std::size_t sink = 0;
+    for (std::size_t i = 0; i < iterations; ++i) {
+        sink = sink + i;
+    }
+}
+
+// Fastest of several probes, so a preempted probe does not shrink the work per task
+void Calibrate() {
+    constexpr std::size_t kProbe = 10'000'000;
+    double best_us = 1e300;
+    for (int i = 0; i < 7; ++i) {
+        const auto start = Clock::now();
+        Burn(kProbe);
+        best_us = std::min(best_us, std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+    }
+    g_iters_per_us = std::max<std::size_t>(1, static_cast<std::size_t>(kProbe / best_us));
+}
+
+void Spin(std::chrono::microseconds length) {
+    Burn(g_iters_per_us * static_cast<std::size_t>(length.count()));
+}
+
+struct Result {
+    double      tasks_per_s{0.0};
+    std::size_t threads{0};
+};
+
+Result Run(Work work, std::chrono::microseconds task, std::size_t fixed_threads,
+           std::chrono::seconds warmup, std::chrono::seconds measure) {
+    thread_pool::ThreadPoolConfig cfg;
+    cfg.queue_cap = 8192;
+    if (fixed_threads != 0) {
+        cfg.core_threads = fixed_threads;
+        cfg.max_threads = fixed_threads;
+    } else {
+        cfg.core_threads = 2;
+        cfg.max_threads = 32;
+        cfg.autoscale_mode = thread_pool::AutoscaleMode::HillClimb;
+    }
+    thread_pool::ThreadPool pool(cfg);
+    pool.Start();
+
+    std::atomic<std::size_t> done{0};
+    auto body = [work, task, &done] {
+        switch (work) {
+            case Work::Blocking:
+                std::this_thread::sleep_for(task);
+                break;
+            case Work::Cpu:
+                Spin(task);
+                break;
+            case Work::Mixed:
+                Spin(task / 5);
+                std::this_thread::sleep_for(task - task / 5);
+                break;
+        }
+        done.fetch_add(1, std::memory_order_relaxed);
+    };
+
+    // Keep 256..1024 tasks queued so the pool is never short of work
+    std::atomic<bool> stop{false};
+    std::thread feeder([&] {
+        while (!stop.load(std::memory_order_acquire)) {
+            while (pool.Pending() < 1024) {
+                pool.Post(body);
+            }
+            while (!stop.load(std::memory_order_acquire) && pool.Pending() > 256) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+    });
+
+    std::this_thread::sleep_for(fixed_threads != 0 ? std::chrono::seconds(0) : warmup);
+    const auto begin_done = done.load(std::memory_order_relaxed);
+    const auto begin = Clock::now();
+    std::this_thread::sleep_for(measure);
+    Result r;
+    r.tasks_per_s = static_cast<double>(done.load(std::memory_order_relaxed) - begin_done)
+                  / std::chrono::duration<double>(Clock::now() - begin).count();
+    r.threads = fixed_threads != 0 ? pool.CurrentThreads() : pool.GetStatistics().statistic_tuned_threads;
+
+    stop.store(true, std::memory_order_release);
+    feeder.join();
+    pool.Stop(thread_pool::StopMode::Force);
+    return r;
+}
+
+}
+
+int main(int argc, char** argv) {
+    thread_pool::log::SetLevel("error");  // every run ends with a force stop
+    Calibrate();
+    const auto task = std::chrono::microseconds(argc > 1 ? std::stol(argv[1]) : 1000);
+    const auto warmup = std::chrono::seconds(argc > 2 ? std::stol(argv[2]) : 6);
+    const auto measure = std::chrono::seconds(argc > 3 ? std::stol(argv[3]) : 2);
+
+    std::cout << "=== Hill-climbing tuner vs fixed thread counts ===\n"
+              << "Task: " << task.count() << "us, HillClimb warmup " << warmup.count() << "s, measure "
+              << measure.count() << "s, Hardware threads: " << std::thread::hardware_concurrency() << "\n\n";
+    std::cout << std::left << std::setw(12) << "Workload" << std::setw(14) << "Pool"
+              << std::right << std::setw(14) << "tasks/s" << std::setw(10) << "threads" << std::endl;
+
+    const std::pair<Work, const char*> workloads[] = {
+        {Work::Blocking, "blocking"}, {Work::Cpu, "cpu"}, {Work::Mixed, "mixed"}};
+    for (const auto& [work, name] : workloads) {
+        for (std::size_t fixed : {2, 4, 16, 0}) {
+            const auto r = Run(work, task, fixed, warmup, measure);
+            const std::string pool = fixed != 0 ? "fixed " + std::to_string(fixed) : "HillClimb";
+            std::cout << std::left << std::setw(12) << name << std::setw(14) << pool
+                      << std::right << std::fixed << std::setprecision(0)
+                      << std::setw(14) << r.tasks_per_s << std::setw(10) << r.threads << std::endl;
+        }
+    }
+    return 0;
+}
@@ -71,6 +71,12 @@ int main(int argc, char** argv) {
             if (p.contains("pending_low")) cfg.pending_low = p["pending_low"].get<std::size_t>();
             if (p.contains("debounce_hits")) cfg.debounce_hits = p["debounce_hits"].get<std::size_t>();
             if (p.contains("cooldown_ms")) cfg.cooldown_ms = p["cooldown_ms"].get<std::size_t>();
+            if (p.contains("scheduling_mode")) cfg.scheduling_mode = p["scheduling_mode"].get<std::string>();
+            if (p.contains("local_queue_cap")) cfg.local_queue_cap = p["local_queue_cap"].get<std::size_t>();
+            if (p.contains("idle_strategy")) cfg.idle_strategy = p["idle_strategy"].get<std::string>();
+            if (p.contains("max_spinning_workers")) cfg.max_spinning_workers = p["max_spinning_workers"].get<std::size_t>();
+            if (p.contains("priority_lane_cap")) cfg.priority_lane_cap = p["priority_lane_cap"].get<std::size_t>();
+            if (p.contains("priority_aging")) cfg.priority_aging = p["priority_aging"].get<std::size_t>();
         }
         if (j.contains("benchmark")) {
             const auto& b = j["benchmark"];
@@ -85,6 +91,11 @@ int main(int argc, char** argv) {
             if (b.contains("task_work_us")) cfg.task_work_us = b["task_work_us"].get<std::size_t>();
             if (b.contains("task_sleep_us")) cfg.task_sleep_us = b["task_sleep_us"].get<std::size_t>();
             if (b.contains("submit_threads")) cfg.submit_threads = b["submit_threads"].get<std::size_t>();
+            if (b.contains("fanout")) cfg.fanout = b["fanout"].get<std::size_t>();
+            if (b.contains("use_submit")) cfg.use_submit = b["use_submit"].get<bool>();
+            if (b.contains("task_priority")) cfg.task_priority = b["task_priority"].get<std::string>();
+            if (b.contains("probe_interval_us")) cfg.probe_interval_us = b["probe_interval_us"].get<std::size_t>();
+            if (b.contains("probe_priority")) cfg.probe_priority = b["probe_priority"].get<std::string>();
         }
     };
 
@@ -0,0 +1,165 @@
+/*
+Saturated drop-oldest (Overwrite) enqueue throughput
+
+8 producers push into an already full queue of capacity `cap` while one consumer pops, so
+nearly every push has to evict the oldest element. Three variants:
+  locked      the former BlockingQueueAdapter scheme: try a push, else take a mutex, pop the
+              oldest into a std::optional and push again
+  lock-free   BoundedCircularQueue::OverwritePush (evicts and reuses the cell with one CAS)
+  pool        ThreadPool with the Overwrite policy, 1 worker, empty tasks via Post
+Reported:
+  Mops/s      producer pushes per second, all producers together
+  evicted     share of pushes that dropped an older element
+
+Usage: overwrite_benchmark [ops_per_producer] [producers] [cap]
+*/
+
+#include "mpmc/bounded_circular_queue.hpp"
+#include "thread_pool/thread_pool.hpp"
+#include "logger.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using Queue = BoundedCircularQueue<std::uint64_t>;
+
+struct Result {
+    double mops{0.0};
+    double evicted{0.0};
+};
+
+// The pre-lock-free overwrite path, kept here as the baseline
+bool LockedOverwrite(Queue& queue, std::mutex& mu, std::uint64_t item) {
+    std::optional<std::uint64_t> hold(item);
+    auto try_push_hold = [&] {
+        return queue.TryPushWith([&](void* slot) {
+            ::new (slot) std::uint64_t(*hold);
+        });
+    };
+    if (try_push_hold()) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lk(mu);
+    std::optional<std::uint64_t> tmp;
+    if (!queue.TryPopConsume([&](std::uint64_t&& v) { tmp.emplace(v); })) {
+        return false;
+    }
+    try_push_hold();
+    return true;
+}
+
+template <typename Push>
+Result RunQueue(std::size_t ops, std::size_t producers, std::size_t cap, Push push) {
+    Queue queue(cap);
+    for (std::uint64_t i = 0; i < queue.Capacity(); ++i) {
+        queue.TryPush(i);
+    }
+    std::atomic<bool> go{false};
+    std::atomic<std::size_t> running{producers};
+    std::atomic<std::size_t> evicted{0};
+    std::vector<std::thread> threads;
+    for (std::size_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            std::size_t local = 0;
+            for (std::size_t i = 0; i < ops; ++i) {
+                local += push(queue, static_cast<std::uint64_t>(p * ops + i)) ? 1 : 0;
+            }
+            evicted.fetch_add(local, std::memory_order_relaxed);
+            running.fetch_sub(1, std::memory_order_release);
+        });
+    }
+    threads.emplace_back([&] {
+        std::uint64_t v = 0;
+        while (running.load(std::memory_order_acquire) != 0) {
+            if (!queue.TryPop(v)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    const auto start = Clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& t : threads) {
+        t.join();
+    }
+    const double secs = std::chrono::duration<double>(Clock::now() - start).count();
+    const double total = static_cast<double>(ops * producers);
+    return {total / secs / 1e6, static_cast<double>(evicted.load()) / total};
+}
+
+Result RunPool(std::size_t ops, std::size_t producers, std::size_t cap) {
+    thread_pool::ThreadPoolConfig cfg;
+    cfg.core_threads = 1;
+    cfg.max_threads = 1;
+    cfg.queue_cap = cap;
+    cfg.queue_policy = thread_pool::QueueFullPolicy::Overwrite;
+    thread_pool::ThreadPool pool(cfg);
+    pool.Start();
+
+    std::atomic<bool> go{false};
+    std::vector<std::thread> threads;
+    for (std::size_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&] {
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            for (std::size_t i = 0; i < ops; ++i) {
+                pool.Post([] {});
+            }
+        });
+    }
+    const auto start = Clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& t : threads) {
+        t.join();
+    }
+    const double secs = std::chrono::duration<double>(Clock::now() - start).count();
+    const double total = static_cast<double>(ops * producers);
+    const double evicted = static_cast<double>(pool.OverwrittedTasks()) / total;
+    pool.Stop(thread_pool::StopMode::Graceful);
+    return {total / secs / 1e6, evicted};
+}
+
+}
+
+int main(int argc, char** argv) {
+    thread_pool::log::SetLevel("error");
+    const std::size_t ops = argc > 1 ? static_cast<std::size_t>(std::stoul(argv[1])) : 500000;
+    const std::size_t producers = argc > 2 ? std::max<std::size_t>(1, std::stoul(argv[2])) : 8;
+    const std::size_t cap = argc > 3 ? static_cast<std::size_t>(std::stoul(argv[3])) : 1024;
+
+    std::cout << "=== Saturated Overwrite enqueue ===\n"
+              << "Producers: " << producers << " x " << ops << " pushes, capacity " << cap
+              << ", Hardware threads: " << std::thread::hardware_concurrency() << "\n\n";
+    std::cout << std::left << std::setw(12) << "Variant"
+              << std::right << std::setw(10) << "Mops/s" << std::setw(10) << "evicted" << std::endl;
+
+    auto print = [](const char* name, const Result& r) {
+        std::cout << std::left << std::setw(12) << name << std::right << std::fixed
+                  << std::setprecision(2) << std::setw(10) << r.mops
+                  << std::setw(9) << std::setprecision(0) << r.evicted * 100 << "%" << std::endl;
+    };
+    std::mutex mu;
+    print("locked", RunQueue(ops, producers, cap, [&mu](Queue& q, std::uint64_t v) {
+        return LockedOverwrite(q, mu, v);
+    }));
+    print("lock-free", RunQueue(ops, producers, cap, [](Queue& q, std::uint64_t v) {
+        return q.OverwritePush(std::move(v), [](std::uint64_t&&) {});
+    }));
+    print("pool", RunPool(ops, producers, cap));
+    return 0;
+}
@@ -0,0 +1,165 @@
+/*
+Parallel algorithms microbenchmark
+
+Times ParallelFor / ParallelReduce / ParallelInclusiveScan against a serial loop on:
+  compute   out[i] = 64 rounds of a dependent multiply-add chain per element
+  saxpy     y[i] += a * x[i] over two large float arrays (memory bound)
+  reduce    sum of a large float array (memory bound)
+  scan      inclusive prefix sum of a large int64 array (memory bound, two passes)
+plus the hand-rolled pattern it replaces: one Submit + one Future per element.
+Each entry is the best of 3 runs.
+
+Usage: parallel_algorithms_benchmark [workers] [elements]
+*/
+
+#include "thread_pool/parallel.hpp"
+#include "logger.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+template <typename Fn>
+double BestMs(Fn&& fn) {
+    double best = 1e300;
+    for (int run = 0; run < 3; ++run) {
+        const auto start = Clock::now();
+        fn();
+        best = std::min(best, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+    }
+    return best;
+}
+
+inline double Compute(std::size_t i) {
+    double x = static_cast<double>(i) * 1e-6;
+    for (int r = 0; r < 64; ++r) {
+        x = x * 1.0000001 + 0.5;
+    }
+    return x;
+}
+
+void PrintRow(const std::string& kernel, double serial_ms, double parallel_ms) {
+    std::cout << std::left << std::setw(22) << kernel
+              << std::right << std::fixed << std::setprecision(2)
+              << std::setw(14) << serial_ms << std::setw(14) << parallel_ms
+              << std::setw(10) << serial_ms / parallel_ms << "x" << std::endl;
+}
+
+}
+
+int main(int argc, char** argv) {
+    thread_pool::log::SetLevel("warn");
+    const std::size_t hw = std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t workers = argc > 1 ? static_cast<std::size_t>(std::stoul(argv[1])) : hw;
+    const std::size_t n = argc > 2 ? static_cast<std::size_t>(std::stoul(argv[2])) : (std::size_t{1} << 23);
+
+    thread_pool::ThreadPoolConfig cfg;
+    cfg.core_threads = workers;
+    cfg.max_threads = workers;
+    cfg.queue_cap = 65536;
+    cfg.pending_hi = cfg.queue_cap; // Fixed worker count: never trip the balancer
+    cfg.pending_low = 0;
+    cfg.scale_up_threshold = 2.0;
+    cfg.scale_down_threshold = -1.0;
+    thread_pool::ThreadPool pool(cfg);
+    pool.Start();
+
+    std::cout << "=== Parallel algorithms benchmark ===\n"
+              << "Workers: " << workers << ", Elements: " << n
+              << ", Hardware threads: " << hw << "\n\n";
+    std::cout << std::left << std::setw(22) << "Kernel"
+              << std::right << std::setw(14) << "Serial (ms)" << std::setw(14) << "Parallel (ms)"
+              << std::setw(11) << "Speedup" << std::endl;
+
+    const std::size_t compute_n = n / 8;
+    std::vector<double> out(compute_n);
+    const double serial_compute = BestMs([&] {
+        for (std::size_t i = 0; i < compute_n; ++i) {
+            out[i] = Compute(i);
+        }
+    });
+    const double parallel_compute = BestMs([&] {
+        thread_pool::ParallelFor(pool, std::size_t{0}, compute_n, [&](std::size_t i) { out[i] = Compute(i); });
+    });
+    PrintRow("compute", serial_compute, parallel_compute);
+
+    std::vector<float> x(n, 1.5f);
+    std::vector<float> y(n, 0.25f);
+    const double serial_saxpy = BestMs([&] {
+        for (std::size_t i = 0; i < n; ++i) {
+            y[i] += 2.0f * x[i];
+        }
+    });
+    const double parallel_saxpy = BestMs([&] {
+        thread_pool::ParallelFor(pool, std::size_t{0}, n, [&](std::size_t i) { y[i] += 2.0f * x[i]; });
+    });
+    PrintRow("saxpy", serial_saxpy, parallel_saxpy);
+
+    double sink = 0.0;
+    const double serial_reduce = BestMs([&] {
+        double acc = 0.0;
+        for (std::size_t i = 0; i < n; ++i) {
+            acc += x[i];
+        }
+        sink += acc;
+    });
+    const double parallel_reduce = BestMs([&] {
+        sink += thread_pool::ParallelReduce(
+            pool, std::size_t{0}, n, std::size_t{0}, 0.0,
+            [&](std::size_t lo, std::size_t hi, double acc) {
+                for (auto i = lo; i < hi; ++i) {
+                    acc += x[i];
+                }
+                return acc;
+            },
+            [](double a, double b) { return a + b; });
+    });
+    PrintRow("reduce", serial_reduce, parallel_reduce);
+
+    std::vector<std::int64_t> in(n);
+    std::iota(in.begin(), in.end(), std::int64_t{0});
+    std::vector<std::int64_t> prefix(n);
+    const double serial_scan = BestMs([&] { std::partial_sum(in.begin(), in.end(), prefix.begin()); });
+    const double parallel_scan = BestMs([&] {
+        thread_pool::ParallelInclusiveScan(pool, in.begin(), in.end(), prefix.begin());
+    });
+    PrintRow("scan", serial_scan, parallel_scan);
+
+    // The hand-rolled pattern: one task and one future per element
+    const std::size_t futures_n = std::min<std::size_t>(compute_n, 200000);
+    const double serial_small = BestMs([&] {
+        for (std::size_t i = 0; i < futures_n; ++i) {
+            out[i] = Compute(i);
+        }
+    });
+    const double futures_ms = BestMs([&] {
+        std::vector<thread_pool::Future<void>> futs;
+        futs.reserve(futures_n);
+        for (std::size_t i = 0; i < futures_n; ++i) {
+            futs.push_back(pool.Submit([&out, i] { out[i] = Compute(i); }));
+        }
+        for (auto& f : futs) {
+            f.Get();
+        }
+    });
+    const double parallel_small = BestMs([&] {
+        thread_pool::ParallelFor(pool, std::size_t{0}, futures_n, [&](std::size_t i) { out[i] = Compute(i); });
+    });
+    PrintRow("compute, Submit/elem", serial_small, futures_ms);
+    PrintRow("compute, ParallelFor", serial_small, parallel_small);
+
+    pool.Stop(thread_pool::StopMode::Graceful);
+    std::cout << "\n(checksum " << std::setprecision(1) << sink + out[futures_n / 2] + static_cast<double>(prefix.back()) << ")\n";
+    return 0;
+}
@@ -0,0 +1,134 @@
+/*
+BoundedCircularQueue batch microbenchmark
+
+Compares range-claiming TryPushBatch/TryPopBatch against a loop of single-element
+operations for batch sizes 1..256 (2 producers, 2 consumers, queue capacity 1024).
+
+Usage: queue_batch_benchmark [ops_per_run]
+*/
+
+#include "mpmc/bounded_circular_queue.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kProducers = 2;
+constexpr std::size_t kConsumers = 2;
+constexpr std::size_t kCapacity = 1024;
+
+// Returns element transfers per second
+template <bool kBatched>
+double RunOnce(std::size_t batch, std::size_t total_ops) {
+    BoundedCircularQueue<std::uint64_t> queue(kCapacity);
+    const std::size_t per_producer = total_ops / kProducers;
+    const std::size_t total = per_producer * kProducers;
+    std::atomic<std::size_t> consumed{0};
+    std::atomic<std::uint64_t> sink{0};
+    std::atomic<bool> go{false};
+
+    std::vector<std::thread> threads;
+    for (std::size_t p = 0; p < kProducers; ++p) {
+        threads.emplace_back([&] {
+            std::vector<std::uint64_t> buf(batch);
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            std::size_t sent = 0;
+            while (sent < per_producer) {
+                const std::size_t n = std::min(batch, per_producer - sent);
+                for (std::size_t i = 0; i < n; ++i) {
+                    buf[i] = sent + i;
+                }
+                std::size_t pushed = 0;
+                if constexpr (kBatched) {
+                    pushed = queue.TryPushBatch(buf.begin(), buf.begin() + static_cast<std::ptrdiff_t>(n));
+                } else {
+                    while (pushed < n && queue.TryPush(buf[pushed])) {
+                        ++pushed;
+                    }
+                }
+                sent += pushed;
+                if (pushed == 0) {
+                    std::this_thread::yield(); // Full; let consumers run on oversubscribed hosts
+                }
+            }
+        });
+    }
+    for (std::size_t c = 0; c < kConsumers; ++c) {
+        threads.emplace_back([&] {
+            std::vector<std::uint64_t> buf;
+            buf.reserve(batch);
+            std::uint64_t local = 0;
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            while (consumed.load(std::memory_order_relaxed) < total) {
+                buf.clear();
+                std::size_t n = 0;
+                if constexpr (kBatched) {
+                    n = queue.TryPopBatch(std::back_inserter(buf), batch);
+                } else {
+                    std::uint64_t v = 0;
+                    while (n < batch && queue.TryPop(v)) {
+                        buf.push_back(v);
+                        ++n;
+                    }
+                }
+                for (auto v : buf) {
+                    local += v;
+                }
+                if (n > 0) {
+                    consumed.fetch_add(n, std::memory_order_relaxed);
+                } else {
+                    std::this_thread::yield(); // Empty; let producers run on oversubscribed hosts
+                }
+            }
+            sink.fetch_add(local, std::memory_order_relaxed);
+        });
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& t : threads) {
+        t.join();
+    }
+    const auto secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return secs > 0 ? static_cast<double>(total) / secs : 0.0;
+}
+
+}
+
+int main(int argc, char** argv) {
+    const std::size_t ops = argc > 1 ? static_cast<std::size_t>(std::stoul(argv[1])) : 2000000;
+
+    std::cout << "=== BoundedCircularQueue batch benchmark ===\n"
+              << "Producers: " << kProducers << ", Consumers: " << kConsumers
+              << ", Capacity: " << kCapacity << ", Ops per run: " << ops << "\n\n";
+    std::cout << std::left << std::setw(8) << "Batch"
+              << std::right << std::setw(18) << "Loop (ops/s)"
+              << std::setw(18) << "Range (ops/s)"
+              << std::setw(10) << "Speedup" << std::endl;
+
+    for (std::size_t batch = 1; batch <= 256; batch *= 2) {
+        const double loop = RunOnce<false>(batch, ops);
+        const double range = RunOnce<true>(batch, ops);
+        std::cout << std::left << std::setw(8) << batch
+                  << std::right << std::fixed << std::setprecision(0)
+                  << std::setw(18) << loop
+                  << std::setw(18) << range
+                  << std::setw(9) << std::setprecision(2) << (loop > 0 ? range / loop : 0.0) << "x"
+                  << std::endl;
+    }
+    return 0;
+}
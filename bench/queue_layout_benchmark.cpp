@@ -0,0 +1,111 @@
+/*
+BoundedCircularQueue cell layout microbenchmark
+
+Compares PaddedCellLayout, PackedCellLayout and StripedCellLayout for an 8-byte payload:
+memory footprint of the cell array and MPMC throughput at a small and a large capacity
+(the large one matches the 200000-slot "High-Concurrency" scenario, rounded to 2^18).
+
+Usage: queue_layout_benchmark [ops_per_run] [producers] [consumers]
+*/
+
+#include "mpmc/bounded_circular_queue.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Returns element transfers per second
+template <typename Layout>
+double RunOnce(std::size_t capacity, std::size_t producers, std::size_t consumers, std::size_t total_ops) {
+    BoundedCircularQueue<std::uint64_t, Layout> queue(capacity);
+    const std::size_t per_producer = total_ops / producers;
+    const std::size_t total = per_producer * producers;
+    std::atomic<std::size_t> consumed{0};
+    std::atomic<std::uint64_t> sink{0};
+    std::atomic<bool> go{false};
+
+    std::vector<std::thread> threads;
+    for (std::size_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&] {
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            for (std::size_t i = 0; i < per_producer; ++i) {
+                while (!queue.TryPush(static_cast<std::uint64_t>(i))) {
+                    std::this_thread::yield(); // Full; let consumers run on oversubscribed hosts
+                }
+            }
+        });
+    }
+    for (std::size_t c = 0; c < consumers; ++c) {
+        threads.emplace_back([&] {
+            std::uint64_t local = 0;
+            std::uint64_t v = 0;
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            while (consumed.load(std::memory_order_relaxed) < total) {
+                if (queue.TryPop(v)) {
+                    local += v;
+                    consumed.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    std::this_thread::yield(); // Empty; let producers run on oversubscribed hosts
+                }
+            }
+            sink.fetch_add(local, std::memory_order_relaxed);
+        });
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& t : threads) {
+        t.join();
+    }
+    const auto secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return secs > 0 ? static_cast<double>(total) / secs : 0.0;
+}
+
+template <typename Layout>
+void Report(const char* name, std::size_t capacity, std::size_t producers, std::size_t consumers, std::size_t ops) {
+    const BoundedCircularQueue<std::uint64_t, Layout> probe(capacity);
+    const double mib = static_cast<double>(probe.MemoryFootprint()) / (1024.0 * 1024.0);
+    const double rate = RunOnce<Layout>(capacity, producers, consumers, ops);
+    std::cout << std::left << std::setw(10) << name
+              << std::right << std::setw(10) << capacity
+              << std::setw(12) << probe.CellSize()
+              << std::fixed << std::setprecision(2) << std::setw(14) << mib
+              << std::setprecision(0) << std::setw(18) << rate
+              << std::endl;
+}
+
+}
+
+int main(int argc, char** argv) {
+    const std::size_t ops = argc > 1 ? static_cast<std::size_t>(std::stoul(argv[1])) : 4000000;
+    const std::size_t producers = argc > 2 ? static_cast<std::size_t>(std::stoul(argv[2])) : 2;
+    const std::size_t consumers = argc > 3 ? static_cast<std::size_t>(std::stoul(argv[3])) : 2;
+
+    std::cout << "=== BoundedCircularQueue layout benchmark ===\n"
+              << "Producers: " << producers << ", Consumers: " << consumers
+              << ", Ops per run: " << ops << "\n\n";
+    std::cout << std::left << std::setw(10) << "Layout"
+              << std::right << std::setw(10) << "Capacity"
+              << std::setw(12) << "Cell (B)"
+              << std::setw(14) << "Memory (MiB)"
+              << std::setw(18) << "Ops/s" << std::endl;
+
+    for (std::size_t capacity : {std::size_t{1024}, std::size_t{200000}}) {
+        Report<PaddedCellLayout>("padded", capacity, producers, consumers, ops);
+        Report<PackedCellLayout>("packed", capacity, producers, consumers, ops);
+        Report<StripedCellLayout>("striped", capacity, producers, consumers, ops);
+    }
+    return 0;
+}
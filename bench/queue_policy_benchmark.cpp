@@ -0,0 +1,157 @@
+/*
+Queue-full policies under overload: submitter latency and what happens to the excess
+
+Several submitter threads Post tasks of cpu_us calibrated CPU work as fast as they can into
+a 2-worker pool with a small queue, so the queue is full most of the time. The same run is
+repeated for each QueueFullPolicy (BlockFor with block_ms). Reported per policy:
+  p50/p99/max   time one Post call takes on the submitting thread (us)
+  run/s         tasks executed per second, on workers or inline, over the whole run
+  inline        tasks run by their submitter (CallerRuns)
+  dropped       tasks discarded, timed out or overwritten
+
+Usage: queue_policy_benchmark [tasks_per_submitter] [submitters] [cpu_us] [queue_cap] [block_ms]
+*/
+
+#include "thread_pool/thread_pool.hpp"
+#include "logger.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using thread_pool::QueueFullPolicy;
+
+std::size_t g_iters_per_us = 1;
+
+void Burn(std::size_t iterations) {
+    volatile std::size_t sink = 0;
+    for (std::size_t i = 0; i < iterations; ++i) {
+        sink = sink + i;
+    }
+}
+
+// Fastest of several probes, so a preempted probe does not shrink the work per task
+void Calibrate() {
+    constexpr std::size_t kProbe = 10'000'000;
+    double best_us = 1e300;
+    for (int i = 0; i < 7; ++i) {
+        const auto start = Clock::now();
+        Burn(kProbe);
+        best_us = std::min(best_us, std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+    }
+    g_iters_per_us = std::max<std::size_t>(1, static_cast<std::size_t>(kProbe / best_us));
+}
+
+double PercentileUs(std::vector<std::int64_t>& ns, double p) {
+    if (ns.empty()) {
+        return 0.0;
+    }
+    const auto idx = std::min(ns.size() - 1, static_cast<std::size_t>(p * static_cast<double>(ns.size())));
+    std::nth_element(ns.begin(), ns.begin() + static_cast<std::ptrdiff_t>(idx), ns.end());
+    return static_cast<double>(ns[idx]) / 1e3;
+}
+
+struct Result {
+    double      p50_us{0.0};
+    double      p99_us{0.0};
+    double      max_us{0.0};
+    double      run_per_s{0.0};
+    std::size_t inline_runs{0};
+    std::size_t dropped{0};
+};
+
+Result Run(QueueFullPolicy policy, std::size_t per_submitter, std::size_t submitters,
+           std::chrono::microseconds cpu, std::size_t queue_cap, std::chrono::milliseconds block) {
+    thread_pool::ThreadPoolConfig cfg;
+    cfg.core_threads = 2;
+    cfg.max_threads = 2;
+    cfg.queue_cap = queue_cap;
+    cfg.queue_policy = policy;
+    cfg.queue_block_timeout = block;
+    thread_pool::ThreadPool pool(cfg);
+    pool.Start();
+
+    std::atomic<std::size_t> ran{0};
+    const auto iters = g_iters_per_us * static_cast<std::size_t>(cpu.count());
+    std::vector<std::vector<std::int64_t>> latencies(submitters);
+    std::vector<std::thread> threads;
+    const auto start = Clock::now();
+    for (std::size_t s = 0; s < submitters; ++s) {
+        threads.emplace_back([&, s] {
+            auto& lat = latencies[s];
+            lat.reserve(per_submitter);
+            for (std::size_t i = 0; i < per_submitter; ++i) {
+                const auto t0 = Clock::now();
+                pool.Post([&ran, iters] {
+                    Burn(iters);
+                    ran.fetch_add(1, std::memory_order_relaxed);
+                });
+                lat.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count());
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    pool.Stop(thread_pool::StopMode::Graceful);  // drains what was queued
+    const double wall_s = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::vector<std::int64_t> all;
+    for (auto& lat : latencies) {
+        all.insert(all.end(), lat.begin(), lat.end());
+    }
+    const auto stats = pool.GetStatistics();
+    Result r;
+    r.max_us = all.empty() ? 0.0 : static_cast<double>(*std::max_element(all.begin(), all.end())) / 1e3;
+    r.p99_us = PercentileUs(all, 0.99);
+    r.p50_us = PercentileUs(all, 0.50);
+    r.run_per_s = static_cast<double>(ran.load()) / wall_s;
+    r.inline_runs = stats.statistic_caller_runs;
+    r.dropped = stats.statistic_discard_cnt + stats.statistic_overwrite_cnt;
+    return r;
+}
+
+}
+
+int main(int argc, char** argv) {
+    thread_pool::log::SetLevel("error");  // Discard/BlockFor warn on every dropped Submit
+    const std::size_t per_submitter = argc > 1 ? static_cast<std::size_t>(std::stoul(argv[1])) : 20000;
+    const std::size_t submitters = argc > 2 ? std::max<std::size_t>(1, std::stoul(argv[2])) : 4;
+    const auto cpu = std::chrono::microseconds(argc > 3 ? std::stol(argv[3]) : 20);
+    const std::size_t queue_cap = argc > 4 ? static_cast<std::size_t>(std::stoul(argv[4])) : 64;
+    const auto block = std::chrono::milliseconds(argc > 5 ? std::stol(argv[5]) : 1);
+    Calibrate();
+
+    std::cout << "=== Queue-full policies under overload ===\n"
+              << "Submitters: " << submitters << " x " << per_submitter << " tasks of " << cpu.count()
+              << "us CPU, 2 workers, queue_cap " << queue_cap << ", BlockFor " << block.count() << "ms"
+              << ", Hardware threads: " << std::thread::hardware_concurrency() << "\n\n";
+    std::cout << std::left << std::setw(12) << "Policy"
+              << std::right << std::setw(11) << "p50 us" << std::setw(11) << "p99 us" << std::setw(12) << "max us"
+              << std::setw(12) << "run/s" << std::setw(10) << "inline" << std::setw(10) << "dropped" << std::endl;
+
+    const std::pair<QueueFullPolicy, const char*> policies[] = {
+        {QueueFullPolicy::Block, "Block"},         {QueueFullPolicy::Discard, "Discard"},
+        {QueueFullPolicy::Overwrite, "Overwrite"}, {QueueFullPolicy::CallerRuns, "CallerRuns"},
+        {QueueFullPolicy::BlockFor, "BlockFor"}};
+    for (const auto& [policy, name] : policies) {
+        const auto r = Run(policy, per_submitter, submitters, cpu, queue_cap, block);
+        std::cout << std::left << std::setw(12) << name
+                  << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(11) << r.p50_us << std::setw(11) << r.p99_us << std::setw(12) << r.max_us
+                  << std::setprecision(0) << std::setw(12) << r.run_per_s
+                  << std::setw(10) << r.inline_runs << std::setw(10) << r.dropped << std::endl;
+    }
+    return 0;
+}
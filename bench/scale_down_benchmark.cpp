@@ -0,0 +1,114 @@
+/*
+Scale-down after a load spike
+
+Grows a pool from core_threads to max_threads with a burst of blocking tasks, releases
+them, and measures how long the pool takes to shed the surplus workers once it goes idle.
+Balancer knobs are the ThreadPoolConfig defaults (100 ms sampling, 3 debounce hits, 500 ms
+cooldown); only keep_alive varies. Reported per run:
+  peak        workers reached during the spike
+  first (ms)  idle time until the first surplus worker is gone
+  core (ms)   idle time until the pool is back at core_threads
+
+Usage: scale_down_benchmark [core_threads] [max_threads]
+*/
+
+#include "thread_pool/thread_pool.hpp"
+#include "logger.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Result {
+    std::size_t peak{0};
+    double      first_ms{-1.0};
+    double      core_ms{-1.0};
+};
+
+Result RunOnce(std::size_t core, std::size_t max, std::chrono::milliseconds keep_alive) {
+    thread_pool::ThreadPoolConfig cfg;
+    cfg.core_threads = core;
+    cfg.max_threads = max;
+    cfg.queue_cap = 1024;
+    cfg.pending_hi = 1; // Any backlog counts as pressure during the spike
+    cfg.keep_alive = keep_alive;
+
+    thread_pool::ThreadPool pool(cfg);
+    pool.Start();
+
+    // Spike: more blocked tasks than max_threads; kick the balancer past its cooldown
+    std::atomic<bool> release{false};
+    std::atomic<std::size_t> done{0};
+    const std::size_t tasks = max * 2;
+    for (std::size_t i = 0; i < tasks; ++i) {
+        pool.Post([&] {
+            while (!release.load(std::memory_order_acquire)) {
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
+            done.fetch_add(1, std::memory_order_release);
+        });
+    }
+    const auto grow_deadline = Clock::now() + std::chrono::seconds(30);
+    while (pool.CurrentThreads() < max && Clock::now() < grow_deadline) {
+        pool.TriggerLoadCheck();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    Result r;
+    r.peak = pool.CurrentThreads();
+
+    release.store(true, std::memory_order_release);
+    while (done.load(std::memory_order_acquire) < tasks) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // Idle from here on: nothing but the pool itself decides when workers go
+    const auto idle_start = Clock::now();
+    const auto deadline = idle_start + std::chrono::seconds(60);
+    while (Clock::now() < deadline) {
+        const auto current = pool.CurrentThreads();
+        const auto ms = std::chrono::duration<double, std::milli>(Clock::now() - idle_start).count();
+        if (r.first_ms < 0 && current < r.peak) {
+            r.first_ms = ms;
+        }
+        if (current <= core) {
+            r.core_ms = ms;
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    pool.Stop(thread_pool::StopMode::Graceful);
+    return r;
+}
+
+}
+
+int main(int argc, char** argv) {
+    thread_pool::log::SetLevel("warn");
+    const std::size_t core = argc > 1 ? static_cast<std::size_t>(std::stoul(argv[1])) : 2;
+    const std::size_t max = argc > 2 ? static_cast<std::size_t>(std::stoul(argv[2])) : 16;
+
+    std::cout << "=== Scale-down after a spike ===\n"
+              << "core_threads: " << core << ", max_threads: " << max
+              << ", Hardware threads: " << std::thread::hardware_concurrency() << "\n\n";
+    std::cout << std::left << std::setw(18) << "keep_alive (ms)"
+              << std::right << std::setw(8) << "peak" << std::setw(14) << "first (ms)"
+              << std::setw(14) << "core (ms)" << std::endl;
+
+    for (int keep_alive_ms : {250, 1000, 5000}) {
+        const auto r = RunOnce(core, max, std::chrono::milliseconds(keep_alive_ms));
+        std::cout << std::left << std::setw(18) << keep_alive_ms
+                  << std::right << std::setw(8) << r.peak
+                  << std::fixed << std::setprecision(0)
+                  << std::setw(14) << r.first_ms << std::setw(14) << r.core_ms << std::endl;
+    }
+    std::cout << "\n(-1 = not reached within 60 s)\n";
+    return 0;
+}
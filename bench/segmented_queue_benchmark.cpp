@@ -0,0 +1,180 @@
+/*
+Segmented (unbounded) queue vs the bounded ring under steady and bursty load
+
+Queue-only runs: producers push std::uint64_t items, consumers drain with TryConsumeBatch.
+  steady   every producer pushes back to back for the whole run
+  bursty   every producer pushes `burst` items back to back, then sleeps gap_us
+A bounded push that finds the queue full spins until it gets in (the Block policy's cost).
+Then a pool run: one submitter Posts bursts of empty tasks to a 1-worker pool with a
+`cap`-slot queue under Discard, once per queue_backend. Reported:
+  Mops/s      items pushed per second over the whole run
+  full%       bounded pushes that found the queue full at least once (pool: tasks discarded)
+  peak KiB    largest MemoryFootprint seen while running
+  end KiB     MemoryFootprint after everything was drained
+
+Usage: segmented_queue_benchmark [ops_per_producer] [producers] [consumers] [cap] [burst] [gap_us]
+*/
+
+#include "mpmc/bounded_circular_queue.hpp"
+#include "mpmc/segmented_queue.hpp"
+#include "thread_pool/thread_pool.hpp"
+#include "logger.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Result {
+    double      mops{0.0};
+    double      full{0.0};
+    std::size_t peak_bytes{0};
+    std::size_t end_bytes{0};
+};
+
+template <typename Queue>
+Result RunQueue(Queue& queue, std::size_t ops, std::size_t producers, std::size_t consumers,
+                std::size_t burst, std::chrono::microseconds gap) {
+    std::atomic<bool> go{false};
+    std::atomic<std::size_t> running{producers};
+    std::atomic<std::size_t> full{0};
+    std::atomic<std::size_t> peak{queue.MemoryFootprint()};
+    std::vector<std::thread> threads;
+    for (std::size_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            std::size_t local_full = 0;
+            for (std::size_t i = 0; i < ops; ++i) {
+                auto v = static_cast<std::uint64_t>(p * ops + i);
+                if (!queue.TryPush(v)) {
+                    ++local_full;
+                    while (!queue.TryPush(v)) {
+                        std::this_thread::yield();
+                    }
+                }
+                if (burst != 0 && (i + 1) % burst == 0) {
+                    std::this_thread::sleep_for(gap);
+                }
+            }
+            full.fetch_add(local_full, std::memory_order_relaxed);
+            running.fetch_sub(1, std::memory_order_release);
+        });
+    }
+    for (std::size_t c = 0; c < consumers; ++c) {
+        threads.emplace_back([&, c] {
+            std::uint64_t sink = 0;
+            for (;;) {
+                const bool done = running.load(std::memory_order_acquire) == 0;
+                const auto n = queue.TryConsumeBatch([&](std::uint64_t&& v) { sink += v; }, 32);
+                if (c == 0) {
+                    const auto bytes = queue.MemoryFootprint();
+                    if (bytes > peak.load(std::memory_order_relaxed)) {
+                        peak.store(bytes, std::memory_order_relaxed);
+                    }
+                }
+                if (n == 0) {
+                    if (done) {
+                        break;
+                    }
+                    std::this_thread::yield();
+                }
+            }
+            static_cast<void>(sink);
+        });
+    }
+    const auto start = Clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& t : threads) {
+        t.join();
+    }
+    const double secs = std::chrono::duration<double>(Clock::now() - start).count();
+    const double total = static_cast<double>(ops * producers);
+    return {total / secs / 1e6, static_cast<double>(full.load()) / total,
+            peak.load(), queue.MemoryFootprint()};
+}
+
+Result RunPool(thread_pool::QueueBackend backend, std::size_t ops, std::size_t cap, std::size_t burst,
+               std::chrono::microseconds gap) {
+    thread_pool::ThreadPoolConfig cfg;
+    cfg.core_threads = 1;
+    cfg.max_threads = 1;
+    cfg.queue_cap = cap;
+    cfg.queue_policy = thread_pool::QueueFullPolicy::Discard;
+    cfg.queue_backend = backend;
+    thread_pool::ThreadPool pool(cfg);
+    pool.Start();
+
+    std::size_t peak = pool.GetStatistics().statistic_queue_bytes;
+    const auto start = Clock::now();
+    for (std::size_t i = 0; i < ops; ++i) {
+        pool.Post([] {});
+        if ((i + 1) % burst == 0) {
+            peak = std::max(peak, pool.GetStatistics().statistic_queue_bytes);
+            std::this_thread::sleep_for(gap);
+        }
+    }
+    while (pool.Pending() != 0) {
+        std::this_thread::yield();
+    }
+    const double secs = std::chrono::duration<double>(Clock::now() - start).count();
+    const auto stats = pool.GetStatistics();
+    pool.Stop(thread_pool::StopMode::Graceful);
+    return {static_cast<double>(ops) / secs / 1e6,
+            static_cast<double>(stats.statistic_discard_cnt) / static_cast<double>(ops),
+            peak, stats.statistic_queue_bytes};
+}
+
+}
+
+int main(int argc, char** argv) {
+    thread_pool::log::SetLevel("error");
+    const std::size_t ops = argc > 1 ? static_cast<std::size_t>(std::stoul(argv[1])) : 500000;
+    const std::size_t producers = argc > 2 ? std::max<std::size_t>(1, std::stoul(argv[2])) : 4;
+    const std::size_t consumers = argc > 3 ? std::max<std::size_t>(1, std::stoul(argv[3])) : 2;
+    const std::size_t cap = argc > 4 ? static_cast<std::size_t>(std::stoul(argv[4])) : 1024;
+    const std::size_t burst = argc > 5 ? std::max<std::size_t>(1, std::stoul(argv[5])) : 8192;
+    const auto gap = std::chrono::microseconds(argc > 6 ? std::stol(argv[6]) : 2000);
+
+    std::cout << "=== Segmented vs bounded queue ===\n"
+              << "Producers: " << producers << " x " << ops << ", consumers " << consumers
+              << ", bounded capacity " << cap << ", bursts of " << burst << " every " << gap.count()
+              << "us, Hardware threads: " << std::thread::hardware_concurrency() << "\n\n";
+    std::cout << std::left << std::setw(8) << "Load" << std::setw(11) << "Queue"
+              << std::right << std::setw(10) << "Mops/s" << std::setw(8) << "full%"
+              << std::setw(11) << "peak KiB" << std::setw(10) << "end KiB" << std::endl;
+
+    auto print = [](const char* load, const char* queue, const Result& r) {
+        std::cout << std::left << std::setw(8) << load << std::setw(11) << queue
+                  << std::right << std::fixed << std::setprecision(2) << std::setw(10) << r.mops
+                  << std::setprecision(1) << std::setw(8) << r.full * 100
+                  << std::setw(11) << static_cast<double>(r.peak_bytes) / 1024
+                  << std::setw(10) << static_cast<double>(r.end_bytes) / 1024 << std::endl;
+    };
+    for (const std::size_t b : {std::size_t{0}, burst}) {
+        const char* load = b == 0 ? "steady" : "bursty";
+        {
+            BoundedCircularQueue<std::uint64_t> queue(cap);
+            print(load, "bounded", RunQueue(queue, ops, producers, consumers, b, gap));
+        }
+        {
+            SegmentedQueue<std::uint64_t> queue;
+            print(load, "segmented", RunQueue(queue, ops, producers, consumers, b, gap));
+        }
+    }
+    const std::size_t pool_ops = ops * producers / 4;
+    print("pool", "bounded", RunPool(thread_pool::QueueBackend::Bounded, pool_ops, cap, burst, gap));
+    print("pool", "segmented", RunPool(thread_pool::QueueBackend::Segmented, pool_ops, cap, burst, gap));
+    return 0;
+}
@@ -0,0 +1,98 @@
+/*
+Sharded Normal lane vs the single shared ring under many submitters
+
+`submitters` threads Post empty tasks to a pool of `workers` threads as fast as they can,
+once with one ring (queue_shards = 1) and then with each shard count under both routings:
+  Home       a submitter always pushes to its thread-local home shard (spilling if it is full)
+  TwoChoice  a submitter pushes to the shorter of two randomly picked shards
+Workers drain their own home shard first, then probe the others. Reported:
+  M tasks/s   tasks Posted and run per second over the whole run
+  speedup     against queue_shards = 1
+
+Usage: sharded_queue_benchmark [tasks_per_submitter] [submitters] [workers] [cap]
+*/
+
+#include "thread_pool/thread_pool.hpp"
+#include "logger.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double RunPool(std::size_t tasks, std::size_t submitters, std::size_t workers, std::size_t cap,
+               std::size_t shards, thread_pool::QueueRouting routing) {
+    thread_pool::ThreadPoolConfig cfg;
+    cfg.core_threads = workers;
+    cfg.max_threads = workers;
+    cfg.queue_cap = cap;
+    cfg.queue_shards = shards;
+    cfg.queue_routing = routing;
+    thread_pool::ThreadPool pool(cfg);
+    pool.Start();
+
+    const std::size_t total = tasks * submitters;
+    std::atomic<bool> go{false};
+    std::atomic<std::size_t> ran{0};
+    std::vector<std::thread> threads;
+    for (std::size_t s = 0; s < submitters; ++s) {
+        threads.emplace_back([&] {
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            for (std::size_t i = 0; i < tasks; ++i) {
+                pool.Post([&ran] { ran.fetch_add(1, std::memory_order_relaxed); });
+            }
+        });
+    }
+    const auto start = Clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& t : threads) {
+        t.join();
+    }
+    while (ran.load(std::memory_order_relaxed) < total) {
+        std::this_thread::yield();
+    }
+    const double secs = std::chrono::duration<double>(Clock::now() - start).count();
+    pool.Stop(thread_pool::StopMode::Graceful);
+    return static_cast<double>(total) / secs / 1e6;
+}
+
+}
+
+int main(int argc, char** argv) {
+    thread_pool::log::SetLevel("error");
+    const std::size_t tasks = argc > 1 ? static_cast<std::size_t>(std::stoul(argv[1])) : 200000;
+    const std::size_t submitters = argc > 2 ? std::max<std::size_t>(1, std::stoul(argv[2])) : 8;
+    const std::size_t workers = argc > 3 ? std::max<std::size_t>(1, std::stoul(argv[3])) : 16;
+    const std::size_t cap = argc > 4 ? static_cast<std::size_t>(std::stoul(argv[4])) : 4096;
+
+    std::cout << "=== Sharded Normal lane ===\n"
+              << "Submitters: " << submitters << " x " << tasks << ", workers " << workers << ", capacity " << cap
+              << ", Hardware threads: " << std::thread::hardware_concurrency() << "\n\n";
+    std::cout << std::left << std::setw(8) << "Shards" << std::setw(11) << "Routing"
+              << std::right << std::setw(12) << "M tasks/s" << std::setw(10) << "speedup" << std::endl;
+
+    auto print = [](std::size_t shards, const char* routing, double mtps, double base) {
+        std::cout << std::left << std::setw(8) << shards << std::setw(11) << routing
+                  << std::right << std::fixed << std::setprecision(3) << std::setw(12) << mtps
+                  << std::setprecision(2) << std::setw(9) << mtps / base << "x" << std::endl;
+    };
+    const double base = RunPool(tasks, submitters, workers, cap, 1, thread_pool::QueueRouting::Home);
+    print(1, "-", base, base);
+    for (const std::size_t shards : {std::size_t{4}, std::size_t{8}}) {
+        print(shards, "Home", RunPool(tasks, submitters, workers, cap, shards, thread_pool::QueueRouting::Home), base);
+        print(shards, "TwoChoice",
+              RunPool(tasks, submitters, workers, cap, shards, thread_pool::QueueRouting::TwoChoice), base);
+    }
+    return 0;
+}
@@ -0,0 +1,109 @@
+/*
+Buffered submission: ThreadPool::SubmitBuffer batch size vs plain Post
+
+`submitters` threads Post empty tasks to a pool of `workers` threads, first with plain Post
+(one ticket claim and one pending-count update per task), then each through its own
+SubmitBuffer of 1, 8, 32, 128 and 512 tasks, which hands a full buffer to the queue with a
+single range claim. Reported:
+  M tasks/s   tasks Posted and run per second over the whole run
+  speedup     against plain Post
+  flushes     batches the buffers handed to the queue
+
+Usage: submit_buffer_benchmark [tasks_per_submitter] [submitters] [workers] [cap]
+*/
+
+#include "thread_pool/thread_pool.hpp"
+#include "logger.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Result {
+    double      mtps{0.0};
+    std::size_t flushes{0};
+};
+
+// buffer == 0: plain Post
+Result RunPool(std::size_t tasks, std::size_t submitters, std::size_t workers, std::size_t cap, std::size_t buffer) {
+    thread_pool::ThreadPoolConfig cfg;
+    cfg.core_threads = workers;
+    cfg.max_threads = workers;
+    cfg.queue_cap = cap;
+    thread_pool::ThreadPool pool(cfg);
+    pool.Start();
+
+    const std::size_t total = tasks * submitters;
+    std::atomic<bool> go{false};
+    std::atomic<std::size_t> ran{0};
+    std::vector<std::thread> threads;
+    for (std::size_t s = 0; s < submitters; ++s) {
+        threads.emplace_back([&] {
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            if (buffer == 0) {
+                for (std::size_t i = 0; i < tasks; ++i) {
+                    pool.Post([&ran] { ran.fetch_add(1, std::memory_order_relaxed); });
+                }
+                return;
+            }
+            thread_pool::ThreadPool::SubmitBuffer sb(pool, buffer);
+            for (std::size_t i = 0; i < tasks; ++i) {
+                sb.Post([&ran] { ran.fetch_add(1, std::memory_order_relaxed); });
+            }
+        });
+    }
+    const auto start = Clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& t : threads) {
+        t.join();
+    }
+    while (ran.load(std::memory_order_relaxed) < total) {
+        std::this_thread::yield();
+    }
+    const double secs = std::chrono::duration<double>(Clock::now() - start).count();
+    const auto flushes = pool.GetStatistics().statistic_buffer_flushes;
+    pool.Stop(thread_pool::StopMode::Graceful);
+    return {static_cast<double>(total) / secs / 1e6, flushes};
+}
+
+}
+
+int main(int argc, char** argv) {
+    thread_pool::log::SetLevel("error");
+    const std::size_t tasks = argc > 1 ? static_cast<std::size_t>(std::stoul(argv[1])) : 250000;
+    const std::size_t submitters = argc > 2 ? std::max<std::size_t>(1, std::stoul(argv[2])) : 4;
+    const std::size_t workers = argc > 3 ? std::max<std::size_t>(1, std::stoul(argv[3])) : 4;
+    const std::size_t cap = argc > 4 ? static_cast<std::size_t>(std::stoul(argv[4])) : 4096;
+
+    std::cout << "=== SubmitBuffer vs Post ===\n"
+              << "Submitters: " << submitters << " x " << tasks << ", workers " << workers << ", capacity " << cap
+              << ", Hardware threads: " << std::thread::hardware_concurrency() << "\n\n";
+    std::cout << std::left << std::setw(10) << "Buffer"
+              << std::right << std::setw(12) << "M tasks/s" << std::setw(10) << "speedup"
+              << std::setw(10) << "flushes" << std::endl;
+
+    auto print = [](const std::string& buffer, const Result& r, double base) {
+        std::cout << std::left << std::setw(10) << buffer
+                  << std::right << std::fixed << std::setprecision(3) << std::setw(12) << r.mtps
+                  << std::setprecision(2) << std::setw(9) << r.mtps / base << "x"
+                  << std::setw(10) << r.flushes << std::endl;
+    };
+    const auto base = RunPool(tasks, submitters, workers, cap, 0);
+    print("Post", base, base.mtps);
+    for (const std::size_t size : {1, 8, 32, 128, 512}) {
+        print(std::to_string(size), RunPool(tasks, submitters, workers, cap, size), base.mtps);
+    }
+    return 0;
+}
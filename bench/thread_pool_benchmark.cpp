@@ -5,9 +5,16 @@
 #include "logger.hpp"
 
 #include <thread>
+#include <mutex>
 #include <iostream>
 #include <iomanip>
 #include <fstream>
+#include <cstdlib>
+#include <new>
+
+#if !defined(_WIN32)
+    #include <sys/resource.h>
+#endif
 
 // MSVC compatibility: define memory barrier macro
 #if defined(_MSC_VER)
@@ -19,6 +26,34 @@
 
 using namespace std::chrono_literals;
 
+// Global heap allocation counter, used to report allocations per task
+static std::atomic<std::size_t> g_alloc_count{0};
+
+void* operator new(std::size_t size) {
+    g_alloc_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+// Voluntary + involuntary context switches of the whole process so far (0 where unsupported)
+static std::size_t context_switches() {
+#if !defined(_WIN32)
+    rusage ru{};
+    if (getrusage(RUSAGE_SELF, &ru) == 0) {
+        return static_cast<std::size_t>(ru.ru_nvcsw + ru.ru_nivcsw);
+    }
+#endif
+    return 0;
+}
+
 namespace bench_tp {
 
 static thread_pool::QueueFullPolicy parse_policy(const std::string& s) {
@@ -28,6 +63,75 @@ static thread_pool::QueueFullPolicy parse_policy(const std::string& s) {
     return thread_pool::QueueFullPolicy::Block;
 }
 
+static thread_pool::SchedulingMode parse_scheduling(const std::string& s) {
+    if (s == "WORK_STEALING" || s == "WorkStealing") return thread_pool::SchedulingMode::WorkStealing;
+    return thread_pool::SchedulingMode::Shared;
+}
+
+static thread_pool::IdleStrategy parse_idle_strategy(const std::string& s) {
+    if (s == "SPIN_THEN_PARK" || s == "SpinThenPark") return thread_pool::IdleStrategy::SpinThenPark;
+    return thread_pool::IdleStrategy::Park;
+}
+
+static thread_pool::TaskPriority parse_priority(const std::string& s) {
+    if (s == "HIGH" || s == "High") return thread_pool::TaskPriority::High;
+    if (s == "LOW" || s == "Low") return thread_pool::TaskPriority::Low;
+    return thread_pool::TaskPriority::Normal;
+}
+
+// Synthetic task body: optional CPU busy work followed by optional sleep
+static void run_synthetic_load(std::size_t w, std::size_t s, std::atomic<std::uint64_t>& global_sink) {
+    // CPU busy work - prevent optimization
+    if (w > 0) {
+        auto t0 = std::chrono::high_resolution_clock::now();
+        std::uint64_t local_sink = 0;
+        while (std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - t0).count() < static_cast<long long>(w)) {
+            local_sink += 1;
+        }
+        // Observable side effect: write to a global atomic
+        global_sink.fetch_add(local_sink, std::memory_order_relaxed);
+        // Memory barrier to prevent reordering
+        COMPILER_BARRIER();
+    }
+    // Simulate IO wait
+    if (s > 0) {
+        std::this_thread::sleep_for(std::chrono::microseconds(s));
+    }
+}
+
+// Post one unit of work; with fanout > 0 the task posts that many children from inside the worker
+static void post_workload(thread_pool::ThreadPool& pool,
+                          std::atomic<std::size_t>& counter,
+                          std::atomic<std::uint64_t>& global_sink,
+                          std::size_t w, std::size_t s, std::size_t fanout, bool use_submit = false,
+                          thread_pool::TaskPriority priority = thread_pool::TaskPriority::Normal) {
+    if (use_submit) {
+        // Future is dropped immediately; measures the cost of the result-bearing path
+        (void)pool.Submit(priority, [&counter, &global_sink, w, s]{
+            run_synthetic_load(w, s, global_sink);
+            counter.fetch_add(1, std::memory_order_relaxed);
+        });
+        return;
+    }
+    if (fanout == 0) {
+        pool.Post(priority, [&counter, &global_sink, w, s]{
+            run_synthetic_load(w, s, global_sink);
+            counter.fetch_add(1, std::memory_order_relaxed);
+        });
+        return;
+    }
+    pool.Post(priority, [&pool, &counter, &global_sink, w, s, fanout]{
+        for (std::size_t i = 0; i < fanout; ++i) {
+            pool.Post([&counter, &global_sink, w, s]{
+                run_synthetic_load(w, s, global_sink);
+                counter.fetch_add(1, std::memory_order_relaxed);
+            });
+        }
+        run_synthetic_load(w, s, global_sink);
+        counter.fetch_add(1, std::memory_order_relaxed);
+    });
+}
+
 BenchmarkConfig BenchmarkConfig::LoadFromFile(const std::string& path) {
     BenchmarkConfig cfg;
     try {
@@ -52,6 +156,12 @@ BenchmarkConfig BenchmarkConfig::LoadFromFile(const std::string& path) {
             if (p.contains("pending_low")) cfg.pending_low = p["pending_low"].get<std::size_t>();
             if (p.contains("debounce_hits")) cfg.debounce_hits = p["debounce_hits"].get<std::size_t>();
             if (p.contains("cooldown_ms")) cfg.cooldown_ms = p["cooldown_ms"].get<std::size_t>();
+            if (p.contains("scheduling_mode")) cfg.scheduling_mode = p["scheduling_mode"].get<std::string>();
+            if (p.contains("local_queue_cap")) cfg.local_queue_cap = p["local_queue_cap"].get<std::size_t>();
+            if (p.contains("idle_strategy")) cfg.idle_strategy = p["idle_strategy"].get<std::string>();
+            if (p.contains("max_spinning_workers")) cfg.max_spinning_workers = p["max_spinning_workers"].get<std::size_t>();
+            if (p.contains("priority_lane_cap")) cfg.priority_lane_cap = p["priority_lane_cap"].get<std::size_t>();
+            if (p.contains("priority_aging")) cfg.priority_aging = p["priority_aging"].get<std::size_t>();
         }
         if (j.contains("benchmark")) {
             auto& b = j["benchmark"];
@@ -66,6 +176,11 @@ BenchmarkConfig BenchmarkConfig::LoadFromFile(const std::string& path) {
             if (b.contains("task_work_us")) cfg.task_work_us = b["task_work_us"].get<std::size_t>();
             if (b.contains("task_sleep_us")) cfg.task_sleep_us = b["task_sleep_us"].get<std::size_t>();
             if (b.contains("submit_threads")) cfg.submit_threads = b["submit_threads"].get<std::size_t>();
+            if (b.contains("fanout")) cfg.fanout = b["fanout"].get<std::size_t>();
+            if (b.contains("use_submit")) cfg.use_submit = b["use_submit"].get<bool>();
+            if (b.contains("task_priority")) cfg.task_priority = b["task_priority"].get<std::string>();
+            if (b.contains("probe_interval_us")) cfg.probe_interval_us = b["probe_interval_us"].get<std::size_t>();
+            if (b.contains("probe_priority")) cfg.probe_priority = b["probe_priority"].get<std::string>();
         }
     } catch (const std::exception& e) {
         std::cerr << "Warning: failed to parse benchmark config: " << e.what() << ", using defaults" << std::endl;
@@ -90,6 +205,12 @@ thread_pool::ThreadPoolConfig ThreadPoolBenchmark::ToPoolConfig() const {
     pcfg.debounce_hits = cfg_.debounce_hits;
     pcfg.cooldown = std::chrono::milliseconds(cfg_.cooldown_ms);
     pcfg.queue_policy = parse_policy(cfg_.queue_full_policy);
+    pcfg.scheduling = parse_scheduling(cfg_.scheduling_mode);
+    pcfg.local_queue_cap = cfg_.local_queue_cap;
+    pcfg.idle_strategy = parse_idle_strategy(cfg_.idle_strategy);
+    pcfg.max_spinning_workers = cfg_.max_spinning_workers;
+    pcfg.priority_lane_cap = cfg_.priority_lane_cap;
+    pcfg.priority_aging = cfg_.priority_aging;
     return pcfg;
 }
 
@@ -98,7 +219,22 @@ BenchmarkResult ThreadPoolBenchmark::RunBenchmark() {
         std::cout << "=== Thread pool throughput benchmark start ===\n"
                   << "Core threads: " << cfg_.core_threads
                   << ", Max threads: " << cfg_.max_threads
-                  << ", Queue size: " << cfg_.max_queue_size << std::endl;
+                  << ", Queue size: " << cfg_.max_queue_size
+                  << ", Scheduling: " << cfg_.scheduling_mode
+                  << ", Idle: " << cfg_.idle_strategy << std::endl;
+        if (cfg_.fanout > 0) {
+            std::cout << "Nested fanout: " << cfg_.fanout << " child tasks per submitted task" << std::endl;
+        }
+        if (cfg_.use_submit) {
+            std::cout << "Submission path: Submit (Future per task)" << std::endl;
+        }
+        if (cfg_.task_priority != "Normal" || cfg_.probe_interval_us > 0) {
+            std::cout << "Task priority: " << cfg_.task_priority;
+            if (cfg_.probe_interval_us > 0) {
+                std::cout << ", probes: " << cfg_.probe_priority << " every " << cfg_.probe_interval_us << " us";
+            }
+            std::cout << std::endl;
+        }
         if (cfg_.use_duration_mode) {
             std::cout << "Test mode: duration-based (" << cfg_.duration_seconds << " s)\n"
                       << "Warmup: " << cfg_.warmup_seconds << " s" << std::endl;
@@ -159,25 +295,7 @@ BenchmarkResult ThreadPoolBenchmark::RunDurationBenchmark() {
     std::atomic<std::size_t> counter{0};
     const auto warmup_end = std::chrono::high_resolution_clock::now() + std::chrono::seconds(cfg_.warmup_seconds);
     while (std::chrono::high_resolution_clock::now() < warmup_end) {
-        pool.Post([&counter, &global_sink, w=cfg_.task_work_us, s=cfg_.task_sleep_us]{
-            // CPU busy work - prevent optimization
-            if (w > 0) {
-                auto t0 = std::chrono::high_resolution_clock::now();
-                std::uint64_t local_sink = 0;
-                while (std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - t0).count() < static_cast<long long>(w)) {
-                    local_sink += 1;
-                }
-                // Observable side effect: write to a global atomic
-                global_sink.fetch_add(local_sink, std::memory_order_relaxed);
-                // Memory barrier to prevent reordering
-                COMPILER_BARRIER();
-            }
-            // Simulate IO wait
-            if (s > 0) {
-                std::this_thread::sleep_for(std::chrono::microseconds(s));
-            }
-            counter.fetch_add(1, std::memory_order_relaxed);
-        });
+        post_workload(pool, counter, global_sink, cfg_.task_work_us, cfg_.task_sleep_us, cfg_.fanout);
     }
 
     // Small wait to let the queue digest
@@ -195,6 +313,8 @@ BenchmarkResult ThreadPoolBenchmark::RunDurationBenchmark() {
     // Actual test
     counter.store(0, std::memory_order_relaxed);
     global_sink.store(0, std::memory_order_relaxed);
+    const auto allocs_before = g_alloc_count.load(std::memory_order_relaxed);
+    const auto csw_before = context_switches();
     auto start = std::chrono::high_resolution_clock::now();
     auto end   = start + std::chrono::seconds(cfg_.duration_seconds);
 
@@ -209,24 +329,7 @@ BenchmarkResult ThreadPoolBenchmark::RunDurationBenchmark() {
 
     // Submit loop: submit tasks as fast as possible within the time window
     while (std::chrono::high_resolution_clock::now() < end) {
-        pool.Post([&counter, &global_sink, w=cfg_.task_work_us, s=cfg_.task_sleep_us]{
-            // CPU busy work - prevent optimization
-            if (w > 0) {
-                auto t0 = std::chrono::high_resolution_clock::now();
-                std::uint64_t local_sink = 0;
-                while (std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - t0).count() < static_cast<long long>(w)) {
-                    local_sink += 1;
-                }
-                // Observable side effect: write to a global atomic
-                global_sink.fetch_add(local_sink, std::memory_order_relaxed);
-                // Memory barrier to prevent reordering
-                COMPILER_BARRIER();
-            }
-            if (s > 0) {
-                std::this_thread::sleep_for(std::chrono::microseconds(s));
-            }
-            counter.fetch_add(1, std::memory_order_relaxed);
-        });
+        post_workload(pool, counter, global_sink, cfg_.task_work_us, cfg_.task_sleep_us, cfg_.fanout);
         submitted.fetch_add(1, std::memory_order_relaxed);
     }
 
@@ -243,6 +346,12 @@ BenchmarkResult ThreadPoolBenchmark::RunDurationBenchmark() {
     }
     
     // Graceful stop - wait for all tasks to finish
+    // (nested children are only accepted while RUNNING, so let them drain first)
+    while (pool.Pending() > 0 || pool.ActiveTasks() > 0) {
+        std::this_thread::sleep_for(1ms);
+    }
+    const auto allocs_after = g_alloc_count.load(std::memory_order_relaxed);
+    const auto csw_after = context_switches();
     pool.Stop(thread_pool::StopMode::Graceful);
     auto stop = std::chrono::high_resolution_clock::now();
 
@@ -263,6 +372,14 @@ BenchmarkResult ThreadPoolBenchmark::RunDurationBenchmark() {
     result.total_submitted = stats.statistic_total_submitted;
     result.avg_exec_time_ns = static_cast<double>(stats.statistic_avg_exec_time.count());
     result.peak_pending_tasks = peak_pending.load(std::memory_order_relaxed);
+    result.stolen_tasks = stats.statistic_steal_cnt;
+    result.spin_hits = stats.statistic_spin_hits;
+    result.park_count = stats.statistic_park_cnt;
+    result.allocs_per_task = result.tasks_completed == 0 ? 0.0
+        : static_cast<double>(allocs_after - allocs_before) / static_cast<double>(result.tasks_completed);
+    result.ctx_switches_per_million = result.tasks_completed == 0 ? 0.0
+        : static_cast<double>(csw_after - csw_before) * 1e6 / static_cast<double>(result.tasks_completed);
+    result.latency = pool.GetLatencyHistograms();
     
     if (cfg_.enable_console_output) {
         auto drain_time = std::chrono::duration<double>(stop - submit_end).count();
@@ -294,6 +411,8 @@ BenchmarkResult ThreadPoolBenchmark::RunTaskCountBenchmark() {
     const size_t tasks_per_thread = cfg_.total_tasks / submit_threads;
     const size_t rem = cfg_.total_tasks % submit_threads;
 
+    const auto allocs_before = g_alloc_count.load(std::memory_order_relaxed);
+    const auto csw_before = context_switches();
     auto start = std::chrono::high_resolution_clock::now();
 
     // Progress and queue peak sampling (separate cache lines to avoid contention with workers)
@@ -335,32 +454,42 @@ BenchmarkResult ThreadPoolBenchmark::RunTaskCountBenchmark() {
         }
     });
 
+    // Latency probes: small timestamped tasks in their own lane, posted while the workload floods the pool
+    std::mutex probe_mu;
+    thread_pool::LatencyHistogram probe_hist;
+    std::atomic<bool> probing{cfg_.probe_interval_us > 0};
+    std::thread prober;
+    if (probing.load(std::memory_order_relaxed)) {
+        prober = std::thread([&pool, &probe_mu, &probe_hist, &probing,
+                              interval = std::chrono::microseconds(cfg_.probe_interval_us),
+                              prio = parse_priority(cfg_.probe_priority)]{
+            while (probing.load(std::memory_order_acquire)) {
+                const auto t0 = std::chrono::steady_clock::now();
+                pool.Post(prio, [t0, &probe_mu, &probe_hist]{
+                    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0);
+                    std::lock_guard<std::mutex> lk(probe_mu);
+                    probe_hist.Record(static_cast<std::uint64_t>(ns.count()));
+                });
+                std::this_thread::sleep_for(interval);
+            }
+        });
+    }
+
     std::vector<std::thread> submitters;
     submitters.reserve(submit_threads);
+    std::atomic<std::uint64_t> submit_ns_total{0};
     for (size_t t = 0; t < submit_threads; ++t) {
         size_t n = tasks_per_thread + (t == submit_threads - 1 ? rem : 0);
-        submitters.emplace_back([n, &pool, &counter, &submitted, &global_sink, w=cfg_.task_work_us, s=cfg_.task_sleep_us]{
+        submitters.emplace_back([n, &pool, &counter, &submitted, &global_sink, &submit_ns_total,
+                                 w=cfg_.task_work_us, s=cfg_.task_sleep_us, f=cfg_.fanout, u=cfg_.use_submit,
+                                 prio=parse_priority(cfg_.task_priority)]{
+            const auto t0 = std::chrono::steady_clock::now();
             for (size_t i = 0; i < n; ++i) {
-                pool.Post([&counter, &global_sink, w, s]{
-                    // CPU busy work - prevent optimization
-                    if (w > 0) {
-                        auto t0 = std::chrono::high_resolution_clock::now();
-                        std::uint64_t local_sink = 0;
-                        while (std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - t0).count() < static_cast<long long>(w)) {
-                            local_sink += 1;
-                        }
-                        // Observable side effect: write to a global atomic
-                        global_sink.fetch_add(local_sink, std::memory_order_relaxed);
-                        // Memory barrier to prevent reordering
-                        COMPILER_BARRIER();
-                    }
-                    if (s > 0) {
-                        std::this_thread::sleep_for(std::chrono::microseconds(s));
-                    }
-                    counter.fetch_add(1, std::memory_order_relaxed);
-                });
+                post_workload(pool, counter, global_sink, w, s, f, u, prio);
                 submitted.fetch_add(1, std::memory_order_relaxed);
             }
+            const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0);
+            submit_ns_total.fetch_add(static_cast<std::uint64_t>(ns.count()), std::memory_order_relaxed);
         });
     }
     for (auto& th : submitters) th.join();
@@ -385,6 +514,14 @@ BenchmarkResult ThreadPoolBenchmark::RunTaskCountBenchmark() {
     if (sampler.joinable()) sampler.join();
 
     // Wait for completion -> graceful stop will wait for drain
+    // (nested children are only accepted while RUNNING, so let them drain first)
+    while (pool.Pending() > 0 || pool.ActiveTasks() > 0) {
+        std::this_thread::sleep_for(1ms);
+    }
+    probing.store(false, std::memory_order_release);
+    if (prober.joinable()) prober.join();
+    const auto allocs_after = g_alloc_count.load(std::memory_order_relaxed);
+    const auto csw_after = context_switches();
     pool.Stop(thread_pool::StopMode::Graceful);
     auto end = std::chrono::high_resolution_clock::now();
 
@@ -392,7 +529,8 @@ BenchmarkResult ThreadPoolBenchmark::RunTaskCountBenchmark() {
     auto stats = pool.GetStatistics();
     
     result.tasks_completed = counter.load(std::memory_order_relaxed);
-    result.duration_seconds = std::chrono::duration<double>(submit_end - start).count();
+    // Nested children keep running after the last submit, so fanout runs are timed to full completion
+    result.duration_seconds = std::chrono::duration<double>((cfg_.fanout > 0 ? end : submit_end) - start).count();
     result.throughput_per_second = result.duration_seconds > 0 ? result.tasks_completed / result.duration_seconds : 0.0;
 
     result.peak_threads = stats.statistic_peak_threads;
@@ -405,6 +543,18 @@ BenchmarkResult ThreadPoolBenchmark::RunTaskCountBenchmark() {
     result.total_submitted = stats.statistic_total_submitted;
     result.avg_exec_time_ns = static_cast<double>(stats.statistic_avg_exec_time.count());
     result.peak_pending_tasks = peak_pending.load(std::memory_order_relaxed);
+    result.stolen_tasks = stats.statistic_steal_cnt;
+    result.spin_hits = stats.statistic_spin_hits;
+    result.park_count = stats.statistic_park_cnt;
+    result.allocs_per_task = result.tasks_completed == 0 ? 0.0
+        : static_cast<double>(allocs_after - allocs_before) / static_cast<double>(result.tasks_completed);
+    result.ctx_switches_per_million = result.tasks_completed == 0 ? 0.0
+        : static_cast<double>(csw_after - csw_before) * 1e6 / static_cast<double>(result.tasks_completed);
+    result.latency = pool.GetLatencyHistograms();
+    result.probe_latency = probe_hist;
+    const auto submitted_total = submitted.load(std::memory_order_relaxed);
+    result.avg_submit_ns = submitted_total == 0 ? 0.0
+        : static_cast<double>(submit_ns_total.load(std::memory_order_relaxed)) / static_cast<double>(submitted_total);
     
     if (cfg_.enable_console_output) {
         auto drain_time = std::chrono::duration<double>(end - submit_end).count();
@@ -433,6 +583,43 @@ void ThreadPoolBenchmark::PrintResult(const BenchmarkResult& result) const {
     std::cout << "Avg task time: " << std::fixed << std::setprecision(2)
           << result.avg_exec_time_ns << " ns" << std::endl;
     }
+    std::cout << "Heap allocations per task: " << std::fixed << std::setprecision(2)
+              << result.allocs_per_task << std::endl;
+    std::cout << "Context switches per 1M tasks: " << std::fixed << std::setprecision(0)
+              << result.ctx_switches_per_million << std::endl;
+    if (result.avg_submit_ns > 0) {
+        std::cout << "Avg submit latency: " << std::fixed << std::setprecision(2)
+                  << result.avg_submit_ns << " ns" << std::endl;
+    }
+
+    if (result.probe_latency.Count() > 0) {
+        auto us = [](std::chrono::nanoseconds ns) { return static_cast<double>(ns.count()) / 1000.0; };
+        std::cout << "Probe latency (" << cfg_.probe_priority << ", " << result.probe_latency.Count() << " probes): "
+                  << std::fixed << std::setprecision(2)
+                  << "p50 " << us(result.probe_latency.Percentile(0.50)) << " us, "
+                  << "p99 " << us(result.probe_latency.Percentile(0.99)) << " us, "
+                  << "max " << us(result.probe_latency.Max()) << " us" << std::endl;
+    }
+
+    // Latency percentiles (empty when the pool was built with TP_LATENCY_HISTOGRAMS=0)
+    if (result.latency.execution.Count() > 0) {
+        auto row = [](const char* name, const thread_pool::LatencyHistogram& h) {
+            auto us = [](std::chrono::nanoseconds ns) { return static_cast<double>(ns.count()) / 1000.0; };
+            std::cout << std::left << std::setw(14) << name << std::right << std::fixed << std::setprecision(2)
+                      << std::setw(12) << us(h.Percentile(0.50))
+                      << std::setw(12) << us(h.Percentile(0.90))
+                      << std::setw(12) << us(h.Percentile(0.99))
+                      << std::setw(12) << us(h.Percentile(0.999))
+                      << std::setw(14) << us(h.Max()) << std::endl;
+        };
+        std::cout << "\n=== Task latency (us, " << result.latency.execution.Count() << " samples) ===" << std::endl;
+        std::cout << std::left << std::setw(14) << "" << std::right
+                  << std::setw(12) << "p50" << std::setw(12) << "p90" << std::setw(12) << "p99"
+                  << std::setw(12) << "p99.9" << std::setw(14) << "max" << std::endl;
+        row("Queue wait", result.latency.queue_wait);
+        row("Execution", result.latency.execution);
+        row("End-to-end", result.latency.end_to_end);
+    }
 
     // Queue stats
     const std::size_t cap = cfg_.max_queue_size;
@@ -462,6 +649,12 @@ void ThreadPoolBenchmark::PrintResult(const BenchmarkResult& result) const {
     if (result.overwritten_tasks > 0) {
     std::cout << "Overwritten tasks: " << result.overwritten_tasks << std::endl;
     }
+    if (result.stolen_tasks > 0) {
+        std::cout << "Stolen tasks: " << result.stolen_tasks << std::endl;
+    }
+    if (result.spin_hits > 0) {
+        std::cout << "Idle spin hits: " << result.spin_hits << ", parks: " << result.park_count << std::endl;
+    }
 
     // Queue assessment
     std::cout << "\n=== Queue utilization assessment ===" << std::endl;
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "thread_pool/latency_histogram.hpp"
+
 #include <nlohmann/json.hpp>
 
 #include <atomic>
@@ -30,6 +32,12 @@ struct BenchmarkConfig {
     std::size_t pending_low = 0;  // Optional
     std::size_t debounce_hits = 3;
     std::size_t cooldown_ms = 500;
+    std::string scheduling_mode = "Shared";  // Shared|WorkStealing
+    std::size_t local_queue_cap = 256;
+    std::string idle_strategy = "Park";     // Park|SpinThenPark
+    std::size_t max_spinning_workers = 2;
+    std::size_t priority_lane_cap = 1024;
+    std::size_t priority_aging = 8;
 
     // Benchmark related
     std::size_t total_tasks = 1000000;
@@ -48,6 +56,16 @@ struct BenchmarkConfig {
     std::size_t task_work_us = 0;
     std::size_t task_sleep_us = 0;
     std::size_t submit_threads = 4;
+    // fanout: child tasks each submitted task posts from inside the worker (nested submission)
+    std::size_t fanout = 0;
+    // use_submit: submit through Submit() (result-bearing Future, discarded) instead of Post()
+    bool        use_submit = false;
+    // task_priority: lane for the workload tasks (High|Normal|Low)
+    // probe_interval_us: task-count mode only; > 0 posts a timestamped probe task at probe_priority
+    // every interval until the workload drains and reports the probes' submit-to-run latency
+    std::string task_priority = "Normal";
+    std::size_t probe_interval_us = 0;
+    std::string probe_priority = "High";
 
     static BenchmarkConfig LoadFromFile(const std::string& path);
 };
@@ -71,6 +89,14 @@ struct BenchmarkResult {
     std::size_t total_submitted = 0;             // Number of tasks successfully submitted
     double      avg_exec_time_ns = 0.0;          // Average task execution time (nanoseconds)
     std::size_t peak_pending_tasks = 0;          // Observed peak queue size
+    std::size_t stolen_tasks = 0;                // Tasks taken from another worker's deque
+    std::size_t spin_hits = 0;                   // Tasks found by a spinning idle worker
+    std::size_t park_count = 0;                  // Blocking waits by idle workers
+    double      allocs_per_task = 0.0;           // Heap allocations during the run / tasks completed
+    double      avg_submit_ns = 0.0;             // Mean wall time of one submit call per submitter thread (task-count mode)
+    double      ctx_switches_per_million = 0.0;  // Process context switches during the run per 1M tasks (POSIX only)
+    thread_pool::LatencyHistograms latency;      // Queue wait / execution / end-to-end distributions
+    thread_pool::LatencyHistogram  probe_latency;  // Probe submit-to-run latency (probe_interval_us > 0)
 };
 
 class ThreadPoolBenchmark {
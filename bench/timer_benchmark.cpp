@@ -0,0 +1,192 @@
+/*
+Delayed/periodic task microbenchmark
+
+1. Bookkeeping: schedules N timers spread over the next minute, then cancels them all.
+   Reports schedule and cancel rates and resident memory per outstanding timer.
+2. Firing: N timers all due within ~100 ms; reports how fast they reach the workers.
+3. Accuracy: timers with 1-200 ms delays record how late they ran (never early by design);
+   reports lateness p50/p99/max per timer_tick.
+
+Usage: timer_benchmark [timers] [accuracy_samples]
+*/
+
+#include "thread_pool/thread_pool.hpp"
+#include "logger.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+    #include <unistd.h>
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+thread_pool::ThreadPoolConfig PoolConfig(std::chrono::microseconds tick) {
+    thread_pool::ThreadPoolConfig cfg;
+    cfg.core_threads = 2;
+    cfg.max_threads = 2;
+    cfg.queue_cap = 65536;
+    cfg.pending_hi = cfg.queue_cap; // Fixed worker count: never trip the balancer
+    cfg.pending_low = 0;
+    cfg.scale_up_threshold = 2.0;
+    cfg.scale_down_threshold = -1.0;
+    cfg.timer_tick = tick;
+    return cfg;
+}
+
+// Resident set size in bytes (0 where unsupported)
+std::size_t ResidentBytes() {
+#if defined(__linux__)
+    std::ifstream statm("/proc/self/statm");
+    std::size_t pages = 0;
+    std::size_t resident = 0;
+    statm >> pages >> resident;
+    return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#else
+    return 0;
+#endif
+}
+
+double Seconds(Clock::duration d) {
+    return std::chrono::duration<double>(d).count();
+}
+
+void RunBookkeeping(std::size_t timers) {
+    thread_pool::ThreadPool pool(PoolConfig(std::chrono::microseconds(1000)));
+    pool.Start();
+    pool.ScheduleAfter(std::chrono::hours(1), [] {}); // start the timer thread outside the measurement
+
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<long long> delay_ms(1000, 60000);
+    std::vector<thread_pool::ThreadPool::TimerId> ids;
+    ids.reserve(timers);
+
+    const auto rss_before = ResidentBytes();
+    auto start = Clock::now();
+    for (std::size_t i = 0; i < timers; ++i) {
+        ids.push_back(pool.ScheduleAfter(std::chrono::milliseconds(delay_ms(rng)), [] {}));
+    }
+    const auto schedule_secs = Seconds(Clock::now() - start);
+    const auto rss_after = ResidentBytes();
+    const auto pending = pool.PendingTimers();
+
+    start = Clock::now();
+    std::size_t cancelled = 0;
+    for (auto id : ids) {
+        cancelled += pool.CancelTimer(id) ? 1 : 0;
+    }
+    const auto cancel_secs = Seconds(Clock::now() - start);
+    pool.Stop(thread_pool::StopMode::Graceful);
+
+    const auto ids_bytes = ids.capacity() * sizeof(ids[0]);
+    std::cout << "Outstanding timers:   " << pending << "\n"
+              << std::fixed << std::setprecision(0)
+              << "Schedule rate:        " << static_cast<double>(timers) / schedule_secs << " timers/s\n"
+              << "Cancel rate:          " << static_cast<double>(cancelled) / cancel_secs << " timers/s ("
+              << cancelled << " cancelled)\n";
+    if (rss_after > rss_before + ids_bytes) {
+        const auto per_timer = static_cast<double>(rss_after - rss_before - ids_bytes) / static_cast<double>(timers);
+        std::cout << "Resident per timer:   " << std::setprecision(1) << per_timer << " bytes\n";
+    }
+    std::cout << "\n";
+}
+
+void RunFiring(std::size_t timers) {
+    thread_pool::ThreadPool pool(PoolConfig(std::chrono::microseconds(1000)));
+    pool.Start();
+    std::atomic<std::size_t> ran{0};
+
+    const auto due = Clock::now() + std::chrono::milliseconds(100);
+    for (std::size_t i = 0; i < timers; ++i) {
+        pool.ScheduleAt(due + std::chrono::microseconds(i % 1000), [&ran] { ran.fetch_add(1, std::memory_order_relaxed); });
+    }
+    while (Clock::now() < due) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    const auto start = Clock::now();
+    while (ran.load(std::memory_order_acquire) < timers) {
+        std::this_thread::yield();
+    }
+    const auto secs = Seconds(Clock::now() - start);
+    pool.Stop(thread_pool::StopMode::Graceful);
+    std::cout << "Fired " << timers << " timers due within 1 ms in " << std::fixed << std::setprecision(1)
+              << secs * 1e3 << " ms (" << std::setprecision(0) << static_cast<double>(timers) / secs
+              << " timers/s)\n\n";
+}
+
+thread_pool::LatencyHistogram RunAccuracy(std::chrono::microseconds tick, std::size_t samples) {
+    thread_pool::ThreadPool pool(PoolConfig(tick));
+    pool.Start();
+
+    std::mutex mu;
+    thread_pool::LatencyHistogram lateness;
+    std::atomic<std::size_t> early{0};
+    std::atomic<std::size_t> ran{0};
+    std::mt19937_64 rng(7);
+    std::uniform_int_distribution<long long> delay_us(1000, 200000);
+    for (std::size_t i = 0; i < samples; ++i) {
+        const auto delay = std::chrono::microseconds(delay_us(rng));
+        const auto due = Clock::now() + delay;
+        pool.ScheduleAfter(delay, [&, due] {
+            const auto now = Clock::now();
+            if (now < due) {
+                early.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now - due).count();
+                std::lock_guard<std::mutex> lk(mu);
+                lateness.Record(static_cast<std::uint64_t>(ns));
+            }
+            ran.fetch_add(1, std::memory_order_release);
+        });
+    }
+    while (ran.load(std::memory_order_acquire) < samples) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    pool.Stop(thread_pool::StopMode::Graceful);
+    if (early.load() != 0) {
+        std::cout << "WARNING: " << early.load() << " timers fired early\n";
+    }
+    return lateness;
+}
+
+}
+
+int main(int argc, char** argv) {
+    thread_pool::log::SetLevel("warn");
+    const std::size_t timers = argc > 1 ? static_cast<std::size_t>(std::stoul(argv[1])) : 1000000;
+    const std::size_t samples = argc > 2 ? static_cast<std::size_t>(std::stoul(argv[2])) : 2000;
+
+    std::cout << "=== Timer scheduling benchmark ===\n"
+              << "Timers: " << timers << ", Accuracy samples: " << samples
+              << ", Hardware threads: " << std::thread::hardware_concurrency() << "\n\n";
+
+    RunBookkeeping(timers);
+    RunFiring(timers / 5);
+
+    std::cout << std::left << std::setw(12) << "Tick (us)"
+              << std::right << std::setw(14) << "Late p50 (us)" << std::setw(14) << "Late p99 (us)"
+              << std::setw(14) << "Late max (us)" << std::endl;
+    for (long long tick_us : {1000LL, 100LL}) {
+        const auto h = RunAccuracy(std::chrono::microseconds(tick_us), samples);
+        auto us = [](std::chrono::nanoseconds ns) { return static_cast<double>(ns.count()) / 1e3; };
+        std::cout << std::left << std::setw(12) << tick_us
+                  << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(14) << us(h.Percentile(0.50))
+                  << std::setw(14) << us(h.Percentile(0.99))
+                  << std::setw(14) << us(h.Max()) << std::endl;
+    }
+    return 0;
+}
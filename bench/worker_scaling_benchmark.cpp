@@ -0,0 +1,84 @@
+/*
+Empty-task worker scaling microbenchmark
+
+Runs a fixed number of empty tasks through a ThreadPool with 1..32 workers and reports
+throughput. Empty tasks make per-task scheduling overhead (queue handoff, pause gate,
+bookkeeping) the whole cost, so shared locks on the worker path show up as flat or
+falling throughput as workers are added.
+
+Usage: worker_scaling_benchmark [tasks_per_run] [submit_threads]
+*/
+
+#include "thread_pool/thread_pool.hpp"
+#include "logger.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Returns completed tasks per second
+double RunOnce(std::size_t workers, std::size_t submitters, std::size_t total) {
+    thread_pool::ThreadPoolConfig cfg;
+    cfg.core_threads = workers;
+    cfg.max_threads = workers;
+    cfg.queue_cap = 65536;
+    cfg.pending_hi = cfg.queue_cap; // Fixed worker count: never trip the balancer
+    cfg.pending_low = 0;
+    cfg.scale_up_threshold = 2.0;
+    cfg.scale_down_threshold = -1.0;
+
+    thread_pool::ThreadPool pool(cfg);
+    pool.Start();
+
+    std::atomic<std::size_t> done{0};
+    const std::size_t per_submitter = total / submitters;
+    const std::size_t expected = per_submitter * submitters;
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (std::size_t s = 0; s < submitters; ++s) {
+        threads.emplace_back([&] {
+            for (std::size_t i = 0; i < per_submitter; ++i) {
+                pool.Post([&done] { done.fetch_add(1, std::memory_order_relaxed); });
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    while (done.load(std::memory_order_acquire) < expected) {
+        std::this_thread::yield();
+    }
+    const auto secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    pool.Stop(thread_pool::StopMode::Graceful);
+    return secs > 0 ? static_cast<double>(expected) / secs : 0.0;
+}
+
+}
+
+int main(int argc, char** argv) {
+    thread_pool::log::SetLevel("warn");
+    const std::size_t tasks = argc > 1 ? static_cast<std::size_t>(std::stoul(argv[1])) : 1000000;
+    const std::size_t submitters = argc > 2 ? static_cast<std::size_t>(std::stoul(argv[2])) : 2;
+
+    std::cout << "=== Empty-task worker scaling benchmark ===\n"
+              << "Tasks per run: " << tasks << ", Submit threads: " << submitters
+              << ", Hardware threads: " << std::thread::hardware_concurrency() << "\n\n";
+    std::cout << std::left << std::setw(10) << "Workers"
+              << std::right << std::setw(18) << "Tasks/s" << std::endl;
+
+    for (std::size_t workers = 1; workers <= 32; workers *= 2) {
+        const double rate = RunOnce(workers, submitters, tasks);
+        std::cout << std::left << std::setw(10) << workers
+                  << std::right << std::fixed << std::setprecision(0) << std::setw(18) << rate
+                  << std::endl;
+    }
+    return 0;
+}
@@ -48,11 +48,12 @@ namespace detail {
 class ScopeTimer {
 public:
     using Clock = std::chrono::steady_clock;
-    using Hook = std::function<void(std::chrono::nanoseconds)>; // callback
+    using Hook = InlineFunction<void(std::chrono::nanoseconds)>; // callback (stored inline, no allocation)
 
-    explicit ScopeTimer(std::string name, Hook hook = {}
+    // name must outlive the timer (string literals in practice)
+    explicit ScopeTimer(std::string_view name, Hook hook = {}
                         , spdlog::level::level_enum level = spdlog::level::debug)
-        : name_(std::move(name)), hook_(std::move(hook)), level_(level), start_(Clock::now()) {}
+        : name_(name), hook_(std::move(hook)), level_(level), start_(Clock::now()) {}
 
     ~ScopeTimer() noexcept {
         const auto span = Clock::now() - start_;
@@ -66,7 +67,7 @@ public:
         }
     }
 private:
-    std::string name_;
+    std::string_view name_;
     Hook hook_;
     spdlog::level::level_enum level_;
     Clock::time_point start_;
@@ -1,23 +1,309 @@
 #pragma once
 
 #include "mpmc/bounded_circular_queue.hpp"
+#include "mpmc/segmented_queue.hpp"
+#include "mpmc/event_count.hpp"
 
-#include <condition_variable>
-#include <mutex>
+#include <atomic>
+#include <cstdint>
 #include <chrono>
-#include <optional>
+#include <memory>
 #include <functional>
 #include <tuple>
 #include <iterator>
+#include <thread>
 #include <type_traits>
+#include <vector>
+#include <algorithm>
+
+// What backs a BlockingQueueAdapter
+// Ring:      the bounded ring
+// Segmented: an unbounded SegmentedQueue (the ring is then a 2-cell stub that is never used)
+// OwnerRing: the ring plus a second, SingleProducer ring of the same size that only the bound
+//            owner thread (BindProducer) pushes to; other threads use the shared ring and
+//            consumers drain both, alternating which one they try first so neither starves.
+//            FIFO holds per ring only
+// Sharded:   `shards` rings splitting the capacity, so producers and consumers spread over
+//            several index pairs instead of meeting on one. FIFO holds per shard only
+enum class QueueStorage { Ring, Segmented, OwnerRing, Sharded };
+
+// Sharded: where a push goes first
+// Home:      the calling thread's home shard (threads get homes round-robin on first use)
+// TwoChoice: the shorter of two random shards
+// Either way a push that finds its first shard full tries the others before reporting full.
+// Consumers always start at their home shard and then probe the rest in order
+enum class ShardRouting { Home, TwoChoice };
+
+// Storage behind a BlockingQueueAdapter. Same surface as BoundedCircularQueue; every call is
+// a few predictable branches away.
+template <typename T, typename Layout, typename Producers, typename Consumers>
+class AdapterStorage {
+public:
+    using Ring = BoundedCircularQueue<T, Layout, Producers, Consumers>;
+    using OwnedRing = BoundedCircularQueue<T, Layout, SingleProducer, Consumers>;
+    using size_type = typename Ring::size_type;
+
+    AdapterStorage(size_type capacity, QueueStorage storage, size_type shards, ShardRouting routing)
+        : ring_(storage == QueueStorage::Ring || storage == QueueStorage::OwnerRing ? capacity : 2)
+        , segmented_(storage == QueueStorage::Segmented ? std::make_unique<SegmentedQueue<T>>() : nullptr)
+        , owned_(storage == QueueStorage::OwnerRing ? std::make_unique<OwnedRing>(capacity) : nullptr)
+        , routing_(routing)
+        , nominal_capacity_(capacity)
+    {
+        if (storage == QueueStorage::Sharded) {
+            shards = std::max<size_type>(1, shards);
+            const size_type per_shard = std::max<size_type>(2, (capacity + shards - 1) / shards);
+            shards_.reserve(shards);
+            for (size_type i = 0; i < shards; ++i) {
+                shards_.push_back(std::make_unique<Ring>(per_shard));
+            }
+        }
+    }
 
-template <typename T>
+    bool TryPush(const T& item) {
+        return Push([&](auto& q) { return q.TryPush(item); });
+    }
+    // A failed ring push leaves item untouched, so a sharded push can move on to the next shard
+    bool TryPush(T&& item) {
+        return Push([&](auto& q) { return q.TryPush(std::move(item)); });
+    }
+    template <typename Producer>
+    bool TryPushWith(Producer&& producer) {
+        return Push([&](auto& q) { return q.TryPushWith(producer); });
+    }
+    template <typename... Args>
+    bool TryEmplace(Args&&... args) {
+        return Push([&](auto& q) { return q.TryPushWith([&](void* p) {
+            ::new (p) T(std::forward<Args>(args)...);
+        }); });
+    }
+    // True if an element was evicted. Sharded: spills into any shard with room first and drops
+    // the oldest element of the first-choice shard only once every shard is full
+    template <typename C>
+    bool OverwritePush(T&& item, C&& on_evict) {
+        if (segmented_) {
+            return segmented_->OverwritePush(std::move(item), std::forward<C>(on_evict));
+        }
+        if (OwnerCalling()) {
+            return owned_->OverwritePush(std::move(item), std::forward<C>(on_evict));
+        }
+        if (!shards_.empty()) {
+            if (Push([&](auto& q) { return q.TryPush(std::move(item)); })) {
+                return false;
+            }
+            return shards_[FirstPushShard()]->OverwritePush(std::move(item), std::forward<C>(on_evict));
+        }
+        return ring_.OverwritePush(std::move(item), std::forward<C>(on_evict));
+    }
+    bool TryPop(T& out) {
+        return Pop([&](auto& q) { return q.TryPop(out); });
+    }
+    template <class C>
+    bool TryPopConsume(C&& out) {
+        return Pop([&](auto& q) { return q.TryPopConsume(out); });
+    }
+    // Sharded: what does not fit in the first-choice shard continues in the next ones
+    template <typename Iterator>
+    size_type TryPushBatch(Iterator begin, Iterator end) {
+        if (segmented_) {
+            return segmented_->TryPushBatch(begin, end);
+        }
+        if (OwnerCalling()) {
+            return owned_->TryPushBatch(begin, end);
+        }
+        if (shards_.empty()) {
+            return ring_.TryPushBatch(begin, end);
+        }
+        const size_type first = FirstPushShard();
+        size_type count = 0;
+        for (size_type i = 0; i < shards_.size() && begin != end; ++i) {
+            const size_type n = shards_[(first + i) % shards_.size()]->TryPushBatch(begin, end);
+            std::advance(begin, n);
+            count += n;
+        }
+        return count;
+    }
+    template <typename OutputIterator>
+    size_type TryPopBatch(OutputIterator out, size_type max_count) {
+        return TryConsumeBatch([&](T&& item) {
+            *out++ = std::move(item);
+        }, max_count);
+    }
+    template <typename Func>
+    size_type TryConsumeBatch(Func&& func, size_type max_count) {
+        if (segmented_) {
+            return segmented_->TryConsumeBatch(std::forward<Func>(func), max_count);
+        }
+        if (!shards_.empty()) {
+            const size_type home = HomeShard();
+            size_type count = 0;
+            for (size_type i = 0; i < shards_.size() && count < max_count; ++i) {
+                count += shards_[(home + i) % shards_.size()]->TryConsumeBatch(func, max_count - count);
+            }
+            return count;
+        }
+        if (owned_ && OwnedFirst()) {
+            size_type count = owned_->TryConsumeBatch(func, max_count);
+            if (count < max_count) {
+                count += ring_.TryConsumeBatch(func, max_count - count);
+            }
+            return count;
+        }
+        size_type count = ring_.TryConsumeBatch(func, max_count);
+        if (owned_ && count < max_count) {
+            count += owned_->TryConsumeBatch(func, max_count - count);
+        }
+        return count;
+    }
+
+    // OwnerRing: make the calling thread the one that pushes to the owned ring. The previous
+    // owner must have stopped pushing: two threads on a SingleProducer ring corrupt it
+    void BindProducer() noexcept {
+        owner_.store(std::this_thread::get_id(), std::memory_order_release);
+    }
+
+    // Slots in all rings together (both rings under OwnerRing, every shard under Sharded); for
+    // the segmented queue the capacity it was built with, used for ratios only
+    size_type Capacity() const noexcept {
+        if (segmented_) {
+            return nominal_capacity_;
+        }
+        if (!shards_.empty()) {
+            return shards_.size() * shards_.front()->Capacity();
+        }
+        return ring_.Capacity() + (owned_ ? owned_->Capacity() : 0);
+    }
+    size_type MemoryFootprint() const noexcept {
+        if (segmented_) {
+            return segmented_->MemoryFootprint();
+        }
+        size_type bytes = shards_.empty() ? ring_.MemoryFootprint() : 0;
+        for (const auto& shard : shards_) {
+            bytes += shard->MemoryFootprint();
+        }
+        return bytes + (owned_ ? owned_->MemoryFootprint() : 0);
+    }
+    bool Segmented() const noexcept {
+        return segmented_ != nullptr;
+    }
+    bool OwnerRing() const noexcept {
+        return owned_ != nullptr;
+    }
+    size_type Shards() const noexcept {
+        return shards_.empty() ? 1 : shards_.size();
+    }
+
+private:
+    bool OwnerCalling() const noexcept {
+        return owned_ && owner_.load(std::memory_order_relaxed) == std::this_thread::get_id();
+    }
+
+    // Run a push attempt on the storage the calling thread should use
+    template <typename Op>
+    bool Push(Op&& op) {
+        if (segmented_) {
+            return op(*segmented_);
+        }
+        if (OwnerCalling()) {
+            return op(*owned_);
+        }
+        if (shards_.empty()) {
+            return op(ring_);
+        }
+        const size_type first = FirstPushShard();
+        for (size_type i = 0; i < shards_.size(); ++i) {
+            if (op(*shards_[(first + i) % shards_.size()])) {
+                return true;
+            }
+        }
+        return false;
+    }
+    template <typename Op>
+    bool Pop(Op&& op) {
+        if (segmented_) {
+            return op(*segmented_);
+        }
+        if (!shards_.empty()) {
+            const size_type home = HomeShard();
+            for (size_type i = 0; i < shards_.size(); ++i) {
+                if (op(*shards_[(home + i) % shards_.size()])) {
+                    return true;
+                }
+            }
+            return false;
+        }
+        if (owned_ && OwnedFirst()) {
+            return op(*owned_) || op(ring_);
+        }
+        return op(ring_) || (owned_ && op(*owned_));
+    }
+
+    // Per-thread shard assignment, random stream and OwnerRing pop parity, shared by every storage
+    struct ThreadShardState {
+        size_type     slot;
+        std::uint32_t rng;
+        bool          owned_first;
+    };
+    static ThreadShardState& ThisThread() noexcept {
+        static std::atomic<size_type> next_slot{0};
+        thread_local ThreadShardState state = [] {
+            const size_type slot = next_slot.fetch_add(1, std::memory_order_relaxed);
+            return ThreadShardState{slot, static_cast<std::uint32_t>(slot * 0x9E3779B9u) | 1u, false};
+        }();
+        return state;
+    }
+    // OwnerRing: flips on every pop, so each consumer starts at either ring every other time
+    static bool OwnedFirst() noexcept {
+        auto& state = ThisThread();
+        state.owned_first = !state.owned_first;
+        return state.owned_first;
+    }
+    size_type HomeShard() const noexcept {
+        return ThisThread().slot % shards_.size();
+    }
+    size_type FirstPushShard() const noexcept {
+        if (routing_ == ShardRouting::Home || shards_.size() < 2) {
+            return HomeShard();
+        }
+        auto& rng = ThisThread().rng;
+        auto next = [&rng] {
+            rng ^= rng << 13;  // xorshift32
+            rng ^= rng >> 17;
+            rng ^= rng << 5;
+            return static_cast<size_type>(rng);
+        };
+        const size_type a = next() % shards_.size();
+        const size_type b = next() % shards_.size();
+        return shards_[a]->ApproxSize() <= shards_[b]->ApproxSize() ? a : b;
+    }
+
+    Ring                               ring_;
+    std::unique_ptr<SegmentedQueue<T>> segmented_;
+    std::unique_ptr<OwnedRing>         owned_;
+    std::vector<std::unique_ptr<Ring>> shards_;
+    std::atomic<std::thread::id>       owner_{};
+    ShardRouting                       routing_;
+    size_type                          nominal_capacity_;
+};
+
+// Producers/Consumers pick the ring's cardinality (see BoundedCircularQueue); a Single side is
+// a contract of the caller, not checked at run time
+template <typename T, typename Layout = PaddedCellLayout,
+          typename Producers = MultiProducer, typename Consumers = MultiConsumer>
 class BlockingQueueAdapter {
 public:
     using value_type = T;
-    using size_type =  typename BoundedCircularQueue<T>::size_type;
-
-    explicit BlockingQueueAdapter(size_type capacity) : queue_(capacity) {}
+    using size_type =  typename BoundedCircularQueue<T, Layout, Producers, Consumers>::size_type;
+
+    explicit BlockingQueueAdapter(size_type capacity)
+        : not_empty_(own_not_empty_), queue_(capacity, QueueStorage::Ring, 1, ShardRouting::Home) {}
+    // Consumers of several adapters can park once for all of them when the adapters share
+    // `not_empty`: every push signals it, and the consumer retries its own multi-queue poll.
+    // With QueueStorage::Segmented the queue is unbounded: pushes never find it full, and
+    // `capacity` only feeds Capacity(). QueueStorage::Sharded splits `capacity` over `shards`
+    BlockingQueueAdapter(size_type capacity, EventCount& not_empty, QueueStorage storage = QueueStorage::Ring,
+                         size_type shards = 1, ShardRouting routing = ShardRouting::Home)
+        : not_empty_(not_empty), queue_(capacity, storage, shards, routing) {}
 
     // Non-blocking APIs
     bool TryPush(const T& item) {
@@ -26,11 +312,8 @@ public:
         }
         // Lock-free fast path: try enqueue directly
         if (queue_.TryPush(item)) {
-            const auto prev = pending_count_.fetch_add(1, std::memory_order_release);
-            // Notify only when queue transitions from empty to non-empty
-            if (prev == 0) {
-                not_empty_.notify_one();
-            }
+            pending_count_.fetch_add(1, std::memory_order_release);
+            NotifyNotEmpty();
             return true;
         }
         discard_counter_.fetch_add(1, std::memory_order_relaxed);
@@ -45,11 +328,8 @@ public:
             ::new (slot) T(std::move(item));
         };
         if (queue_.TryPushWith(try_push_item)) {
-            const auto prev = pending_count_.fetch_add(1, std::memory_order_release);
-            // Notify only when queue transitions from empty to non-empty
-            if (prev == 0) {
-                not_empty_.notify_one();
-            }
+            pending_count_.fetch_add(1, std::memory_order_release);
+            NotifyNotEmpty();
             return true;
         }
         discard_counter_.fetch_add(1, std::memory_order_relaxed);
@@ -62,11 +342,8 @@ public:
         }
         // Lock-free fast path: try enqueue directly
         if (queue_.TryEmplace(std::forward<Args>(args)...)) {
-            const auto prev = pending_count_.fetch_add(1, std::memory_order_release);
-            // Notify only when queue transitions from empty to non-empty
-            if (prev == 0) {
-                not_empty_.notify_one();
-            }
+            pending_count_.fetch_add(1, std::memory_order_release);
+            NotifyNotEmpty();
             return true;
         }
         discard_counter_.fetch_add(1, std::memory_order_relaxed);
@@ -76,11 +353,8 @@ public:
     bool TryPop(T& out) {
         // Lock-free fast path: try dequeue directly
         if (queue_.TryPop(out)) {
-            const auto prev = pending_count_.fetch_sub(1, std::memory_order_release);
-            // Notify only when queue transitions from full to non-full
-            if (prev == Capacity()) {
-                not_full_.notify_one();
-            }
+            pending_count_.fetch_sub(1, std::memory_order_release);
+            NotifyNotFull();
             return true;
         }
         return false;
@@ -94,29 +368,17 @@ public:
         
         // Fast path: attempt lock-free enqueue first
         if (queue_.TryPush(item)) {
-            const auto prev = pending_count_.fetch_add(1, std::memory_order_release);
-            if (prev == 0) {
-                not_empty_.notify_one();
-            }
+            pending_count_.fetch_add(1, std::memory_order_release);
+            NotifyNotEmpty();
             return true;
         }
         
-        // Slow path: need to wait, then acquire lock
-        std::unique_lock<std::mutex> lk(push_mutex_);
-        for (;;) {
-            if (Closed()) {
-                return false;
-            }
-            if (queue_.TryPush(item)) {
-                break;
-            }
-            not_full_.wait(lk);
-        }
-        const auto prev = pending_count_.fetch_add(1, std::memory_order_release);
-        lk.unlock();
-        if (prev == 0) {
-            not_empty_.notify_one();
+        // Slow path: park until a consumer frees a slot
+        if (!Await(not_full_, [&] { return !Closed() && queue_.TryPush(item); })) {
+            return false;
         }
+        pending_count_.fetch_add(1, std::memory_order_release);
+        NotifyNotEmpty();
         return true;
     }
     bool WaitPush(T&& item) {
@@ -132,28 +394,17 @@ public:
         };
 
         if (try_push_value()) {
-            const auto prev = pending_count_.fetch_add(1, std::memory_order_release);
-            if (prev == 0) {
-                not_empty_.notify_one();
-            }
+            pending_count_.fetch_add(1, std::memory_order_release);
+            NotifyNotEmpty();
             return true;
         }
 
-        std::unique_lock<std::mutex> lk(push_mutex_);
-        for (;;) {
-            if (Closed()) {
-                return false;
-            }
-            if (try_push_value()) {
-                const auto prev = pending_count_.fetch_add(1, std::memory_order_release);
-                lk.unlock();
-                if (prev == 0) {
-                    not_empty_.notify_one();
-                }
-                return true;
-            }
-            not_full_.wait(lk);
+        if (!Await(not_full_, [&] { return !Closed() && try_push_value(); })) {
+            return false;
         }
+        pending_count_.fetch_add(1, std::memory_order_release);
+        NotifyNotEmpty();
+        return true;
     }
     template <class... Args>
     bool WaitEmplace(Args&&... args) {
@@ -171,49 +422,33 @@ public:
         };
 
         if (try_emplace()) {
-            const auto prev = pending_count_.fetch_add(1, std::memory_order_release);
-            if (prev == 0) {
-                not_empty_.notify_one();
-            }
+            pending_count_.fetch_add(1, std::memory_order_release);
+            NotifyNotEmpty();
             return true;
         }
 
-        std::unique_lock<std::mutex> lk(push_mutex_);
-        for (;;) {
-            if (Closed()) {
-                return false;
-            }
-            if (try_emplace()) {
-                const auto prev = pending_count_.fetch_add(1, std::memory_order_release);
-                lk.unlock();
-                if (prev == 0) {
-                    not_empty_.notify_one();
-                }
-                return true;
-            }
-            not_full_.wait(lk);
+        if (!Await(not_full_, [&] { return !Closed() && try_emplace(); })) {
+            return false;
         }
+        pending_count_.fetch_add(1, std::memory_order_release);
+        NotifyNotEmpty();
+        return true;
     }
 
     bool WaitPop(T& out) {
         // Fast path: attempt lock-free dequeue first
         if (queue_.TryPop(out)) {
             pending_count_.fetch_sub(1, std::memory_order_release);
-            not_full_.notify_one();
+            NotifyNotFull();
             return true;
         }
         
-        // Slow path: need to wait, then acquire lock
-        std::unique_lock<std::mutex> lk(pop_mutex_);
-        while (!queue_.TryPop(out)) {
-            if (Closed()) {
-                return false;
-            }
-            not_empty_.wait(lk);
+        // Slow path: park until a producer publishes an item; drains what is left after Close()
+        if (!Await(not_empty_, [&] { return queue_.TryPop(out); })) {
+            return false;
         }
         pending_count_.fetch_sub(1, std::memory_order_release);
-        lk.unlock();
-        not_full_.notify_one();
+        NotifyNotFull();
         return true;
     }
 
@@ -226,34 +461,21 @@ public:
         
         // Fast path: attempt lock-free enqueue first
         if (queue_.TryPush(item)) {
-            const auto prev = pending_count_.fetch_add(1, std::memory_order_release);
-            if (prev == 0) {
-                not_empty_.notify_one();
-            }
+            pending_count_.fetch_add(1, std::memory_order_release);
+            NotifyNotEmpty();
             return true;
         }
         
-        // Slow path: need to wait
-        std::unique_lock<std::mutex> lk(push_mutex_);
-        auto deadline = std::chrono::steady_clock::now() + timeout;
-
-        for (;;) {
-            if (Closed()) {
-                return false;
-            }
-            if (queue_.TryPush(item)) {
-                break;
-            }
-            if (not_full_.wait_until(lk, deadline) == std::cv_status::timeout) {
+        // Slow path: park until a slot frees up or the deadline passes
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        if (!AwaitUntil(not_full_, [&] { return !Closed() && queue_.TryPush(item); }, deadline)) {
+            if (!Closed()) {
                 discard_counter_.fetch_add(1, std::memory_order_relaxed);
-                return false;
             }
+            return false;
         }
-        const auto prev = pending_count_.fetch_add(1, std::memory_order_release);
-        lk.unlock();
-        if (prev == 0) {
-            not_empty_.notify_one();
-        }
+        pending_count_.fetch_add(1, std::memory_order_release);
+        NotifyNotEmpty();
         return true;
     }
     template <typename Rep, typename Period>
@@ -262,41 +484,29 @@ public:
             return false;
         }
 
-        T value(std::move(item));
+        // Only move item on success: the caller still owns it after a timeout
         auto try_push_value = [&]() {
             return queue_.TryPushWith([&](void* slot) {
-                ::new (slot) T(std::move(value));
+                ::new (slot) T(std::move(item));
             });
         };
 
         if (try_push_value()) {
-            const auto prev = pending_count_.fetch_add(1, std::memory_order_release);
-            if (prev == 0) {
-                not_empty_.notify_one();
-            }
+            pending_count_.fetch_add(1, std::memory_order_release);
+            NotifyNotEmpty();
             return true;
         }
 
-        std::unique_lock<std::mutex> lk(push_mutex_);
-        auto deadline = std::chrono::steady_clock::now() + timeout;
-
-        for (;;) {
-            if (Closed()) {
-                return false;
-            }
-            if (try_push_value()) {
-                const auto prev = pending_count_.fetch_add(1, std::memory_order_release);
-                lk.unlock();
-                if (prev == 0) {
-                    not_empty_.notify_one();
-                }
-                return true;
-            }
-            if (not_full_.wait_until(lk, deadline) == std::cv_status::timeout) {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        if (!AwaitUntil(not_full_, [&] { return !Closed() && try_push_value(); }, deadline)) {
+            if (!Closed()) {
                 discard_counter_.fetch_add(1, std::memory_order_relaxed);
-                return false;
             }
+            return false;
         }
+        pending_count_.fetch_add(1, std::memory_order_release);
+        NotifyNotEmpty();
+        return true;
     }
 
     template <typename Rep, typename Period>
@@ -304,73 +514,37 @@ public:
         // Fast path: attempt lock-free dequeue first
         if (queue_.TryPop(out)) {
             pending_count_.fetch_sub(1, std::memory_order_release);
-            not_full_.notify_one();
+            NotifyNotFull();
             return true;
         }
         
-        // Slow path: need to wait
-        std::unique_lock<std::mutex> lk(pop_mutex_);
-        auto deadline = std::chrono::steady_clock::now() + timeout;
-        
-        while (!queue_.TryPop(out)) {
-            if (Closed()) {
-                return false;
-            }
-            if (not_empty_.wait_until(lk, deadline) == std::cv_status::timeout) {
-                return false;
-            }
+        // Slow path: park until an item arrives or the deadline passes
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        if (!AwaitUntil(not_empty_, [&] { return queue_.TryPop(out); }, deadline)) {
+            return false;
         }
         pending_count_.fetch_sub(1, std::memory_order_release);
-        lk.unlock();
-        not_full_.notify_one();
+        NotifyNotFull();
         return true;
     }
 
-    // Overwrite an old task
+    // Drop-oldest enqueue: when full, the oldest item is moved to *overwritten (if given) and
+    // its cell reused, lock-free. False only if the queue is closed
     bool OverwritePush(T&& item, T* overwritten) {
         if (Closed()) {
             return false;
         }
 
-        // Fast path: try enqueue directly first
-        std::optional<T> hold(std::forward<T>(item));
-        auto try_push_hold = [&]() {
-            return queue_.TryPushWith([&](void* slot) {
-                ::new (slot) T(std::move(*hold));
-            });
-        };
-        if (try_push_hold()) {
-            pending_count_.fetch_add(1, std::memory_order_release);
-            not_empty_.notify_one();
-            return true;
-        }
-
-        // Need overwrite: use dedicated lock
-        std::unique_lock<std::mutex> lk(overwrite_mutex_);
-        if (Closed()) {
-            return false;
-        }
-
-        // Enqueue failed; try to overwrite an existing task
-        std::optional<T> tmp;
-        bool popped = queue_.TryPopConsume([&](T&& value) {
-            tmp.emplace(std::move(value));
+        const bool evicted = queue_.OverwritePush(std::move(item), [&](T&& old) {
+            if (overwritten) {
+                *overwritten = std::move(old);
+            }
         });
-        if (!popped) {
-            return false; // Neither overwritten nor enqueued
-        }
-        pending_count_.fetch_sub(1, std::memory_order_release);
-        if (overwritten) {
-            *overwritten = std::move(*tmp);
-        }
-        const bool ok = try_push_hold();
-        if (ok) {
+        if (!evicted) {
             pending_count_.fetch_add(1, std::memory_order_release);
         }
-
-        lk.unlock(); 
-        not_empty_.notify_one();
-        return ok;
+        NotifyNotEmpty();
+        return true;
     }
 
 
@@ -385,13 +559,30 @@ public:
     size_type Capacity() const noexcept {
         return queue_.Capacity();
     }
+    bool Segmented() const noexcept {
+        return queue_.Segmented();
+    }
+    bool OwnerRing() const noexcept {
+        return queue_.OwnerRing();
+    }
+    size_type Shards() const noexcept {
+        return queue_.Shards();
+    }
+    // QueueStorage::OwnerRing: route the calling thread's pushes to the single-producer ring
+    void BindProducer() noexcept {
+        queue_.BindProducer();
+    }
+    // Bytes held by the queue storage (segments in use or spare, or the ring's cells)
+    size_type MemoryFootprint() const noexcept {
+        return queue_.MemoryFootprint();
+    }
 
     // Close semantics
     void Close() noexcept {
         close_.store(true, std::memory_order_release);
         // Wake all waiting threads
-        not_empty_.notify_all();
-        not_full_.notify_all();
+        NotifyNotEmpty(true);
+        NotifyNotFull(true);
     }
 
     bool Closed() const noexcept {
@@ -403,7 +594,7 @@ public:
         T tmp;
         while (queue_.TryPop(tmp)) {}
         pending_count_.store(0, std::memory_order_release);
-        not_full_.notify_all();
+        NotifyNotFull(true);
     }
 
     template <class Visitor>
@@ -417,7 +608,7 @@ public:
             }
         }
         pending_count_.store(0, std::memory_order_release);
-        not_full_.notify_all();
+        NotifyNotFull(true);
     }
 
     // Number of pending items
@@ -434,11 +625,8 @@ public:
         
         const size_type count = queue_.TryPushBatch(begin, end);
         if (count > 0) {
-            const auto prev = pending_count_.fetch_add(count, std::memory_order_release);
-            // Batch: notify only when the first element is enqueued
-            if (prev == 0) {
-                not_empty_.notify_all();  // For batch, use notify_all to wake multiple consumers
-            }
+            pending_count_.fetch_add(count, std::memory_order_release);
+            NotifyNotEmpty(true);  // For batch, wake multiple consumers
         }
         return count;
     }
@@ -448,11 +636,8 @@ public:
     size_type TryPopBatch(OutputIterator out, size_type max_count) {
         const size_type count = queue_.TryPopBatch(out, max_count);
         if (count > 0) {
-            const auto prev = pending_count_.fetch_sub(count, std::memory_order_release);
-            // Batch: notify when releasing space
-            if (prev >= Capacity() - count && prev <= Capacity()) {
-                not_full_.notify_all();  // For batch, use notify_all to wake multiple producers
-            }
+            pending_count_.fetch_sub(count, std::memory_order_release);
+            NotifyNotFull(true);  // For batch, wake multiple producers
         }
         return count;
     }
@@ -481,30 +666,18 @@ public:
             };
 
             if (try_push_elem()) {
-                const auto prev = pending_count_.fetch_add(1, std::memory_order_release);
-                if (prev == 0) {
-                    not_empty_.notify_one();
-                }
+                pending_count_.fetch_add(1, std::memory_order_release);
+                NotifyNotEmpty();
                 ++pushed;
                 continue;
             }
 
-            std::unique_lock<std::mutex> lk(push_mutex_);
-            for (;;) {
-                if (Closed()) {
-                    return pushed;
-                }
-                if (try_push_elem()) {
-                    const auto prev = pending_count_.fetch_add(1, std::memory_order_release);
-                    lk.unlock();
-                    if (prev == 0) {
-                        not_empty_.notify_one();
-                    }
-                    ++pushed;
-                    break;
-                }
-                not_full_.wait(lk);
+            if (!Await(not_full_, [&] { return !Closed() && try_push_elem(); })) {
+                return pushed;
             }
+            pending_count_.fetch_add(1, std::memory_order_release);
+            NotifyNotEmpty();
+            ++pushed;
         }
 
         return pushed;
@@ -540,22 +713,77 @@ public:
     size_type TryConsumeBatch(Func&& func, size_type max_count) {
         const size_type count = queue_.TryConsumeBatch(std::forward<Func>(func), max_count);
         if (count > 0) {
-            const auto prev = pending_count_.fetch_sub(count, std::memory_order_release);
-            if (prev >= Capacity() - count && prev <= Capacity()) {
-                not_full_.notify_all();
-            }
+            pending_count_.fetch_sub(count, std::memory_order_release);
+            NotifyNotFull(true);
         }
         return count;
     }
 
 private:
-    // Optimization: use multiple fine-grained mutexes to reduce contention
-    mutable std::mutex push_mutex_;       // Used only for waiting on push
-    mutable std::mutex pop_mutex_;        // Used only for waiting on pop
-    mutable std::mutex overwrite_mutex_;  // Used only for overwrite operation
-    std::condition_variable not_full_;
-    std::condition_variable not_empty_;
-    BoundedCircularQueue<T> queue_;       // Lock-free queue
+    // Retry `attempt` until it succeeds (true) or fails with the queue closed (false), parking on
+    // `ec` in between. The retry after PrepareWait() closes the window between a failed attempt
+    // and the park: a notifier either sees the registered waiter or its change is seen here.
+    template <typename Attempt>
+    bool Await(EventCount& ec, Attempt&& attempt) {
+        for (;;) {
+            if (attempt()) {
+                return true;
+            }
+            if (Closed()) {
+                return false;
+            }
+            const auto key = ec.PrepareWait();
+            if (attempt()) {
+                ec.CancelWait();
+                return true;
+            }
+            if (Closed()) {
+                ec.CancelWait();
+                return false;
+            }
+            ec.Wait(key);
+        }
+    }
+    // Same as Await, also false once `deadline` passes
+    template <typename Attempt, typename Clock, typename Duration>
+    bool AwaitUntil(EventCount& ec, Attempt&& attempt, const std::chrono::time_point<Clock, Duration>& deadline) {
+        for (;;) {
+            if (attempt()) {
+                return true;
+            }
+            if (Closed()) {
+                return false;
+            }
+            const auto key = ec.PrepareWait();
+            if (attempt()) {
+                ec.CancelWait();
+                return true;
+            }
+            if (Closed()) {
+                ec.CancelWait();
+                return false;
+            }
+            if (!ec.WaitUntil(key, deadline)) {
+                return attempt(); // Last chance if the wake-up and the deadline raced
+            }
+        }
+    }
+
+    // Signal only when someone is parked; an idle notify is a fence and a load
+    void NotifyNotEmpty(bool all = false) noexcept {
+        all ? not_empty_.NotifyAll() : not_empty_.Notify();
+    }
+    // Under OwnerRing a freed cell may be in the ring the woken producer cannot use, so wake
+    // every parked producer (a sharded push tries every shard: one wake-up is enough)
+    void NotifyNotFull(bool all = false) noexcept {
+        all || queue_.OwnerRing() ? not_full_.NotifyAll() : not_full_.Notify();
+    }
+
+private:
+    EventCount not_full_;                 // Producers parked on a full queue
+    EventCount own_not_empty_;            // Default consumer-side eventcount
+    EventCount& not_empty_;               // Consumers parked on an empty queue (own or shared)
+    AdapterStorage<T, Layout, Producers, Consumers> queue_;  // Lock-free ring(s) or segmented list
     std::atomic<size_type> discard_counter_{0};
     std::atomic<size_type> pending_count_{0};
     std::atomic<bool> close_{false};
@@ -9,12 +9,50 @@
 #include <memory>
 #include <type_traits>
 #include <stdexcept>
+#include <iterator>
+#include <algorithm>
 
-template <typename T>
+// Cell layout policies for BoundedCircularQueue
+// Padded:  one cache line per cell; no false sharing, but small T is mostly padding
+// Packed:  cells at natural alignment; smallest footprint, neighbours share cache lines
+// Striped: packed cells, with tickets remapped so consecutive tickets land on different lines
+struct PaddedCellLayout {};
+struct PackedCellLayout {};
+struct StripedCellLayout {};
+
+// Cardinality policies: how many threads may push / pop concurrently
+// Multi:  tickets are claimed with a CAS on the shared index
+// Single: the one owner advances its index with a plain store (no CAS loop). When both sides
+//         are single (SPSC) the cell seq is unused: each side publishes through its own index
+//         and keeps a cached copy of the other's, refreshed only when the cache says full/empty.
+//         With one multi side the cell seq still carries the handoff, as that side completes
+//         tickets out of order
+struct MultiProducer {};
+struct SingleProducer {};
+struct MultiConsumer {};
+struct SingleConsumer {};
+
+template <typename T, typename Layout = PaddedCellLayout,
+          typename Producers = MultiProducer, typename Consumers = MultiConsumer>
 class BoundedCircularQueue {
+    static_assert(std::is_same_v<Layout, PaddedCellLayout>
+               || std::is_same_v<Layout, PackedCellLayout>
+               || std::is_same_v<Layout, StripedCellLayout>,
+                  "Layout must be PaddedCellLayout, PackedCellLayout or StripedCellLayout");
+    static_assert(std::is_same_v<Producers, MultiProducer> || std::is_same_v<Producers, SingleProducer>,
+                  "Producers must be MultiProducer or SingleProducer");
+    static_assert(std::is_same_v<Consumers, MultiConsumer> || std::is_same_v<Consumers, SingleConsumer>,
+                  "Consumers must be MultiConsumer or SingleConsumer");
+
 public:
     using value_type = T;
     using size_type = std::size_t;
+    using layout_type = Layout;
+    using producers_type = Producers;
+    using consumers_type = Consumers;
+
+    static constexpr bool kSingleProducer = std::is_same_v<Producers, SingleProducer>;
+    static constexpr bool kSingleConsumer = std::is_same_v<Consumers, SingleConsumer>;
 
     // Construction/Destruction
     // Public constructor
@@ -49,11 +87,89 @@ public:
             ::new (p) T(std::forward<Args>(args)...);
         });
     }
+
+    // Drop-oldest enqueue; never fails. When the ring is full the oldest element is handed to
+    // on_evict(T&&) and its cell is reused for the new one. Returns true if it evicted.
+    template <typename C>
+    bool OverwritePush(T&& item, C&& on_evict) {
+        return OverwritePushWith([&](void* p){
+            ::new (p) T(std::move(item));
+        }, std::forward<C>(on_evict));
+    }
+    // Evicting claims a consumer ticket, so the consumer side must be MultiConsumer
+    template <typename Producer, typename C>
+    bool OverwritePushWith(Producer&& producer, C&& on_evict) {
+        static_assert(!kSingleConsumer, "OverwritePush needs a MultiConsumer queue");
+        size_type pos = producer_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = CellAt(pos);
+            size_type seq = cell.seq_.load(std::memory_order_acquire);
+
+            const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                // Free cell: a plain push
+                if (producer_pos_.compare_exchange_weak(
+                        pos, pos + 1
+                        , std::memory_order_relaxed
+                        , std::memory_order_relaxed
+                )) {
+                    try {
+                        producer(static_cast<void*>(cell.storage_));
+                    } catch (...) {
+                        cell.seq_.store(pos, std::memory_order_release);
+                        throw;
+                    }
+                    cell.seq_.store(pos + 1, std::memory_order_release);
+                    return false;
+                }
+            } else if (diff < 0) {
+                // Full: the cell still holds ticket pos - capacity_. Claiming that ticket on the
+                // consumer side evicts it, and as only the claimant can release the cell, no other
+                // producer can take ticket pos either: one CAS gets us both.
+                size_type oldest = pos - capacity_;
+                if (seq == oldest + 1 && consumer_pos_.compare_exchange_strong(
+                        oldest, oldest + 1
+                        , std::memory_order_relaxed
+                        , std::memory_order_relaxed
+                )) {
+                    T* elem = std::launder(reinterpret_cast<T*>(cell.storage_));
+                    try {
+                        on_evict(std::move(*elem));
+                    } catch (...) {
+                        elem->~T();
+                        cell.seq_.store(pos, std::memory_order_release);  // eviction stands; ticket pos is free
+                        throw;
+                    }
+                    elem->~T();
+                    try {
+                        producer(static_cast<void*>(cell.storage_));
+                    } catch (...) {
+                        cell.seq_.store(pos, std::memory_order_release);
+                        throw;
+                    }
+                    // producer_pos_ cannot move past pos until the cell is published
+                    producer_pos_.store(pos + 1, std::memory_order_relaxed);
+                    cell.seq_.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+                // A consumer is taking the oldest, or its producer is still writing it: retry
+                pos = producer_pos_.load(std::memory_order_relaxed);
+            } else {
+                // Another producer claimed the cell; reload producer_pos_ and retry
+                pos = producer_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
     
     bool TryPop(T& out) {
+        if constexpr (kSingleConsumer) {
+            return PopOwned([&](T&& value) {
+                out = std::move(value);
+            });
+        }
         size_type pos = consumer_pos_.load(std::memory_order_relaxed);
         for (;;) {
-            Cell& cell = buffer_[pos & mask_];
+            Cell& cell = CellAt(pos);
             size_type seq = cell.seq_.load(std::memory_order_acquire);
 
             const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
@@ -87,9 +203,12 @@ public:
 
     template <class C>
     bool TryPopConsume(C&& out) {
+        if constexpr (kSingleConsumer) {
+            return PopOwned(out);
+        }
         size_type pos = consumer_pos_.load(std::memory_order_relaxed);
         for (;;) {
-            Cell& cell = buffer_[pos & mask_];
+            Cell& cell = CellAt(pos);
             size_type seq = cell.seq_.load(std::memory_order_acquire);
 
             const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
@@ -129,6 +248,13 @@ public:
     size_type Capacity() const noexcept {
         return capacity_;
     }
+    // Bytes occupied by the cell array
+    size_type MemoryFootprint() const noexcept {
+        return capacity_ * sizeof(Cell);
+    }
+    static constexpr size_type CellSize() noexcept {
+        return sizeof(Cell);
+    }
     bool Empty() const noexcept {
         return ApproxSize() == 0;
     }
@@ -138,14 +264,21 @@ public:
 
     bool TryFront(T& out) const {
         size_type pos = consumer_pos_.load(std::memory_order_relaxed);
-        Cell& cell = buffer_[pos & mask_];
+        const Cell& cell = CellAt(pos);
+        if constexpr (kSpsc) {
+            if (producer_pos_.load(std::memory_order_acquire) == pos) {
+                return false;
+            }
+            out = *std::launder(reinterpret_cast<const T*>(cell.storage_));
+            return true;
+        }
         size_type seq = cell.seq_.load(std::memory_order_acquire);
 
         const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
         if (diff == 0) {
             // Cell is consumable
-            void* storage = cell.storage_;
-            T* elem = std::launder(reinterpret_cast<T*>(storage));
+            const void* storage = cell.storage_;
+            const T* elem = std::launder(reinterpret_cast<const T*>(storage));
             out = *elem; // Observe only; no move
             return true;
         } else {
@@ -154,49 +287,71 @@ public:
         }
     }
 
-     // Batch enqueue (move semantics)
+    // Batch enqueue (move semantics)
+    // Claims a contiguous run of free cells with one CAS on producer_pos_ (one store for a single
+    // producer), then fills them in order
     template <typename Iterator>
     size_type TryPushBatch(Iterator begin, Iterator end) {
-        size_type count = 0;
-        for (auto it = begin; it != end; ++it) {
-            if (!TryPushWith([&](void* p) {
-                    ::new (p) T(std::move(*it));
-                })) {
-                break;
+        using Category = typename std::iterator_traits<Iterator>::iterator_category;
+        constexpr bool kRangeClaim = std::is_base_of_v<std::forward_iterator_tag, Category>
+            && std::is_nothrow_constructible_v<T, decltype(std::move(*begin))>;
+        if constexpr (kRangeClaim) {
+            const auto want = static_cast<size_type>(std::distance(begin, end));
+            size_type first = 0;
+            const size_type count = ClaimPushRange(want, first);
+            auto it = begin;
+            for (size_type i = 0; i < count; ++i, ++it) {
+                ::new (static_cast<void*>(CellAt(first + i).storage_)) T(std::move(*it));
+                PublishCell(first + i);
+            }
+            PublishPushed(first, count);
+            return count;
+        } else {
+            // Throwing constructors or single-pass iterators: one ticket at a time
+            size_type count = 0;
+            for (auto it = begin; it != end; ++it) {
+                if (!TryPushWith([&](void* p) {
+                        ::new (p) T(std::move(*it));
+                    })) {
+                    break;
+                }
+                ++count;
             }
-            ++count;
+            return count;
         }
-        return count;
     }
 
     // Batch dequeue
     template <typename OutputIterator>
     size_type TryPopBatch(OutputIterator out, size_type max_count) {
-        size_type count = 0;
-        T item;
-        for (size_type i = 0; i < max_count; ++i) {
-            if (!TryPop(item)) {
-                break;
-            }
+        return TryConsumeBatch([&](T&& item) {
             *out++ = std::move(item);
-            ++count;
-        }
-        return count;
+        }, max_count);
     }
 
     // Batch consume (with callback)
+    // Claims a contiguous run of ready cells with one CAS on consumer_pos_ (one store for a single
+    // consumer), then drains them in order.
+    // If func throws, the remaining claimed items are destroyed and their cells released.
     template <typename Func>
     size_type TryConsumeBatch(Func&& func, size_type max_count) {
-        size_type count = 0;
-        for (size_type i = 0; i < max_count; ++i) {
-            bool consumed = TryPopConsume([&](T&& item) {
-                func(std::move(item));
-            });
-            if (!consumed) {
-                break;
+        size_type first = 0;
+        const size_type count = ClaimPopRange(max_count, first);
+        size_type i = 0;
+        try {
+            for (; i < count; ++i) {
+                T* elem = std::launder(reinterpret_cast<T*>(CellAt(first + i).storage_));
+                func(std::move(*elem));
+                ReleaseCell(first + i);
+            }
+        } catch (...) {
+            for (; i < count; ++i) {
+                ReleaseCell(first + i);
             }
-            ++count;
+            ReleasePopped(first, count);
+            throw;
         }
+        ReleasePopped(first, count);
         return count;
     }
 
@@ -209,18 +364,67 @@ private:
         , mask_(capacity_ - 1)
         , buffer_(capacity_)
     {
+        if constexpr (std::is_same_v<Layout, StripedCellLayout>) {
+            const size_type per_line = std::min(CellsPerLine(), capacity_);
+            const size_type lines = capacity_ / per_line;
+            per_line_shift_ = Log2(per_line);
+            line_shift_ = Log2(lines);
+            line_mask_ = lines - 1;
+        }
         // Initialize sequence number for each slot
         for (size_type i = 0; i < capacity_; ++i) {
-            buffer_[i].seq_.store(i, std::memory_order_relaxed);
+            CellAt(i).seq_.store(i, std::memory_order_relaxed);
         }
     }
     
+    static constexpr size_type kCacheLine = 64;
+    static constexpr bool kSpsc = kSingleProducer && kSingleConsumer;
+
     // Single slot (Cell)
-    struct alignas(64) Cell {
+    struct alignas(kCacheLine) PaddedCell {
+        std::atomic<size_type> seq_{0};
+        alignas(alignof(T)) unsigned char storage_[sizeof(T)];
+        PaddedCell() noexcept : storage_{} {}
+    };
+    struct PackedCell {
         std::atomic<size_type> seq_{0};
         alignas(alignof(T)) unsigned char storage_[sizeof(T)];
-        Cell() noexcept : storage_{} {}
+        PackedCell() noexcept : storage_{} {}
     };
+    using Cell = std::conditional_t<std::is_same_v<Layout, PaddedCellLayout>, PaddedCell, PackedCell>;
+
+    // Striped layout: a power-of-two number of cells per cache line (1 if a cell spans a line)
+    static constexpr size_type CellsPerLine() noexcept {
+        size_type n = 1;
+        while (n * 2 * sizeof(Cell) <= kCacheLine) {
+            n *= 2;
+        }
+        return n;
+    }
+    static constexpr size_type Log2(size_type n) noexcept {
+        size_type r = 0;
+        while ((size_type{1} << r) < n) {
+            ++r;
+        }
+        return r;
+    }
+
+    // Map a ticket to its cell. Striped treats the ring as a lines x per_line matrix and
+    // walks it column-wise, so ticket i and i+1 sit in different cache lines.
+    Cell& CellAt(size_type ticket) noexcept {
+        return buffer_[Index(ticket)];
+    }
+    const Cell& CellAt(size_type ticket) const noexcept {
+        return buffer_[Index(ticket)];
+    }
+    size_type Index(size_type ticket) const noexcept {
+        const size_type i = ticket & mask_;
+        if constexpr (std::is_same_v<Layout, StripedCellLayout>) {
+            return ((i & line_mask_) << per_line_shift_) | (i >> line_shift_);
+        } else {
+            return i;
+        }
+    }
 
     static size_type RoundUpToPow2(size_type n) {
         if (n < 2) {return 2;}
@@ -239,9 +443,12 @@ private:
     // Enqueue helper: claim cell storage and construct in-place
     template <typename Func>
     bool DoPush(Func&& f) {
+        if constexpr (kSingleProducer) {
+            return PushOwned(f);
+        }
         size_type pos = producer_pos_.load(std::memory_order_relaxed);
         for (;;) {
-            Cell& cell = buffer_[pos & mask_];
+            Cell& cell = CellAt(pos);
             size_type seq = cell.seq_.load(std::memory_order_acquire);
 
             const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
@@ -275,11 +482,173 @@ private:
         }
     }
 
+    // Claim up to max consecutive tickets from cursor whose cells are ready for this side
+    // (seq == ticket + offset: 0 for producers, 1 for consumers). Returns the count; first gets the
+    // first ticket. Cells are scanned before the single CAS, and only the ticket owner can advance a
+    // cell's seq, so the whole range stays valid once the CAS succeeds.
+    size_type ClaimRange(std::atomic<size_type>& cursor, size_type max, size_type offset, size_type& first) {
+        if (max > capacity_) {
+            max = capacity_;
+        }
+        if (max == 0) {
+            return 0;
+        }
+        size_type pos = cursor.load(std::memory_order_relaxed);
+        for (;;) {
+            size_type n = 0;
+            size_type seq = 0;
+            while (n < max) {
+                seq = CellAt(pos + n).seq_.load(std::memory_order_acquire);
+                if (seq != pos + n + offset) {
+                    break;
+                }
+                ++n;
+            }
+            if (n == 0) {
+                const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + offset);
+                if (diff < 0) {
+                    return 0; // Full (producers) or empty (consumers)
+                }
+                pos = cursor.load(std::memory_order_relaxed); // Lost the race; retry from the new head
+                continue;
+            }
+            if (cursor.compare_exchange_weak(pos, pos + n,
+                    std::memory_order_relaxed, std::memory_order_relaxed)) {
+                first = pos;
+                return n;
+            }
+        }
+    }
+
+    // Single-side claims: the owner reads the ready run and moves its index with a plain store.
+    // Nobody else writes the index, so the run cannot be taken in between
+    size_type ClaimOwned(std::atomic<size_type>& cursor, size_type max, size_type offset, size_type& first) {
+        max = std::min(max, capacity_);
+        const size_type pos = cursor.load(std::memory_order_relaxed);
+        size_type n = 0;
+        while (n < max && CellAt(pos + n).seq_.load(std::memory_order_acquire) == pos + n + offset) {
+            ++n;
+        }
+        if (n != 0) {
+            cursor.store(pos + n, std::memory_order_relaxed);
+        }
+        first = pos;
+        return n;
+    }
+    // SPSC: free/ready counts come from the other side's index, re-read only when the cached copy
+    // falls short. The own index moves on publish (PublishPushed/ReleasePopped)
+    size_type ClaimSpscPush(size_type max, size_type& first) noexcept {
+        first = producer_pos_.load(std::memory_order_relaxed);
+        if (capacity_ - (first - cached_consumer_pos_) < max) {
+            cached_consumer_pos_ = consumer_pos_.load(std::memory_order_acquire);
+        }
+        return std::min(max, capacity_ - (first - cached_consumer_pos_));
+    }
+    size_type ClaimSpscPop(size_type max, size_type& first) noexcept {
+        first = consumer_pos_.load(std::memory_order_relaxed);
+        if (cached_producer_pos_ - first < max) {
+            cached_producer_pos_ = producer_pos_.load(std::memory_order_acquire);
+        }
+        return std::min(max, cached_producer_pos_ - first);
+    }
+    size_type ClaimPushRange(size_type max, size_type& first) {
+        if constexpr (kSpsc) {
+            return ClaimSpscPush(max, first);
+        } else if constexpr (kSingleProducer) {
+            return ClaimOwned(producer_pos_, max, 0, first);
+        } else {
+            return ClaimRange(producer_pos_, max, 0, first);
+        }
+    }
+    size_type ClaimPopRange(size_type max, size_type& first) {
+        if constexpr (kSpsc) {
+            return ClaimSpscPop(max, first);
+        } else if constexpr (kSingleConsumer) {
+            return ClaimOwned(consumer_pos_, max, 1, first);
+        } else {
+            return ClaimRange(consumer_pos_, max, 1, first);
+        }
+    }
+
+    // Single-producer enqueue; a throwing constructor leaves the queue as it was
+    template <typename Func>
+    bool PushOwned(Func& f) {
+        size_type pos = 0;
+        if (ClaimPushRange(1, pos) == 0) {
+            return false;
+        }
+        try {
+            f(static_cast<void*>(CellAt(pos).storage_));
+        } catch (...) {
+            if constexpr (!kSpsc) {
+                producer_pos_.store(pos, std::memory_order_relaxed);
+            }
+            throw;
+        }
+        PublishCell(pos);
+        PublishPushed(pos, 1);
+        return true;
+    }
+    // Single-consumer dequeue; if out throws, the element is still destroyed and its cell released
+    template <typename C>
+    bool PopOwned(C&& out) {
+        size_type pos = 0;
+        if (ClaimPopRange(1, pos) == 0) {
+            return false;
+        }
+        try {
+            out(std::move(*std::launder(reinterpret_cast<T*>(CellAt(pos).storage_))));
+        } catch (...) {
+            ReleaseCell(pos);
+            ReleasePopped(pos, 1);
+            throw;
+        }
+        ReleaseCell(pos);
+        ReleasePopped(pos, 1);
+        return true;
+    }
+
+    // Mark a constructed cell consumable (SPSC publishes the whole run via producer_pos_ instead)
+    void PublishCell(size_type ticket) noexcept {
+        if constexpr (!kSpsc) {
+            CellAt(ticket).seq_.store(ticket + 1, std::memory_order_release);
+        }
+    }
+    void PublishPushed(size_type first, size_type count) noexcept {
+        if constexpr (kSpsc) {
+            if (count != 0) {
+                producer_pos_.store(first + count, std::memory_order_release);
+            }
+        }
+    }
+
+    // Destroy the element of a claimed ticket and hand the cell to the next write round
+    void ReleaseCell(size_type ticket) noexcept {
+        Cell& cell = CellAt(ticket);
+        std::launder(reinterpret_cast<T*>(cell.storage_))->~T();
+        if constexpr (!kSpsc) {
+            cell.seq_.store(ticket + capacity_, std::memory_order_release);
+        }
+    }
+    void ReleasePopped(size_type first, size_type count) noexcept {
+        if constexpr (kSpsc) {
+            if (count != 0) {
+                consumer_pos_.store(first + count, std::memory_order_release);
+            }
+        }
+    }
+
 private:
     const size_type capacity_;
     const size_type mask_; // equals capacity_ - 1
     std::vector<Cell> buffer_;
+    // Striped layout only
+    size_type per_line_shift_{0};
+    size_type line_shift_{0};
+    size_type line_mask_{0};
 
     alignas(64) std::atomic<size_type> producer_pos_{0};
+    size_type cached_consumer_pos_{0};  // SPSC: producer's last look at consumer_pos_
     alignas(64) std::atomic<size_type> consumer_pos_{0};
+    size_type cached_producer_pos_{0};  // SPSC: consumer's last look at producer_pos_
 };
@@ -0,0 +1,136 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+
+#if defined(__linux__)
+    #include <ctime>
+    #include <linux/futex.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#else
+    #include <condition_variable>
+    #include <mutex>
+#endif
+
+// Waiter-counted eventcount: lets a thread sleep until some lock-free condition may have
+// changed, without a mutex on the notify side.
+//
+// Waiter:   key = PrepareWait(); re-check condition; then CancelWait() or Wait(key)
+// Notifier: publish the change; Notify()/NotifyAll()
+//
+// PrepareWait registers the waiter and snapshots the epoch behind a full fence; Notify fences
+// and only bumps the epoch (and wakes) when a waiter is registered. So either the waiter's
+// re-check sees the change, or the notifier sees the waiter and Wait(key) returns. An idle
+// notify is a fence plus a load and never enters the kernel.
+// Parks on a futex on Linux, on a mutex + condition_variable elsewhere.
+class EventCount {
+public:
+    using Key = std::uint32_t;
+
+    EventCount() = default;
+    EventCount(const EventCount&) = delete;
+    EventCount& operator=(const EventCount&) = delete;
+
+    Key PrepareWait() noexcept {
+        waiters_.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return epoch_.load(std::memory_order_relaxed);
+    }
+    void CancelWait() noexcept {
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // Block until a notification issued after PrepareWait() (spurious returns possible)
+    void Wait(Key key) noexcept {
+        while (epoch_.load(std::memory_order_acquire) == key) {
+            Park(key, nullptr);
+        }
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // Same as Wait, false if the deadline passed without a notification
+    template <typename Clock, typename Duration>
+    bool WaitUntil(Key key, const std::chrono::time_point<Clock, Duration>& deadline) noexcept {
+        bool notified = true;
+        while (epoch_.load(std::memory_order_acquire) == key) {
+            const auto now = Clock::now();
+            if (now >= deadline) {
+                notified = false;
+                break;
+            }
+            const auto left = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now);
+            Park(key, &left);
+        }
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+        return notified;
+    }
+
+    void Notify() noexcept {
+        Signal(false);
+    }
+    void NotifyAll() noexcept {
+        Signal(true);
+    }
+
+    // Registered waiters (diagnostics)
+    std::uint32_t Waiters() const noexcept {
+        return waiters_.load(std::memory_order_relaxed);
+    }
+
+private:
+    void Signal(bool all) noexcept {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters_.load(std::memory_order_relaxed) == 0) {
+            return;
+        }
+        epoch_.fetch_add(1, std::memory_order_release);
+        Wake(all);
+    }
+
+#if defined(__linux__)
+    static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t),
+                  "futex word must be a plain 32-bit integer");
+
+    std::uint32_t* FutexWord() noexcept {
+        return reinterpret_cast<std::uint32_t*>(&epoch_);
+    }
+    void Park(Key key, const std::chrono::nanoseconds* timeout) noexcept {
+        timespec ts{};
+        timespec* tsp = nullptr;
+        if (timeout) {
+            ts.tv_sec = static_cast<std::time_t>(timeout->count() / 1000000000);
+            ts.tv_nsec = static_cast<long>(timeout->count() % 1000000000);
+            tsp = &ts;
+        }
+        // EAGAIN (epoch already moved), EINTR and ETIMEDOUT are all handled by the caller's loop
+        syscall(SYS_futex, FutexWord(), FUTEX_WAIT_PRIVATE, key, tsp, nullptr, 0);
+    }
+    void Wake(bool all) noexcept {
+        const int n = all ? std::numeric_limits<int>::max() : 1;
+        syscall(SYS_futex, FutexWord(), FUTEX_WAKE_PRIVATE, n, nullptr, nullptr, 0);
+    }
+#else
+    void Park(Key key, const std::chrono::nanoseconds* timeout) noexcept {
+        std::unique_lock<std::mutex> lk(mutex_);
+        auto moved = [&] { return epoch_.load(std::memory_order_acquire) != key; };
+        if (timeout) {
+            cv_.wait_for(lk, *timeout, moved);
+        } else {
+            cv_.wait(lk, moved);
+        }
+    }
+    void Wake(bool all) noexcept {
+        // Taking the lock orders the epoch bump against a waiter between its check and its wait
+        { std::lock_guard<std::mutex> lk(mutex_); }
+        all ? cv_.notify_all() : cv_.notify_one();
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+#endif
+
+    std::atomic<std::uint32_t> epoch_{0};
+    std::atomic<std::uint32_t> waiters_{0};
+};
@@ -0,0 +1,464 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <utility>
+#include <new>
+#include <limits>
+#include <thread>
+#include <type_traits>
+#include <iterator>
+#include <algorithm>
+
+// Unbounded MPMC queue made of linked segments of SegmentSize - 1 slots (after crossbeam's
+// SegQueue). Producers and consumers claim slots by advancing a tail/head index with one CAS;
+// whoever claims the last slot of a segment links in (producers) or moves on to (consumers)
+// the next one. Pushes never fail.
+//
+// Reclamation needs no epochs or hazard pointers: a thread only dereferences a segment after
+// its CAS on the monotonic index proved the segment current, and then only the slot it
+// claimed. A segment is released once every slot in it has been read: the consumer of the
+// last slot starts the release, and a slot still being read when it gets there is marked
+// DESTROY so that its reader finishes the job. Released segments go to a small lock-free
+// spare list for the next allocation; beyond that they are freed, so memory tracks the live
+// backlog plus at most kSpareSegments.
+template <typename T, std::size_t SegmentSize = 64>
+class SegmentedQueue {
+    static_assert(SegmentSize >= 2 && (SegmentSize & (SegmentSize - 1)) == 0,
+                  "SegmentSize must be a power of two >= 2");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    static constexpr size_type kSegmentSlots = SegmentSize - 1;  // last position marks "move to next"
+    static constexpr size_type kSpareSegments = 4;               // released segments kept for reuse
+
+    SegmentedQueue() {
+        Segment* first = NewSegment();
+        head_.segment.store(first, std::memory_order_relaxed);
+        tail_.segment.store(first, std::memory_order_relaxed);
+    }
+    // `capacity` is ignored (accepted so it constructs like BoundedCircularQueue)
+    explicit SegmentedQueue(size_type /*capacity*/) : SegmentedQueue() {}
+
+    ~SegmentedQueue() {
+        size_type head = head_.index.load(std::memory_order_relaxed) & ~kHasNext;
+        const size_type tail = tail_.index.load(std::memory_order_relaxed) & ~kHasNext;
+        Segment* segment = head_.segment.load(std::memory_order_relaxed);
+        // Destroy what is still queued, then the segments themselves
+        while (head != tail) {
+            const size_type offset = (head >> kShift) % SegmentSize;
+            if (offset < kSegmentSlots) {
+                Slot& slot = segment->slots[offset];
+                if ((slot.state.load(std::memory_order_relaxed) & kEmpty) == 0) {
+                    slot.Value()->~T();
+                }
+            } else {
+                Segment* next = segment->next.load(std::memory_order_relaxed);
+                delete segment;
+                segment = next;
+            }
+            head += size_type{1} << kShift;
+        }
+        delete segment;
+        for (auto& spare : spare_) {
+            delete spare.load(std::memory_order_relaxed);
+        }
+    }
+
+    SegmentedQueue(const SegmentedQueue&) = delete;
+    SegmentedQueue& operator=(const SegmentedQueue&) = delete;
+    SegmentedQueue(SegmentedQueue&&) = delete;
+    SegmentedQueue& operator=(SegmentedQueue&&) = delete;
+
+    // Core operations: enqueue never fails, dequeue fails only when empty
+    bool TryPush(const T& item) {
+        return TryPushWith([&](void* p){
+            ::new (p) T(item);
+        });
+    }
+    bool TryPush(T&& item) {
+        return TryPushWith([&](void* p){
+            ::new (p) T(std::move(item));
+        });
+    }
+    template <typename... Args>
+    bool TryEmplace(Args&&... args) {
+        return TryPushWith([&](void* p){
+            ::new (p) T(std::forward<Args>(args)...);
+        });
+    }
+    // Never full, so it never evicts (BoundedCircularQueue::OverwritePush counterpart)
+    template <typename C>
+    bool OverwritePush(T&& item, C&& /*on_evict*/) {
+        TryPush(std::move(item));
+        return false;
+    }
+
+    template <typename Producer>
+    bool TryPushWith(Producer&& producer) {
+        size_type first = 0;
+        Segment* segment = ClaimPush(1, first);
+        Slot& slot = segment->slots[first];
+        try {
+            producer(static_cast<void*>(slot.storage));
+        } catch (...) {
+            // The ticket is spent: publish it as an empty slot that consumers skip
+            slot.state.fetch_or(kWrite | kEmpty, std::memory_order_release);
+            throw;
+        }
+        slot.state.fetch_or(kWrite, std::memory_order_release);
+        return true;
+    }
+
+    bool TryPop(T& out) {
+        return TryPopConsume([&](T&& value) {
+            out = std::move(value);
+        });
+    }
+
+    template <class C>
+    bool TryPopConsume(C&& out) {
+        for (;;) {
+            size_type first = 0;
+            Segment* segment = nullptr;
+            if (ClaimPop(1, first, segment) == 0) {
+                return false;
+            }
+            if (Consume(segment, first, 1, out) == 1) {
+                return true;
+            }
+            // Skipped a slot whose construction threw; take the next one
+        }
+    }
+
+    // Batch enqueue (move semantics); pushes the whole range, claiming up to the end of a
+    // segment per CAS
+    template <typename Iterator>
+    size_type TryPushBatch(Iterator begin, Iterator end) {
+        using Category = typename std::iterator_traits<Iterator>::iterator_category;
+        constexpr bool kRangeClaim = std::is_base_of_v<std::forward_iterator_tag, Category>
+            && std::is_nothrow_constructible_v<T, decltype(std::move(*begin))>;
+        size_type count = 0;
+        if constexpr (kRangeClaim) {
+            auto it = begin;
+            auto left = static_cast<size_type>(std::distance(begin, end));
+            while (left > 0) {
+                size_type first = 0;
+                Segment* segment = ClaimPush(left, first);
+                const size_type n = std::min(left, kSegmentSlots - first);
+                for (size_type i = 0; i < n; ++i, ++it) {
+                    Slot& slot = segment->slots[first + i];
+                    ::new (static_cast<void*>(slot.storage)) T(std::move(*it));
+                    slot.state.fetch_or(kWrite, std::memory_order_release);
+                }
+                left -= n;
+                count += n;
+            }
+        } else {
+            for (auto it = begin; it != end; ++it) {
+                TryPushWith([&](void* p) {
+                    ::new (p) T(std::move(*it));
+                });
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    // Batch dequeue
+    template <typename OutputIterator>
+    size_type TryPopBatch(OutputIterator out, size_type max_count) {
+        return TryConsumeBatch([&](T&& item) {
+            *out++ = std::move(item);
+        }, max_count);
+    }
+
+    // Batch consume (with callback); claims up to the end of the current segment per CAS.
+    // If func throws, the remaining claimed items are destroyed.
+    template <typename Func>
+    size_type TryConsumeBatch(Func&& func, size_type max_count) {
+        size_type total = 0;
+        while (total < max_count) {
+            size_type first = 0;
+            Segment* segment = nullptr;
+            const size_type n = ClaimPop(max_count - total, first, segment);
+            if (n == 0) {
+                break;
+            }
+            total += Consume(segment, first, n, func);
+        }
+        return total;
+    }
+
+    // Observation utilities; approximate under concurrency
+    size_type ApproxSize() const noexcept {
+        const size_type tail = Ordinal(tail_.index.load(std::memory_order_relaxed));
+        const size_type head = Ordinal(head_.index.load(std::memory_order_relaxed));
+        return tail > head ? tail - head : 0;
+    }
+    size_type Capacity() const noexcept {
+        return std::numeric_limits<size_type>::max();
+    }
+    // Bytes held in segments, queued or spare
+    size_type MemoryFootprint() const noexcept {
+        return live_segments_.load(std::memory_order_relaxed) * sizeof(Segment);
+    }
+    static constexpr size_type SegmentBytes() noexcept {
+        return sizeof(Segment);
+    }
+    bool Empty() const noexcept {
+        return ApproxSize() == 0;
+    }
+    bool Full() const noexcept {
+        return false;
+    }
+
+private:
+    // Index layout: position << kShift, low bit = head knows a next segment exists
+    static constexpr size_type kShift = 1;
+    static constexpr size_type kHasNext = 1;
+
+    // Slot state bits
+    static constexpr std::uint32_t kWrite = 1;    // value published
+    static constexpr std::uint32_t kRead = 2;     // value taken
+    static constexpr std::uint32_t kDestroy = 4;  // segment release is waiting on this slot's reader
+    static constexpr std::uint32_t kEmpty = 8;    // construction threw: nothing to read
+
+    struct Slot {
+        alignas(alignof(T)) unsigned char storage[sizeof(T)];
+        std::atomic<std::uint32_t> state{0};
+        T* Value() noexcept {
+            return std::launder(reinterpret_cast<T*>(storage));
+        }
+    };
+    struct Segment {
+        std::atomic<Segment*> next{nullptr};
+        Slot slots[kSegmentSlots];
+    };
+    struct alignas(64) Position {
+        std::atomic<size_type> index{0};
+        std::atomic<Segment*>  segment{nullptr};
+    };
+
+    static void Backoff(unsigned& step) noexcept {
+        if (++step > 16) {
+            std::this_thread::yield();
+        }
+    }
+
+    // Element count before `index` (positions minus one "move on" marker per segment)
+    static size_type Ordinal(size_type index) noexcept {
+        const size_type pos = index >> kShift;
+        return pos / SegmentSize * kSegmentSlots + pos % SegmentSize;
+    }
+
+    Segment* NewSegment() {
+        for (auto& spare : spare_) {
+            if (spare.load(std::memory_order_relaxed) != nullptr) {
+                if (Segment* segment = spare.exchange(nullptr, std::memory_order_acquire)) {
+                    return segment;
+                }
+            }
+        }
+        live_segments_.fetch_add(1, std::memory_order_relaxed);
+        return new Segment();
+    }
+
+    // Recycle into a spare cell if one is free, otherwise free it
+    void ReleaseSegment(Segment* segment) noexcept {
+        segment->next.store(nullptr, std::memory_order_relaxed);
+        for (auto& slot : segment->slots) {
+            slot.state.store(0, std::memory_order_relaxed);
+        }
+        for (auto& spare : spare_) {
+            Segment* expected = nullptr;
+            if (spare.load(std::memory_order_relaxed) == nullptr
+                && spare.compare_exchange_strong(expected, segment, std::memory_order_release,
+                                                 std::memory_order_relaxed)) {
+                return;
+            }
+        }
+        live_segments_.fetch_sub(1, std::memory_order_relaxed);
+        delete segment;
+    }
+
+    // Release `segment` once slots [start, kSegmentSlots - 1) are all read; if one is still
+    // being read, leave DESTROY on it and let its reader call back in
+    void Destroy(Segment* segment, size_type start) noexcept {
+        for (size_type i = start; i + 1 < kSegmentSlots; ++i) {
+            Slot& slot = segment->slots[i];
+            if ((slot.state.load(std::memory_order_acquire) & kRead) == 0
+                && (slot.state.fetch_or(kDestroy, std::memory_order_acq_rel) & kRead) == 0) {
+                return;
+            }
+        }
+        ReleaseSegment(segment);
+    }
+
+    // Claim up to `want` consecutive producer slots within one segment (at least one);
+    // `first` gets the slot offset. The claimant of a segment's last slot links the next one
+    Segment* ClaimPush(size_type want, size_type& first) {
+        unsigned step = 0;
+        Segment* next_segment = nullptr;
+        size_type tail = tail_.index.load(std::memory_order_acquire);
+        Segment* segment = tail_.segment.load(std::memory_order_acquire);
+        for (;;) {
+            const size_type offset = (tail >> kShift) % SegmentSize;
+            if (offset == kSegmentSlots) {
+                // Another producer is linking the next segment
+                Backoff(step);
+                tail = tail_.index.load(std::memory_order_acquire);
+                segment = tail_.segment.load(std::memory_order_acquire);
+                continue;
+            }
+            const size_type n = std::min(want, kSegmentSlots - offset);
+            const bool last = offset + n == kSegmentSlots;
+            if (last && next_segment == nullptr) {
+                next_segment = NewSegment();  // allocate before the CAS, not while others wait
+            }
+            const size_type new_tail = tail + (n << kShift);
+            if (tail_.index.compare_exchange_weak(tail, new_tail, std::memory_order_seq_cst,
+                                                  std::memory_order_acquire)) {
+                if (last) {
+                    tail_.segment.store(next_segment, std::memory_order_release);
+                    tail_.index.store(new_tail + (size_type{1} << kShift), std::memory_order_release);
+                    segment->next.store(next_segment, std::memory_order_release);
+                } else if (next_segment != nullptr) {
+                    ReleaseSegment(next_segment);
+                }
+                first = offset;
+                return segment;
+            }
+            segment = tail_.segment.load(std::memory_order_acquire);
+            Backoff(step);
+        }
+    }
+
+    // Claim up to `want` published-or-claimed consumer slots within one segment; 0 if empty
+    size_type ClaimPop(size_type want, size_type& first, Segment*& segment_out) {
+        unsigned step = 0;
+        size_type head = head_.index.load(std::memory_order_acquire);
+        Segment* segment = head_.segment.load(std::memory_order_acquire);
+        for (;;) {
+            const size_type offset = (head >> kShift) % SegmentSize;
+            if (offset == kSegmentSlots) {
+                // Another consumer is moving head to the next segment
+                Backoff(step);
+                head = head_.index.load(std::memory_order_acquire);
+                segment = head_.segment.load(std::memory_order_acquire);
+                continue;
+            }
+            size_type n = std::min(want, kSegmentSlots - offset);
+            size_type new_flag = head & kHasNext;
+            if (new_flag == 0) {
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                const size_type tail = tail_.index.load(std::memory_order_relaxed);
+                if ((head >> kShift) == (tail >> kShift)) {
+                    return 0;  // empty
+                }
+                if ((head >> kShift) / SegmentSize != (tail >> kShift) / SegmentSize) {
+                    new_flag = kHasNext;
+                } else {
+                    n = std::min(n, ((tail >> kShift) - (head >> kShift)));
+                }
+            }
+            const size_type new_head = ((head & ~kHasNext) + (n << kShift)) | new_flag;
+            if (head_.index.compare_exchange_weak(head, new_head, std::memory_order_seq_cst,
+                                                  std::memory_order_acquire)) {
+                if (offset + n == kSegmentSlots) {
+                    // Claimed the last slot: move head on to the next segment
+                    Segment* next = WaitNext(segment);
+                    size_type next_index = (new_head & ~kHasNext) + (size_type{1} << kShift);
+                    if (next->next.load(std::memory_order_relaxed) != nullptr) {
+                        next_index |= kHasNext;
+                    }
+                    head_.segment.store(next, std::memory_order_release);
+                    head_.index.store(next_index, std::memory_order_release);
+                }
+                first = offset;
+                segment_out = segment;
+                return n;
+            }
+            segment = head_.segment.load(std::memory_order_acquire);
+            Backoff(step);
+        }
+    }
+
+    static Segment* WaitNext(Segment* segment) noexcept {
+        unsigned step = 0;
+        for (;;) {
+            if (Segment* next = segment->next.load(std::memory_order_acquire)) {
+                return next;
+            }
+            Backoff(step);
+        }
+    }
+
+    // Read claimed slots [first, first + n) of `segment` into func, then hand back the
+    // segment if this finished it. Returns the values delivered (slots whose construction
+    // threw are skipped). If func throws, the rest are destroyed unread.
+    template <typename Func>
+    size_type Consume(Segment* segment, size_type first, size_type n, Func& func) {
+        const bool ends_segment = first + n == kSegmentSlots;
+        size_type delivered = 0;
+        size_type i = 0;
+        auto finish = [&](size_type offset) noexcept {
+            // After this, `segment` may be gone unless we own its last slot
+            if (offset + 1 == kSegmentSlots) {
+                return;  // released below, once all our slots are marked
+            }
+            const auto prev = segment->slots[offset].state.fetch_or(kRead, std::memory_order_acq_rel);
+            if ((prev & kDestroy) != 0) {
+                Destroy(segment, offset + 1);
+            }
+        };
+        try {
+            for (; i < n; ++i) {
+                Slot& slot = segment->slots[first + i];
+                unsigned step = 0;
+                while ((slot.state.load(std::memory_order_acquire) & kWrite) == 0) {
+                    Backoff(step);  // the producer claimed it and is still writing
+                }
+                if ((slot.state.load(std::memory_order_relaxed) & kEmpty) == 0) {
+                    T* elem = slot.Value();
+                    struct DestroyOnExit {
+                        T* p;
+                        ~DestroyOnExit() { p->~T(); }
+                    } guard{elem};
+                    func(std::move(*elem));
+                    ++delivered;
+                }
+                finish(first + i);
+            }
+        } catch (...) {
+            finish(first + i);
+            for (++i; i < n; ++i) {
+                Slot& slot = segment->slots[first + i];
+                unsigned step = 0;
+                while ((slot.state.load(std::memory_order_acquire) & kWrite) == 0) {
+                    Backoff(step);
+                }
+                if ((slot.state.load(std::memory_order_relaxed) & kEmpty) == 0) {
+                    slot.Value()->~T();
+                }
+                finish(first + i);
+            }
+            if (ends_segment) {
+                Destroy(segment, 0);
+            }
+            throw;
+        }
+        if (ends_segment) {
+            Destroy(segment, 0);
+        }
+        return delivered;
+    }
+
+private:
+    Position head_;
+    Position tail_;
+    alignas(64) std::atomic<Segment*> spare_[kSpareSegments] = {};
+    std::atomic<size_type> live_segments_{0};
+};
@@ -0,0 +1,153 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <vector>
+#include <utility>
+#include <new>
+#include <type_traits>
+
+// Bounded Chase-Lev work-stealing deque (Le et al., "Correct and Efficient
+// Work-Stealing for Weak Memory Models").
+// The owner thread pushes/pops at the bottom (LIFO); any other thread may steal
+// from the top (FIFO). Unlike the textbook version, elements are claimed before
+// they are read, so T does not need to be trivially copyable: each cell carries
+// an occupancy flag that keeps the owner from reusing a slot a thief is still
+// moving out of.
+template <typename T>
+class WorkStealingDeque {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    explicit WorkStealingDeque(size_type capacity)
+        : capacity_(RoundUpToPow2(capacity))
+        , mask_(capacity_ - 1)
+        , buffer_(capacity_) {}
+
+    ~WorkStealingDeque() {
+        for (auto& cell : buffer_) {
+            if (cell.full_.load(std::memory_order_acquire)) {
+                std::launder(reinterpret_cast<T*>(cell.storage_))->~T();
+            }
+        }
+    }
+
+    // Disable copy/move
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+    WorkStealingDeque(WorkStealingDeque&&) = delete;
+    WorkStealingDeque& operator=(WorkStealingDeque&&) = delete;
+
+    // Owner only: push at the bottom; item is moved only on success
+    bool TryPush(T&& item) {
+        const auto b = bottom_.load(std::memory_order_relaxed);
+        const auto t = top_.load(std::memory_order_acquire);
+        if (b - t >= static_cast<index_type>(capacity_)) {
+            return false; // Full
+        }
+        Cell& cell = buffer_[static_cast<size_type>(b) & mask_];
+        if (cell.full_.load(std::memory_order_acquire)) {
+            return false; // A thief claimed this slot last round and is still moving it out
+        }
+        ::new (cell.storage_) T(std::move(item));
+        cell.full_.store(true, std::memory_order_relaxed);
+        // Publish the element before the new bottom becomes visible to thieves
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(b + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Owner only: pop the most recently pushed element
+    bool TryPop(T& out) {
+        const auto b = bottom_.load(std::memory_order_relaxed) - 1;
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto t = top_.load(std::memory_order_relaxed);
+
+        if (t > b) {
+            // Empty; restore bottom
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+        if (t == b) {
+            // Last element: race against thieves through top_
+            const bool won = top_.compare_exchange_strong(
+                t, t + 1
+                , std::memory_order_seq_cst
+                , std::memory_order_relaxed);
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            if (!won) {
+                return false;
+            }
+        }
+        Take(buffer_[static_cast<size_type>(b) & mask_], out);
+        return true;
+    }
+
+    // Any thread: steal the oldest element
+    bool TrySteal(T& out) {
+        auto t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const auto b = bottom_.load(std::memory_order_acquire);
+        if (t >= b) {
+            return false; // Empty
+        }
+        if (!top_.compare_exchange_strong(
+                t, t + 1
+                , std::memory_order_seq_cst
+                , std::memory_order_relaxed)) {
+            return false; // Lost the race against the owner or another thief
+        }
+        Take(buffer_[static_cast<size_type>(t) & mask_], out);
+        return true;
+    }
+
+    // Observation utilities; approximate under concurrency
+    size_type ApproxSize() const noexcept {
+        const auto b = bottom_.load(std::memory_order_relaxed);
+        const auto t = top_.load(std::memory_order_relaxed);
+        return b > t ? static_cast<size_type>(b - t) : 0;
+    }
+    size_type Capacity() const noexcept {
+        return capacity_;
+    }
+    bool Empty() const noexcept {
+        return ApproxSize() == 0;
+    }
+
+private:
+    using index_type = std::int64_t;
+
+    struct Cell {
+        std::atomic<bool> full_{false};
+        alignas(alignof(T)) unsigned char storage_[sizeof(T)];
+        Cell() noexcept : storage_{} {}
+    };
+
+    static size_type RoundUpToPow2(size_type n) {
+        if (n < 2) {return 2;}
+        n--;
+        for (size_type i = 1; i < sizeof(size_type) * 8; i <<= 1) {
+            n |= (n >> i);
+        }
+        n++;
+        return n;
+    }
+
+    // Move the claimed element out and hand the slot back to the owner
+    static void Take(Cell& cell, T& out) {
+        T* elem = std::launder(reinterpret_cast<T*>(cell.storage_));
+        out = std::move(*elem);
+        elem->~T();
+        cell.full_.store(false, std::memory_order_release);
+    }
+
+private:
+    const size_type capacity_;
+    const size_type mask_; // equals capacity_ - 1
+    std::vector<Cell> buffer_;
+
+    alignas(64) std::atomic<index_type> top_{0};
+    alignas(64) std::atomic<index_type> bottom_{0};
+};
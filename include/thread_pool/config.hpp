@@ -41,16 +41,41 @@ private:
         std::optional<int>         load_check_interval_ms;  // load balancer sampling interval (ms)
         std::optional<int>         keep_alive_ms;           // idle thread keep-alive time (ms)
         std::optional<double>      scale_up_threshold;      // busy ratio upper bound; scale up when exceeded
-        std::optional<double>      scale_down_threshold;    // busy ratio lower bound; scale down when below
+        std::optional<double>      scale_down_threshold;    // deprecated, ignored (warns once); keep_alive_ms drives scale-down
         std::optional<std::size_t> pending_hi;              // pending threshold (upper)
-        std::optional<std::size_t> pending_low;             // pending threshold (lower)
+        std::optional<std::size_t> pending_low;             // deprecated, ignored (warns once); keep_alive_ms drives scale-down
         std::optional<std::size_t> debounce_hits;           // debounce hit count
         std::optional<std::size_t> cooldown_ms;             // cooldown after capacity change (ms)
         std::optional<std::string> queue_policy;            // backpressure policy
+        std::optional<std::string> scheduling_mode;         // task scheduling mode
+        std::optional<std::size_t> local_queue_cap;         // per-worker deque capacity
+        std::optional<std::string> idle_strategy;           // worker idle strategy
+        std::optional<std::size_t> idle_spin_max;           // adaptive spin budget upper bound
+        std::optional<std::size_t> idle_yield_count;        // yield rounds before parking
+        std::optional<std::size_t> max_spinning_workers;    // concurrent spinner cap
+        std::optional<std::size_t> priority_lane_cap;       // High/Low lane capacity
+        std::optional<std::size_t> priority_aging;          // aged pick interval
+        std::optional<std::size_t> timer_tick_us;           // timing wheel resolution (us)
+        std::optional<std::string> autoscale_mode;          // load balancer controller
+        std::optional<std::size_t> sojourn_target_us;       // Sojourn: target queue wait (us)
+        std::optional<double>      sojourn_kp;              // Sojourn: proportional gain
+        std::optional<double>      sojourn_ki;              // Sojourn: integral gain (per second)
+        std::optional<std::size_t> hill_climb_window_ms;    // HillClimb: measurement window per probe (ms)
+        std::optional<std::size_t> max_blocking_threads;    // compensating workers for BlockingRegion
+        std::optional<std::size_t> queue_block_timeout_ms;  // BlockFor: longest wait for queue space (ms)
+        std::optional<std::string> queue_backend;           // Normal-lane storage
+        std::optional<bool>        single_submitter;        // single-producer ring for the bound submitter
+        std::optional<std::size_t> queue_shards;            // Normal-lane ring count
+        std::optional<std::string> queue_routing;           // sharded: first shard a push tries
     };
     // Parsing layer
     static RawConfig ParseRaw(const nlohmann::json& jcfg);
     static QueueFullPolicy ParsePolicy(const std::string& policy);
+    static SchedulingMode ParseScheduling(const std::string& mode);
+    static IdleStrategy ParseIdleStrategy(const std::string& strategy);
+    static AutoscaleMode ParseAutoscaleMode(const std::string& mode);
+    static QueueBackend ParseQueueBackend(const std::string& backend);
+    static QueueRouting ParseQueueRouting(const std::string& routing);
 
     // Validation/Normalization layer
     static ThreadPoolConfig Normalize(const RawConfig& raw);
@@ -0,0 +1,308 @@
+#pragma once
+
+#include "thread_pool/thread_pool.hpp"
+
+#if !TP_COROUTINES
+#error "thread_pool/coroutine.hpp needs the THREADPOOL_ENABLE_COROUTINES CMake option (C++20)"
+#endif
+#if !defined(__cpp_impl_coroutine)
+#error "thread_pool/coroutine.hpp needs a compiler with C++20 coroutines"
+#endif
+
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// C++20 coroutines on the pool.
+//
+//   co_await pool.Schedule();         // continue on a worker
+//   int v = co_await Compute(x);      // coro::Task<int>: lazy, resumes the awaiter when done
+//   coro::Spawn(pool, Handler(req));  // fire-and-forget from plain code
+//   int r = coro::SyncWait(Compute(x));
+//
+// A resumption is a ResumeTask (one pointer) stored inline in the queue cell, so hopping onto
+// the pool allocates nothing. coro::Task<T> starts when awaited. If it finishes on the spot the
+// awaiter simply carries on; if it suspended (hopped to a worker) whichever side arrives second
+// resumes the awaiter. Either way a loop of awaits stays flat on the stack at any -O level,
+// which plain symmetric transfer only guarantees when the compiler emits the tail call.
+// coro::Task lives in its own namespace because thread_pool::Task is the queued task handle.
+namespace thread_pool::coro {
+
+// Awaitable returned by ThreadPool::Schedule(). If the pool rejects the resumption (not
+// running, or dropped by the Discard/BlockFor policy) the coroutine carries on inline and
+// co_await throws; under CallerRuns a full lane just lets it carry on inline; if a queued resumption is cancelled (force stop, Overwrite) it is resumed on the
+// cancelling thread (a worker when a timer firing overwrote it) and co_await throws, so a frame is never leaked.
+class ScheduleAwaitable {
+public:
+    ScheduleAwaitable(ThreadPool& pool, TaskPriority priority) noexcept : pool_(&pool), priority_(priority) {}
+
+    bool await_ready() const noexcept {
+        return false;
+    }
+    bool await_suspend(std::coroutine_handle<> handle) {
+        handle_ = handle;
+        // Once Dispatch succeeds a worker may already be running the coroutine: don't touch *this
+        thread_pool::Task caller_runs;
+        const bool queued = pool_->Dispatch(thread_pool::Task::Make<ResumeTask>(this), priority_, &caller_runs);
+        if (!queued && !caller_runs) {
+            error_ = std::make_exception_ptr(std::runtime_error("ThreadPool::Schedule: rejected"));
+        }
+        return queued;
+    }
+    void await_resume() const {
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+    }
+
+private:
+    struct ResumeTask final : TaskBase {
+        explicit ResumeTask(ScheduleAwaitable* awaitable) noexcept : awaitable_(awaitable) {}
+        void Execute() noexcept override {
+            awaitable_->handle_.resume();
+        }
+        void Cancel(std::exception_ptr eptr) noexcept override {
+            awaitable_->error_ = eptr ? std::move(eptr)
+                                      : std::make_exception_ptr(std::runtime_error("ThreadPool::Schedule: cancelled"));
+            awaitable_->handle_.resume();
+        }
+        ScheduleAwaitable* awaitable_;
+    };
+
+    ThreadPool*             pool_;
+    TaskPriority            priority_;
+    std::coroutine_handle<> handle_{};
+    std::exception_ptr      error_{};
+};
+
+template <typename T = void>
+class Task;
+
+namespace detail {
+
+struct PromiseBase {
+    std::coroutine_handle<> continuation{std::noop_coroutine()};
+    std::exception_ptr      error{};
+    // Set by whichever of awaiter (suspended) and task (finished) gets there first
+    std::atomic<bool>       handoff{false};
+
+    struct FinalAwaiter {
+        bool await_ready() const noexcept {
+            return false;
+        }
+        template <typename Promise>
+        void await_suspend(std::coroutine_handle<Promise> self) const noexcept {
+            auto& promise = self.promise();
+            if (promise.handoff.exchange(true, std::memory_order_acq_rel)) {
+                // The awaiter is already suspended; it may destroy this frame, so touch nothing after
+                promise.continuation.resume();
+            }
+        }
+        void await_resume() const noexcept {}
+    };
+
+    std::suspend_always initial_suspend() const noexcept {
+        return {};
+    }
+    FinalAwaiter final_suspend() const noexcept {
+        return {};
+    }
+    void unhandled_exception() noexcept {
+        error = std::current_exception();
+    }
+};
+
+template <typename T>
+struct Promise : PromiseBase {
+    std::optional<T> value;
+
+    Task<T> get_return_object() noexcept;
+    template <typename U>
+    void return_value(U&& v) {
+        value.emplace(std::forward<U>(v));
+    }
+    T Take() {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return std::move(*value);
+    }
+};
+
+template <>
+struct Promise<void> : PromiseBase {
+    Task<void> get_return_object() noexcept;
+    void return_void() const noexcept {}
+    void Take() const {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+};
+
+}
+
+// Lazily started coroutine result; move-only, awaited once
+template <typename T>
+class [[nodiscard]] Task {
+public:
+    using promise_type = detail::Promise<T>;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    Task() noexcept = default;
+    explicit Task(Handle handle) noexcept : handle_(handle) {}
+    Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            Reset();
+            handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    ~Task() {
+        Reset();
+    }
+
+    bool Valid() const noexcept {
+        return static_cast<bool>(handle_);
+    }
+
+    auto operator co_await() noexcept {
+        struct Awaiter {
+            Handle handle;
+            bool await_ready() const noexcept {
+                return !handle || handle.done();
+            }
+            bool await_suspend(std::coroutine_handle<> awaiter) noexcept {
+                handle.promise().continuation = awaiter;
+                handle.resume();
+                // Already finished on this thread: don't suspend, the task won't resume us
+                return !handle.promise().handoff.exchange(true, std::memory_order_acq_rel);
+            }
+            T await_resume() {
+                if (!handle) {
+                    throw std::logic_error("coro::Task: awaiting an empty task");
+                }
+                return handle.promise().Take();
+            }
+        };
+        return Awaiter{handle_};
+    }
+
+private:
+    void Reset() noexcept {
+        if (handle_) {
+            handle_.destroy();
+            handle_ = {};
+        }
+    }
+
+    Handle handle_{};
+};
+
+namespace detail {
+
+template <typename T>
+Task<T> Promise<T>::get_return_object() noexcept {
+    return Task<T>(std::coroutine_handle<Promise<T>>::from_promise(*this));
+}
+inline Task<void> Promise<void>::get_return_object() noexcept {
+    return Task<void>(std::coroutine_handle<Promise<void>>::from_promise(*this));
+}
+
+// Eagerly started, self-destroying coroutine used to bridge into plain code
+struct Detached {
+    struct promise_type {
+        Detached get_return_object() const noexcept {
+            return {};
+        }
+        std::suspend_never initial_suspend() const noexcept {
+            return {};
+        }
+        std::suspend_never final_suspend() const noexcept {
+            return {};
+        }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept {
+            std::terminate();  // callers catch everything themselves
+        }
+    };
+};
+
+template <typename T>
+struct SyncWaitState {
+    std::mutex                                                           mu;
+    std::condition_variable                                              cv;
+    bool                                                                 done{false};
+    std::optional<std::conditional_t<std::is_void_v<T>, char, T>>       value;
+    std::exception_ptr                                                   error;
+};
+
+template <typename T>
+Detached RunAndSignal(Task<T> task, SyncWaitState<T>* state) {
+    try {
+        if constexpr (std::is_void_v<T>) {
+            co_await task;
+        } else {
+            state->value.emplace(co_await task);
+        }
+    } catch (...) {
+        state->error = std::current_exception();
+    }
+    // Notify under the lock: the waiter cannot return (and destroy *state) before we let go
+    std::lock_guard<std::mutex> lk(state->mu);
+    state->done = true;
+    state->cv.notify_one();
+}
+
+inline Detached RunSpawned(ThreadPool& pool, Task<void> task, TaskPriority priority) {
+    try {
+        co_await pool.Schedule(priority);
+        co_await task;
+    } catch (const std::exception& ex) {
+        TP_LOG_ERROR("Spawned coroutine failed: {}", ex.what());
+    } catch (...) {
+        TP_LOG_ERROR("Spawned coroutine failed: unknown exception");
+    }
+}
+
+}
+
+// Run `task` to completion, blocking the calling thread (not for use on a pool worker
+// whose pool the task needs)
+template <typename T>
+T SyncWait(Task<T> task) {
+    detail::SyncWaitState<T> state;
+    detail::RunAndSignal(std::move(task), &state);
+    std::unique_lock<std::mutex> lk(state.mu);
+    state.cv.wait(lk, [&] { return state.done; });
+    if (state.error) {
+        std::rethrow_exception(state.error);
+    }
+    if constexpr (!std::is_void_v<T>) {
+        return std::move(*state.value);
+    }
+}
+
+// Start `task` on a worker and forget it; exceptions are logged
+inline void Spawn(ThreadPool& pool, Task<void> task, TaskPriority priority = TaskPriority::Normal) {
+    detail::RunSpawned(pool, std::move(task), priority);
+}
+
+}
+
+namespace thread_pool {
+
+inline coro::ScheduleAwaitable ThreadPool::Schedule(TaskPriority priority) noexcept {
+    return coro::ScheduleAwaitable(*this, priority);
+}
+
+}
@@ -0,0 +1,322 @@
+#pragma once
+
+#include "thread_pool/inline_function.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#if defined(__linux__)
+    #include <linux/futex.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+    #include <ctime>
+#endif
+
+namespace thread_pool {
+namespace detail {
+
+// Block while word == expected (spurious wake-ups allowed); timeout == zero means no timeout
+inline void FutexWait(std::atomic<std::uint32_t>& word, std::uint32_t expected,
+                      std::chrono::nanoseconds timeout = std::chrono::nanoseconds::zero()) noexcept {
+#if defined(__linux__)
+    static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t), "futex word must be 32-bit");
+    timespec ts{};
+    timespec* pts = nullptr;
+    if (timeout > std::chrono::nanoseconds::zero()) {
+        ts.tv_sec = static_cast<std::time_t>(timeout.count() / 1000000000);
+        ts.tv_nsec = static_cast<long>(timeout.count() % 1000000000);
+        pts = &ts;
+    }
+    ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAIT_PRIVATE, expected, pts, nullptr, 0);
+#else
+    // Portable fallback: short sleep, caller re-checks the word
+    (void)expected;
+    const auto nap = std::chrono::microseconds{50};
+    std::this_thread::sleep_for(timeout > std::chrono::nanoseconds::zero() && timeout < nap ? timeout : nap);
+    (void)word;
+#endif
+}
+
+inline void FutexWakeAll(std::atomic<std::uint32_t>& word) noexcept {
+#if defined(__linux__)
+    ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAKE_PRIVATE, INT32_MAX, nullptr, nullptr, 0);
+#else
+    (void)word;
+#endif
+}
+
+}
+
+// Shared state of a submitted task: the callable, its result and a single status word.
+// Allocated once per Submit and reference counted by the task and its Future.
+template <typename T>
+class FutureState {
+public:
+    using Func = InlineFunction<T()>;
+
+    explicit FutureState(Func f) noexcept : f_(std::move(f)) {}
+
+    FutureState(const FutureState&) = delete;
+    FutureState& operator=(const FutureState&) = delete;
+
+    // Producer side (task owner)
+    void Run() noexcept {
+        try {
+            if constexpr (std::is_void_v<T>) {
+                f_();
+                value_.emplace();
+            } else if constexpr (std::is_reference_v<T>) {
+                value_.emplace(std::addressof(f_()));
+            } else {
+                value_.emplace(f_());
+            }
+            f_ = nullptr; // Release captures before consumers wake up
+            Publish(kValue);
+        } catch (...) {
+            error_ = std::current_exception();
+            f_ = nullptr;
+            Publish(kError);
+        }
+    }
+
+    void Fail(std::exception_ptr eptr) noexcept {
+        error_ = std::move(eptr);
+        f_ = nullptr;
+        Publish(kError);
+    }
+
+    // Marks the future as handed out; throws on the second call
+    void Retrieve() {
+        if (status_.fetch_or(kRetrieved, std::memory_order_relaxed) & kRetrieved) {
+            throw std::future_error(std::future_errc::future_already_retrieved);
+        }
+        AddRef();
+    }
+
+    // Observers
+    bool Done() const noexcept {
+        return (status_.load(std::memory_order_acquire) & kDoneMask) != 0;
+    }
+    bool Succeeded() const noexcept {
+        return (status_.load(std::memory_order_acquire) & kValue) != 0;
+    }
+
+    void Wait() noexcept {
+        WaitUntil(std::chrono::steady_clock::time_point::max());
+    }
+    bool WaitUntil(std::chrono::steady_clock::time_point deadline) noexcept {
+        auto s = status_.load(std::memory_order_acquire);
+        while (!(s & kDoneMask)) {
+            if (!(s & kWaiters)) {
+                // Announce a waiter so the producer knows to issue a wake-up
+                if (!status_.compare_exchange_weak(s, s | kWaiters,
+                        std::memory_order_acq_rel, std::memory_order_acquire)) {
+                    continue;
+                }
+                s |= kWaiters;
+            }
+            std::chrono::nanoseconds timeout = std::chrono::nanoseconds::zero();
+            if (deadline != std::chrono::steady_clock::time_point::max()) {
+                const auto now = std::chrono::steady_clock::now();
+                if (now >= deadline) {
+                    return false;
+                }
+                timeout = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now);
+            }
+            detail::FutexWait(status_, s, timeout);
+            s = status_.load(std::memory_order_acquire);
+        }
+        return true;
+    }
+
+    // Consumer side; requires Done()
+    T Take() {
+        if (status_.load(std::memory_order_acquire) & kError) {
+            std::rethrow_exception(error_);
+        }
+        if constexpr (std::is_void_v<T>) {
+            return;
+        } else if constexpr (std::is_reference_v<T>) {
+            return static_cast<T>(**value_);
+        } else {
+            return std::move(*value_);
+        }
+    }
+
+    // Forward the result into a std::promise once ready; consumes the caller's reference
+    void BridgeTo(std::promise<T> promise) {
+        bridge_.emplace(std::move(promise));
+        const auto prev = status_.fetch_or(kBridge, std::memory_order_acq_rel);
+        if (prev & kDoneMask) {
+            Forward();
+        }
+    }
+
+    void AddRef() noexcept {
+        refs_.fetch_add(1, std::memory_order_relaxed);
+    }
+    void Release() noexcept {
+        if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete this;
+        }
+    }
+
+private:
+    // Status word bits
+    static constexpr std::uint32_t kValue     = 1u << 0;  // completed with a value
+    static constexpr std::uint32_t kError     = 1u << 1;  // completed with an exception
+    static constexpr std::uint32_t kWaiters   = 1u << 2;  // a consumer may be blocked on the futex
+    static constexpr std::uint32_t kBridge    = 1u << 3;  // result must be forwarded to bridge_
+    static constexpr std::uint32_t kRetrieved = 1u << 4;  // Future handed out
+    static constexpr std::uint32_t kDoneMask  = kValue | kError;
+
+    struct VoidValue {};
+    using Stored = std::conditional_t<std::is_void_v<T>, VoidValue,
+                   std::conditional_t<std::is_reference_v<T>, std::remove_reference_t<T>*, T>>;
+
+    ~FutureState() = default;
+
+    // Single atomic transition publishes the result
+    void Publish(std::uint32_t outcome) noexcept {
+        const auto prev = status_.fetch_or(outcome, std::memory_order_acq_rel);
+        if (prev & kWaiters) {
+            detail::FutexWakeAll(status_);
+        }
+        if (prev & kBridge) {
+            Forward();
+        }
+    }
+
+    void Forward() noexcept {
+        try {
+            if (status_.load(std::memory_order_acquire) & kError) {
+                bridge_->set_exception(error_);
+            } else if constexpr (std::is_void_v<T>) {
+                bridge_->set_value();
+            } else if constexpr (std::is_reference_v<T>) {
+                bridge_->set_value(**value_);
+            } else {
+                bridge_->set_value(std::move(*value_));
+            }
+        } catch (...) {}
+        bridge_.reset();
+        Release();
+    }
+
+private:
+    std::atomic<std::uint32_t> status_{0};
+    std::atomic<std::uint32_t> refs_{1};
+    Func f_;
+    std::optional<Stored> value_;
+    std::exception_ptr error_;
+    std::optional<std::promise<T>> bridge_;
+};
+
+// Move-only handle to the result of Submit.
+// Waiting parks on the state's status word (futex on Linux); Ready()/TryGet() never block.
+// Convert explicitly to std::future when an API requires one.
+template <typename T>
+class Future {
+public:
+    Future() noexcept = default;
+    explicit Future(FutureState<T>* state) noexcept : state_(state) {}  // adopts one reference
+    ~Future() {
+        if (state_) {
+            state_->Release();
+        }
+    }
+
+    Future(const Future&) = delete;
+    Future& operator=(const Future&) = delete;
+
+    Future(Future&& other) noexcept : state_(std::exchange(other.state_, nullptr)) {}
+    Future& operator=(Future&& other) noexcept {
+        if (this != &other) {
+            if (state_) {
+                state_->Release();
+            }
+            state_ = std::exchange(other.state_, nullptr);
+        }
+        return *this;
+    }
+
+    // Already-failed future (used for rejected submissions)
+    static Future FromException(std::exception_ptr eptr) {
+        auto* state = new FutureState<T>(typename FutureState<T>::Func{});
+        state->Fail(std::move(eptr));
+        return Future(state);
+    }
+
+    bool Valid() const noexcept {
+        return state_ != nullptr;
+    }
+    bool Ready() const noexcept {
+        return state_ && state_->Done();
+    }
+
+    void Wait() const {
+        CheckState();
+        state_->Wait();
+    }
+    template <typename Rep, typename Period>
+    bool WaitFor(const std::chrono::duration<Rep, Period>& timeout) const {
+        CheckState();
+        return state_->WaitUntil(std::chrono::steady_clock::now()
+            + std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeout));
+    }
+
+    // Blocks until ready, then returns the value or rethrows; the future becomes invalid
+    T Get() {
+        CheckState();
+        Future hold(std::move(*this));
+        hold.state_->Wait();
+        return hold.state_->Take();
+    }
+
+    // Non-blocking: false while pending, otherwise behaves like Get()
+    template <typename U = T, typename = std::enable_if_t<!std::is_void_v<U> && !std::is_reference_v<U>>>
+    bool TryGet(U& out) {
+        if (!Ready()) {
+            return false;
+        }
+        out = Get();
+        return true;
+    }
+    template <typename U = T, typename = std::enable_if_t<std::is_void_v<U>>>
+    bool TryGet() {
+        if (!Ready()) {
+            return false;
+        }
+        Get();
+        return true;
+    }
+
+    // Explicit conversion; the result is forwarded when the task completes
+    explicit operator std::future<T>() && {
+        CheckState();
+        std::promise<T> promise;
+        auto fut = promise.get_future();
+        std::exchange(state_, nullptr)->BridgeTo(std::move(promise));
+        return fut;
+    }
+
+private:
+    void CheckState() const {
+        if (!state_) {
+            throw std::future_error(std::future_errc::no_state);
+        }
+    }
+
+private:
+    FutureState<T>* state_{nullptr};
+};
+
+}
@@ -1,6 +1,12 @@
 #pragma once
 
+#include "thread_pool/inline_function.hpp"
+#include "thread_pool/future.hpp"
+#include "thread_pool/latency_histogram.hpp"
+
 #include <cstdint>
+#include <cstddef>
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <future>
@@ -8,6 +14,7 @@
 #include <chrono>
 #include <fmt/format.h>
 #include <string_view>
+#include <vector>
 
 
 namespace spdlog {
@@ -39,8 +46,44 @@ enum class QueueFullPolicy {
     Block,      // Block until space is available
     Discard,    // Drop the task
     Overwrite,  // Overwrite an existing (old) task
+    CallerRuns, // Run the task inline on the submitting thread
+    BlockFor,   // Block up to queue_block_timeout, then drop the task
+};
+
+enum class QueueBackend {
+    Bounded,    // Fixed ring of queue_cap cells
+    Segmented,  // Unbounded linked segments; memory follows the backlog, pushes never find it full
+};
+
+enum class QueueRouting {
+    Home,       // Sharded queue: push to the submitting thread's home shard first
+    TwoChoice,  // Sharded queue: push to the shorter of two random shards first
+};
+
+enum class SchedulingMode {
+    Shared,        // Every task goes through the single shared queue
+    WorkStealing,  // Per-worker deques; idle workers steal before falling back to the shared queue
+};
+
+enum class IdleStrategy {
+    Park,          // Block on the queue as soon as it runs dry
+    SpinThenPark,  // Spin with CPU pause, then yield, then block; spin budget adapts per worker
 };
 
+enum class AutoscaleMode {
+    Thresholds,  // Grow on pending_hi / scale_up_threshold, debounced, with a cooldown
+    Sojourn,     // PI controller steering the smoothed queue wait towards sojourn_target
+    HillClimb,   // Probe worker counts and keep the one with the best completion rate
+};
+
+enum class TaskPriority {
+    High = 0,  // Latency-critical work; served first
+    Normal,    // Default lane (the shared queue)
+    Low,       // Bulk/background work; served last, but never starved
+};
+
+constexpr std::size_t kPriorityLanes = 3;
+
 using LoggerPtr = std::shared_ptr<spdlog::logger>;
 
 struct ThreadPoolConfig {
@@ -48,14 +91,41 @@ struct ThreadPoolConfig {
     std::size_t               core_threads{4};                       // Core thread count
     std::size_t               max_threads{8};                        // Maximum thread count
     std::chrono::milliseconds load_check_interval{100};              // Load balancer sampling interval
-    std::chrono::milliseconds keep_alive{5000};                      // Idle thread keep-alive time
+    std::chrono::milliseconds keep_alive{5000};                      // Workers above core_threads retire after idling this long
     double                    scale_up_threshold{0.75};              // Busy ratio upper bound; scale up when exceeded
-    double                    scale_down_threshold{0.25};            // Busy ratio lower bound; scale down when below
+    double                    scale_down_threshold{0.25};            // Deprecated, ignored: scale-down is driven by keep_alive
     std::size_t               pending_hi{64};                        // Pending (queue length) upper threshold
-    std::size_t               pending_low{8};                        // Pending lower threshold
+    std::size_t               pending_low{8};                        // Deprecated, ignored: scale-down is driven by keep_alive
     std::size_t               debounce_hits{3};                      // Debounce hit count
     std::chrono::milliseconds cooldown{500};                         // Cooldown after capacity change
     QueueFullPolicy           queue_policy{QueueFullPolicy::Block};  // Backpressure policy
+    QueueBackend              queue_backend{QueueBackend::Bounded};  // Normal-lane storage (Segmented: queue_cap only scales ratios)
+    bool                      single_submitter{false};               // Bounded only: Start()'s caller (or BindSubmitter's) gets a single-producer ring
+    std::size_t               queue_shards{1};                       // Bounded only: split the Normal lane into this many rings (> 1 overrides single_submitter)
+    QueueRouting              queue_routing{QueueRouting::Home};     // Sharded: first shard a push tries
+    SchedulingMode            scheduling{SchedulingMode::Shared};    // Task scheduling mode
+    std::size_t               local_queue_cap{256};                  // Per-worker deque capacity (WorkStealing only)
+    IdleStrategy              idle_strategy{IdleStrategy::Park};     // Worker behaviour when the queue runs dry
+    std::size_t               idle_spin_max{4096};                   // Upper bound of the adaptive pause-spin budget
+    std::size_t               idle_yield_count{4};                   // yield() rounds between spinning and parking
+    std::size_t               max_spinning_workers{2};               // Workers allowed to spin at the same time
+    std::size_t               priority_lane_cap{1024};               // Capacity of the High and Low lanes each
+    std::size_t               priority_aging{8};                     // Every Nth pick favours a lower lane (0 = strict priority)
+    std::chrono::microseconds timer_tick{1000};                      // Timing wheel resolution for ScheduleAfter/At/AtFixedRate
+    AutoscaleMode             autoscale_mode{AutoscaleMode::Thresholds};  // Load balancer controller
+    std::chrono::microseconds sojourn_target{2000};                  // Sojourn: queue wait to steer towards
+    double                    sojourn_kp{0.5};                       // Sojourn: proportional gain (share of max-core per unit relative error)
+    double                    sojourn_ki{1.0};                       // Sojourn: integral gain (same, per second)
+    std::chrono::milliseconds hill_climb_window{500};                // HillClimb: throughput measurement window per probe
+    std::size_t               max_blocking_threads{16};              // Compensating workers BlockingRegion may add on top
+    std::chrono::milliseconds queue_block_timeout{100};              // BlockFor: longest a submitter waits for queue space
+};
+
+// One HillClimb measurement window
+struct TunerSample {
+    std::size_t threads{0};        // worker count the window ran with
+    double      throughput{0.0};   // completed tasks per second
+    bool        saturated{false};  // tasks were queued for most of the window, otherwise demand-limited
 };
 
 struct Statistics {
@@ -69,6 +139,10 @@ struct Statistics {
     std::chrono::nanoseconds statistic_avg_exec_time{0};    // Average execution time
 
     std::size_t statistic_pending_tasks{0};    // Tasks currently pending in queue
+    std::size_t statistic_pending_high{0};     // Pending in the High lane
+    std::size_t statistic_pending_normal{0};   // Pending in the Normal lane (shared queue + worker deques)
+    std::size_t statistic_pending_low{0};      // Pending in the Low lane
+    std::size_t statistic_queue_bytes{0};      // Memory held by the Normal lane's storage
     double      statistic_busy_ratio{0.0};     // Busy thread ratio
     double      statistic_pending_ratio{0.0};  // Queue utilization ratio
 
@@ -80,7 +154,23 @@ struct Statistics {
 
     std::size_t statistic_discard_cnt{0};    // Discarded task count
     std::size_t statistic_overwrite_cnt{0};  // Overwritten task count
+    std::size_t statistic_caller_runs{0};    // Tasks run inline by the submitter (CallerRuns; not in submitted/completed)
     std::size_t statistic_paused_wait_cnt{0};     // Wait-for-task count
+    std::size_t statistic_steal_cnt{0};      // Tasks stolen from another worker's deque
+    std::size_t statistic_spin_hits{0};      // Tasks picked up while spinning/yielding instead of parking
+    std::size_t statistic_park_cnt{0};       // Times an idle worker blocked on the queue
+    std::size_t statistic_buffered_tasks{0}; // Tasks waiting in SubmitBuffers (not yet submitted or pending)
+    std::size_t statistic_buffer_flushes{0}; // SubmitBuffer batches handed to the queue
+    std::size_t statistic_blocked_workers{0};         // Workers currently inside a BlockingRegion
+    std::size_t statistic_blocking_compensations{0};  // Compensating workers started for BlockingRegions
+
+    std::chrono::nanoseconds statistic_queue_wait_ewma{0};  // Smoothed queue wait as sampled by the load balancer
+
+    std::size_t              statistic_tuned_threads{0};  // HillClimb: worker count chosen for the current window (0 in other modes)
+    std::vector<TunerSample> statistic_tuner_samples;     // HillClimb: latest measurement windows, oldest first
+
+    std::size_t statistic_pending_timers{0};  // Scheduled timers not yet due (periodic ones count once)
+    std::size_t statistic_timers_fired{0};    // Timer firings handed to the queue
 };
 class TaskBase {
 public:
@@ -92,160 +182,225 @@ public:
     virtual void Cancel(std::exception_ptr eptr) noexcept = 0;
 };
 
+// Callable stored by tasks; small callables live inline (see TP_TASK_INLINE_SIZE)
+template <typename Signature>
+using TaskFunction = InlineFunction<Signature>;
+
 // Task with return value
+// The callable and the result share one FutureState allocation with the returned Future.
 template <typename T>
 class FutureTask : public TaskBase  {
 public:
-    using Func = std::function<T()>;
-
-    explicit FutureTask(Func f) : f_(std::move(f)) {}
+    using Func = TaskFunction<T()>;
 
-    std::future<T> GetFuture() {
-        if (fut_taken_.exchange(true, std::memory_order_acq_rel)) {
-            throw std::runtime_error("Future already taken");
+    explicit FutureTask(Func f) : state_(new FutureState<T>(std::move(f))) {}
+    ~FutureTask() override {
+        if (!state_) {
+            return;
+        }
+        if (!state_->Done()) {
+            // Dropped without running: behave like a destroyed std::promise
+            state_->Fail(std::make_exception_ptr(std::future_error(std::future_errc::broken_promise)));
         }
-        return promise_.get_future();
+        state_->Release();
+    }
+
+    FutureTask(FutureTask&& other) noexcept : state_(std::exchange(other.state_, nullptr)) {}
+    FutureTask& operator=(FutureTask&&) = delete;
+
+    Future<T> GetFuture() {
+        state_->Retrieve();
+        return Future<T>(state_);
     }
 
     void Execute() noexcept override {
-        if (done_.load(std::memory_order_acquire)) {
+        if (state_->Done()) {
             return;
         }
-        try {
-            if constexpr (std::is_void_v<T>) {
-                // Guard
-                f_();
-                promise_.set_value();
-            } else {
-                T result = f_();
-                promise_.set_value(std::move(result));
-            }
-            ok_.store(true, std::memory_order_release);
-        } catch (...) {
-            try {
-                promise_.set_exception(std::current_exception());
-            } catch (...) {}
-            ok_.store(false, std::memory_order_release);
-        }
-        done_.store(true, std::memory_order_release);
+        state_->Run();
     }
 
     bool Success() const noexcept override {
-        return ok_.load(std::memory_order_acquire);
+        return state_->Succeeded();
     }
 
     void Cancel(std::exception_ptr eptr) noexcept override {
-        if (!done_.exchange(true, std::memory_order_acq_rel)) {
-            if (!eptr) {
-                eptr = std::make_exception_ptr(std::runtime_error("task cancelled"));
-            }
-            try {
-                promise_.set_exception(std::move(eptr));
-            } catch (...) {}
-            ok_.store(false, std::memory_order_release);
+        if (state_->Done()) {
+            return;
+        }
+        if (!eptr) {
+            eptr = std::make_exception_ptr(std::runtime_error("task cancelled"));
         }
+        state_->Fail(std::move(eptr));
     }
 private:
-    Func f_;
-    std::promise<T> promise_;
-    std::atomic<bool> ok_{false};
-    std::atomic<bool> fut_taken_{false};
-    std::atomic<bool> done_{false};
+    FutureState<T>* state_;
 };
 
-// Specialization for void (no return value)
-template <>
-class FutureTask<void> : public TaskBase  {
+// Lightweight task (no future overhead; used by Post)
+// Owned by one thread at a time (submitter, queue, worker), so its flags are plain bools.
+class SimpleTask : public TaskBase {
 public:
-    using Func = std::function<void()>;
-
-    explicit FutureTask(Func f) : f_(std::move(f)) {}
-
-    std::future<void> GetFuture() {
-        if (fut_taken_.exchange(true, std::memory_order_acq_rel)) {
-            throw std::runtime_error("Future already taken");
-        }
-        return promise_.get_future();
-    }
+    using Func = TaskFunction<void()>;
+    
+    explicit SimpleTask(Func f) : f_(std::move(f)) {}
 
     void Execute() noexcept override {
-        if (done_.load(std::memory_order_acquire)) {
+        if (done_) {
             return;
         }
         try {
             f_();
-            promise_.set_value();
-            ok_.store(true, std::memory_order_release);
+            ok_ = true;
         } catch (...) {
-            try {
-                promise_.set_exception(std::current_exception());
-            } catch (...) {}
-            ok_.store(false, std::memory_order_release);
+            ok_ = false;
         }
-        done_.store(true, std::memory_order_release);
+        done_ = true;
     }
 
     bool Success() const noexcept override {
-        return ok_.load(std::memory_order_acquire);
+        return ok_;
     }
 
-    void Cancel(std::exception_ptr eptr) noexcept override {
-        if (!done_.exchange(true, std::memory_order_acq_rel)) {
-            if (!eptr) {
-                eptr = std::make_exception_ptr(std::runtime_error("task cancelled"));
-            }
-            try {
-                promise_.set_exception(std::move(eptr));
-            } catch (...) {}
-            ok_.store(false, std::memory_order_release);
+    void Cancel(std::exception_ptr) noexcept override {
+        if (!done_) {
+            done_ = true;
+            ok_ = false;
         }
     }
+
 private:
     Func f_;
-    std::promise<void> promise_;
-    std::atomic<bool> ok_{false};
-    std::atomic<bool> fut_taken_{false};
-    std::atomic<bool> done_{false};
+    bool ok_{false};
+    bool done_{false};
 };
 
-// Lightweight task (no future overhead; used by Post)
-class SimpleTask : public TaskBase {
+// Owning task handle stored by value in queue cells.
+// Pool task types are constructed inside the handle; other TaskBase types larger than
+// kInlineSize (or not nothrow movable) fall back to the heap. Pointer-like interface.
+class Task {
 public:
-    using Func = std::function<void()>;
-    
-    explicit SimpleTask(Func f) : f_(std::move(f)) {}
+    static constexpr std::size_t kInlineSize = std::max(sizeof(SimpleTask), sizeof(FutureTask<void>));
 
-    void Execute() noexcept override {
-        if (done_.load(std::memory_order_acquire)) {
+    Task() noexcept = default;
+    Task(std::nullptr_t) noexcept {}
+    ~Task() {
+        reset();
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    Task(Task&& other) noexcept {
+        MoveFrom(other);
+    }
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            reset();
+            MoveFrom(other);
+        }
+        return *this;
+    }
+
+    template <typename U, typename... Args>
+    static Task Make(Args&&... args) {
+        static_assert(std::is_base_of_v<TaskBase, U>, "Task::Make requires a TaskBase-derived type");
+        Task task;
+        if constexpr (StoredInline<U>()) {
+            task.ptr_ = ::new (static_cast<void*>(task.storage_)) U(std::forward<Args>(args)...);
+            task.relocate_ = &Relocate<U>;
+        } else {
+            task.ptr_ = new U(std::forward<Args>(args)...);
+        }
+        return task;
+    }
+
+    template <typename U>
+    static constexpr bool StoredInline() noexcept {
+        return sizeof(U) <= kInlineSize
+            && alignof(U) <= alignof(std::max_align_t)
+            && std::is_nothrow_move_constructible_v<U>;
+    }
+
+    TaskBase* get() const noexcept {
+        return ptr_;
+    }
+    TaskBase* operator->() const noexcept {
+        return ptr_;
+    }
+    TaskBase& operator*() const noexcept {
+        return *ptr_;
+    }
+    explicit operator bool() const noexcept {
+        return ptr_ != nullptr;
+    }
+
+    void reset() noexcept {
+        if (!ptr_) {
             return;
         }
-        try {
-            f_();
-            ok_.store(true, std::memory_order_release);
-        } catch (...) {
-            ok_.store(false, std::memory_order_release);
+        if (relocate_) {
+            ptr_->~TaskBase();
+        } else {
+            delete ptr_;
         }
-        done_.store(true, std::memory_order_release);
+        ptr_ = nullptr;
+        relocate_ = nullptr;
     }
 
-    bool Success() const noexcept override {
-        return ok_.load(std::memory_order_acquire);
+#if TP_LATENCY_HISTOGRAMS
+    // Latency stamps (steady_clock ns): the submitting call, and the hand-off to a queue
+    void StampSubmitted(std::int64_t ns) noexcept {
+        submitted_ns_ = ns;
+        enqueued_ns_ = ns;
     }
+    void StampEnqueued(std::int64_t ns) noexcept {
+        enqueued_ns_ = ns;
+    }
+    std::int64_t SubmittedNs() const noexcept {
+        return submitted_ns_;
+    }
+    std::int64_t EnqueuedNs() const noexcept {
+        return enqueued_ns_;
+    }
+#endif
 
-    void Cancel(std::exception_ptr) noexcept override {
-        if (!done_.exchange(true, std::memory_order_acq_rel)) {
-            ok_.store(false, std::memory_order_release);
+private:
+    using RelocateFn = TaskBase* (*)(void* dst, TaskBase* src) noexcept;
+
+    template <typename U>
+    static TaskBase* Relocate(void* dst, TaskBase* src) noexcept {
+        U* from = static_cast<U*>(src);
+        U* to = ::new (dst) U(std::move(*from));
+        from->~U();
+        return to;
+    }
+
+    void MoveFrom(Task& other) noexcept {
+        if (other.relocate_) {
+            ptr_ = other.relocate_(storage_, other.ptr_);
+        } else {
+            ptr_ = other.ptr_;
         }
+        relocate_ = other.relocate_;
+        other.ptr_ = nullptr;
+        other.relocate_ = nullptr;
+#if TP_LATENCY_HISTOGRAMS
+        submitted_ns_ = other.submitted_ns_;
+        enqueued_ns_ = other.enqueued_ns_;
+#endif
     }
 
 private:
-    Func f_;
-    std::atomic<bool> ok_{false};
-    std::atomic<bool> done_{false};
+    alignas(std::max_align_t) unsigned char storage_[kInlineSize];
+    TaskBase*  ptr_{nullptr};
+    RelocateFn relocate_{nullptr};  // set only for inline tasks
+#if TP_LATENCY_HISTOGRAMS
+    std::int64_t submitted_ns_{0};
+    std::int64_t enqueued_ns_{0};
+#endif
 };
 
-using TaskPtr = std::unique_ptr<TaskBase>;
-
 class ThreadPool;
 }
 
@@ -300,6 +455,12 @@ struct formatter<thread_pool::QueueFullPolicy> : formatter<std::string_view> {
             case P::Overwrite: 
                 name = "Overwrite"; 
                 break;
+            case P::CallerRuns:
+                name = "CallerRuns";
+                break;
+            case P::BlockFor:
+                name = "BlockFor";
+                break;
             default:           
                 name = "Unknown"; 
                 break;
@@ -308,6 +469,120 @@ struct formatter<thread_pool::QueueFullPolicy> : formatter<std::string_view> {
     }
 };
 
+// SchedulingMode formatter
+template <>
+struct formatter<thread_pool::SchedulingMode> : formatter<std::string_view> {
+    auto format(thread_pool::SchedulingMode m, format_context& ctx) const {
+        using M = thread_pool::SchedulingMode;
+        std::string_view name = "Unknown";
+        switch (m) {
+            case M::Shared:
+                name = "Shared";
+                break;
+            case M::WorkStealing:
+                name = "WorkStealing";
+                break;
+        }
+        return formatter<std::string_view>::format(name, ctx);
+    }
+};
+
+// QueueBackend formatter
+template <>
+struct formatter<thread_pool::QueueBackend> : formatter<std::string_view> {
+    auto format(thread_pool::QueueBackend b, format_context& ctx) const {
+        using B = thread_pool::QueueBackend;
+        std::string_view name = "Unknown";
+        switch (b) {
+            case B::Bounded:
+                name = "Bounded";
+                break;
+            case B::Segmented:
+                name = "Segmented";
+                break;
+        }
+        return formatter<std::string_view>::format(name, ctx);
+    }
+};
+
+// QueueRouting formatter
+template <>
+struct formatter<thread_pool::QueueRouting> : formatter<std::string_view> {
+    auto format(thread_pool::QueueRouting r, format_context& ctx) const {
+        using R = thread_pool::QueueRouting;
+        std::string_view name = "Unknown";
+        switch (r) {
+            case R::Home:
+                name = "Home";
+                break;
+            case R::TwoChoice:
+                name = "TwoChoice";
+                break;
+        }
+        return formatter<std::string_view>::format(name, ctx);
+    }
+};
+
+// IdleStrategy formatter
+template <>
+struct formatter<thread_pool::IdleStrategy> : formatter<std::string_view> {
+    auto format(thread_pool::IdleStrategy s, format_context& ctx) const {
+        using S = thread_pool::IdleStrategy;
+        std::string_view name = "Unknown";
+        switch (s) {
+            case S::Park:
+                name = "Park";
+                break;
+            case S::SpinThenPark:
+                name = "SpinThenPark";
+                break;
+        }
+        return formatter<std::string_view>::format(name, ctx);
+    }
+};
+
+// AutoscaleMode formatter
+template <>
+struct formatter<thread_pool::AutoscaleMode> : formatter<std::string_view> {
+    auto format(thread_pool::AutoscaleMode m, format_context& ctx) const {
+        using M = thread_pool::AutoscaleMode;
+        std::string_view name = "Unknown";
+        switch (m) {
+            case M::Thresholds:
+                name = "Thresholds";
+                break;
+            case M::Sojourn:
+                name = "Sojourn";
+                break;
+            case M::HillClimb:
+                name = "HillClimb";
+                break;
+        }
+        return formatter<std::string_view>::format(name, ctx);
+    }
+};
+
+// TaskPriority formatter
+template <>
+struct formatter<thread_pool::TaskPriority> : formatter<std::string_view> {
+    auto format(thread_pool::TaskPriority p, format_context& ctx) const {
+        using P = thread_pool::TaskPriority;
+        std::string_view name = "Unknown";
+        switch (p) {
+            case P::High:
+                name = "High";
+                break;
+            case P::Normal:
+                name = "Normal";
+                break;
+            case P::Low:
+                name = "Low";
+                break;
+        }
+        return formatter<std::string_view>::format(name, ctx);
+    }
+};
+
 // StopMode formatter
 template <>
 struct formatter<thread_pool::StopMode> : formatter<std::string_view> {
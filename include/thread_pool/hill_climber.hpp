@@ -0,0 +1,108 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+namespace thread_pool {
+
+// Throughput hill climbing over the worker count (after the .NET thread injector), used by
+// AutoscaleMode::HillClimb. Each window the caller reports the completion rate it measured
+// while running Current() workers; the climber compares it with the last accepted count and
+//   - keeps going (doubling the step) if throughput rose by more than kNoise, or held steady
+//     with fewer workers,
+//   - otherwise returns to the accepted count and next probes the other side.
+// Rejected on both sides in a row means it sits on a peak: it holds there for kHoldWindows
+// windows before probing again, so a changing workload is still followed. Windows without a
+// backlog only measure the arrival rate and are ignored; when the process already burns its
+// CPU quota it does not probe upwards.
+// Not thread-safe: the load balancer thread owns it.
+class HillClimber {
+public:
+    static constexpr double      kNoise = 0.05;     // relative change below which throughput counts as flat
+    static constexpr std::size_t kHoldWindows = 8;  // windows spent on a peak before probing again
+
+    HillClimber(std::size_t start, std::size_t lo, std::size_t hi) noexcept
+        : lo_(std::max<std::size_t>(1, lo)), hi_(std::max(lo_, hi)), current_(std::clamp(start, lo_, hi_)) {}
+
+    // Worker count to run during the next window
+    std::size_t Current() const noexcept {
+        return current_;
+    }
+
+    // Feed one window: `throughput` completions/s with Current() workers, `saturated` if tasks
+    // were queued for most of it, `cpu_bound` if the process used up its CPU quota.
+    // Returns the count for the next window
+    std::size_t Update(double throughput, bool saturated, bool cpu_bound) noexcept {
+        if (!saturated) {
+            has_base_ = false;
+            reversals_ = 0;
+            return current_;
+        }
+        if (hold_ != 0) {
+            --hold_;
+            return current_;
+        }
+        if (!has_base_) {
+            SetBase(throughput);
+            return Move(cpu_bound);
+        }
+        const double gain = (throughput - base_throughput_) / std::max(base_throughput_, 1e-9);
+        if (gain > kNoise || (gain >= -kNoise && current_ < base_)) {
+            SetBase(throughput);
+            step_ *= 2;
+            reversals_ = 0;
+            return Move(cpu_bound);
+        }
+        // Worse, or no better for more workers: back to the accepted count, other direction
+        current_ = base_;
+        direction_ = -direction_;
+        step_ = 1;
+        has_base_ = false;  // re-measure it, the load may have moved meanwhile
+        if (++reversals_ >= 2) {
+            reversals_ = 0;
+            hold_ = kHoldWindows;
+        }
+        return current_;
+    }
+
+private:
+    void SetBase(double throughput) noexcept {
+        base_ = current_;
+        base_throughput_ = throughput;
+        has_base_ = true;
+    }
+
+    std::size_t Move(bool cpu_bound) noexcept {
+        if (cpu_bound && direction_ > 0) {
+            direction_ = -1;
+            step_ = 1;
+        }
+        for (int attempt = 0; attempt < 2; ++attempt) {
+            const std::size_t next = direction_ > 0 ? std::min(hi_, current_ + step_)
+                                                    : (current_ > lo_ + step_ ? current_ - step_ : lo_);
+            if (next != current_) {
+                current_ = next;
+                return current_;
+            }
+            if (cpu_bound) {
+                break;  // at the floor and no CPU to spare above it
+            }
+            direction_ = -direction_;  // at a bound: probe the other way
+            step_ = 1;
+        }
+        return current_;
+    }
+
+    std::size_t lo_;
+    std::size_t hi_;
+    std::size_t current_;
+    std::size_t base_{0};             // last accepted count
+    double      base_throughput_{0.0};
+    bool        has_base_{false};
+    int         direction_{1};
+    std::size_t step_{1};
+    std::size_t reversals_{0};        // rejected probes in a row
+    std::size_t hold_{0};
+};
+
+}
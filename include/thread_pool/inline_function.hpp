@@ -0,0 +1,154 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Inline buffer size (bytes) for task callables; override at build time, e.g. -DTP_TASK_INLINE_SIZE=128
+#ifndef TP_TASK_INLINE_SIZE
+#define TP_TASK_INLINE_SIZE 64
+#endif
+
+namespace thread_pool {
+
+template <typename Signature, std::size_t Capacity = TP_TASK_INLINE_SIZE>
+class InlineFunction;
+
+// Move-only type-erased callable with small-buffer storage.
+// Callables that fit in Capacity bytes (and are nothrow movable) are stored in place;
+// larger ones fall back to a single heap allocation.
+template <typename R, typename... Args, std::size_t Capacity>
+class InlineFunction<R(Args...), Capacity> {
+    static_assert(Capacity >= sizeof(void*), "InlineFunction capacity must hold at least a pointer");
+
+public:
+    InlineFunction() noexcept = default;
+    InlineFunction(std::nullptr_t) noexcept {}
+
+    template <typename F, typename Fn = std::decay_t<F>,
+              typename = std::enable_if_t<!std::is_same_v<Fn, InlineFunction>
+                                          && std::is_invocable_r_v<R, Fn&, Args...>>>
+    InlineFunction(F&& f) {
+        if constexpr (StoredInline<Fn>()) {
+            ::new (static_cast<void*>(storage_)) Fn(std::forward<F>(f));
+            ops_ = &kInlineOps<Fn>;
+        } else {
+            *reinterpret_cast<Fn**>(storage_) = new Fn(std::forward<F>(f));
+            ops_ = &kHeapOps<Fn>;
+        }
+    }
+
+    ~InlineFunction() {
+        Reset();
+    }
+
+    InlineFunction(const InlineFunction&) = delete;
+    InlineFunction& operator=(const InlineFunction&) = delete;
+
+    InlineFunction(InlineFunction&& other) noexcept {
+        MoveFrom(other);
+    }
+    InlineFunction& operator=(InlineFunction&& other) noexcept {
+        if (this != &other) {
+            Reset();
+            MoveFrom(other);
+        }
+        return *this;
+    }
+    InlineFunction& operator=(std::nullptr_t) noexcept {
+        Reset();
+        return *this;
+    }
+
+    R operator()(Args... args) {
+        return ops_->invoke(storage_, std::forward<Args>(args)...);
+    }
+
+    explicit operator bool() const noexcept {
+        return ops_ != nullptr;
+    }
+
+    // True when a callable of type F would be stored without a heap allocation
+    template <typename F>
+    static constexpr bool StoredInline() noexcept {
+        return sizeof(F) <= Capacity
+            && alignof(F) <= alignof(std::max_align_t)
+            && std::is_nothrow_move_constructible_v<F>;
+    }
+
+    static constexpr std::size_t InlineCapacity() noexcept {
+        return Capacity;
+    }
+
+private:
+    struct Ops {
+        R    (*invoke)(void* storage, Args&&... args);
+        void (*relocate)(void* dst, void* src) noexcept;  // move-construct into dst, destroy src
+        void (*destroy)(void* storage) noexcept;
+    };
+
+    template <typename Fn>
+    static R InvokeInline(void* storage, Args&&... args) {
+        Fn& fn = *std::launder(reinterpret_cast<Fn*>(storage));
+        if constexpr (std::is_void_v<R>) {
+            std::invoke(fn, std::forward<Args>(args)...);
+        } else {
+            return std::invoke(fn, std::forward<Args>(args)...);
+        }
+    }
+    template <typename Fn>
+    static void RelocateInline(void* dst, void* src) noexcept {
+        Fn* from = std::launder(reinterpret_cast<Fn*>(src));
+        ::new (dst) Fn(std::move(*from));
+        from->~Fn();
+    }
+    template <typename Fn>
+    static void DestroyInline(void* storage) noexcept {
+        std::launder(reinterpret_cast<Fn*>(storage))->~Fn();
+    }
+
+    template <typename Fn>
+    static R InvokeHeap(void* storage, Args&&... args) {
+        Fn& fn = **reinterpret_cast<Fn**>(storage);
+        if constexpr (std::is_void_v<R>) {
+            std::invoke(fn, std::forward<Args>(args)...);
+        } else {
+            return std::invoke(fn, std::forward<Args>(args)...);
+        }
+    }
+    static void RelocateHeap(void* dst, void* src) noexcept {
+        *reinterpret_cast<void**>(dst) = *reinterpret_cast<void**>(src);
+    }
+    template <typename Fn>
+    static void DestroyHeap(void* storage) noexcept {
+        delete *reinterpret_cast<Fn**>(storage);
+    }
+
+    template <typename Fn>
+    static constexpr Ops kInlineOps{&InvokeInline<Fn>, &RelocateInline<Fn>, &DestroyInline<Fn>};
+    template <typename Fn>
+    static constexpr Ops kHeapOps{&InvokeHeap<Fn>, &RelocateHeap, &DestroyHeap<Fn>};
+
+    void MoveFrom(InlineFunction& other) noexcept {
+        if (other.ops_) {
+            other.ops_->relocate(storage_, other.storage_);
+            ops_ = other.ops_;
+            other.ops_ = nullptr;
+        }
+    }
+
+    void Reset() noexcept {
+        if (ops_) {
+            ops_->destroy(storage_);
+            ops_ = nullptr;
+        }
+    }
+
+private:
+    alignas(std::max_align_t) unsigned char storage_[Capacity];
+    const Ops* ops_{nullptr};
+};
+
+}
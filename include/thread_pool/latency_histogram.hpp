@@ -0,0 +1,156 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+// Per-task latency histograms; build with -DTP_LATENCY_HISTOGRAMS=0 to drop the enqueue
+// stamps and per-worker recording entirely (GetLatencyHistograms() then returns empty histograms)
+#ifndef TP_LATENCY_HISTOGRAMS
+#define TP_LATENCY_HISTOGRAMS 1
+#endif
+
+namespace thread_pool {
+
+// Timestamp source for the latency stamps (steady_clock, ns since its epoch)
+inline std::int64_t LatencyClockNs() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Log-linear (HDR-style) histogram of nanosecond values.
+// Values below 2^kSubBits get one bucket each; every further power of two is split into
+// 2^kSubBits equal buckets, so a bucket is never wider than 1/16 of the values it holds.
+// Values at or above 2^kMaxBits ns (~18 minutes) land in the last bucket.
+class LatencyHistogram {
+public:
+    static constexpr unsigned    kSubBits = 4;
+    static constexpr unsigned    kMaxBits = 40;
+    static constexpr std::size_t kSubBuckets = std::size_t{1} << kSubBits;
+    static constexpr std::size_t kBuckets = kSubBuckets * (kMaxBits - kSubBits + 1);
+
+    static std::size_t BucketIndex(std::uint64_t ns) noexcept {
+        if (ns < kSubBuckets) {
+            return static_cast<std::size_t>(ns);
+        }
+        if (ns >= (std::uint64_t{1} << kMaxBits)) {
+            return kBuckets - 1;
+        }
+        const unsigned shift = HighestBit(ns) - kSubBits;
+        const auto sub = static_cast<std::size_t>(ns >> shift) - kSubBuckets;
+        return kSubBuckets + shift * kSubBuckets + sub;
+    }
+    // Largest value that maps to bucket i
+    static std::uint64_t BucketUpperBound(std::size_t i) noexcept {
+        if (i < kSubBuckets) {
+            return i;
+        }
+        const auto shift = static_cast<unsigned>((i - kSubBuckets) / kSubBuckets);
+        const auto sub = static_cast<std::uint64_t>((i - kSubBuckets) % kSubBuckets);
+        return ((kSubBuckets + sub + 1) << shift) - 1;
+    }
+
+    void Record(std::uint64_t ns) noexcept {
+        ++counts_[BucketIndex(ns)];
+    }
+    void AddToBucket(std::size_t i, std::uint64_t n) noexcept {
+        counts_[i] += n;
+    }
+    void Merge(const LatencyHistogram& other) noexcept {
+        for (std::size_t i = 0; i < kBuckets; ++i) {
+            counts_[i] += other.counts_[i];
+        }
+    }
+    // Drop the samples in `base` (an earlier snapshot of the same monotonic counters)
+    void Subtract(const LatencyHistogram& base) noexcept {
+        for (std::size_t i = 0; i < kBuckets; ++i) {
+            counts_[i] -= base.counts_[i] < counts_[i] ? base.counts_[i] : counts_[i];
+        }
+    }
+    void Clear() noexcept {
+        counts_.fill(0);
+    }
+
+    std::uint64_t Count() const noexcept {
+        std::uint64_t n = 0;
+        for (auto c : counts_) {
+            n += c;
+        }
+        return n;
+    }
+    std::uint64_t BucketCount(std::size_t i) const noexcept {
+        return counts_[i];
+    }
+
+    // Upper bound of the bucket holding the q-th quantile (q in [0, 1]); 0 when empty
+    std::chrono::nanoseconds Percentile(double q) const noexcept {
+        const auto total = Count();
+        if (total == 0) {
+            return std::chrono::nanoseconds{0};
+        }
+        q = q < 0.0 ? 0.0 : (q > 1.0 ? 1.0 : q);
+        auto rank = static_cast<std::uint64_t>(q * static_cast<double>(total) + 0.5);
+        rank = rank == 0 ? 1 : (rank > total ? total : rank);
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < kBuckets; ++i) {
+            seen += counts_[i];
+            if (seen >= rank) {
+                return std::chrono::nanoseconds(static_cast<std::int64_t>(BucketUpperBound(i)));
+            }
+        }
+        return Max();
+    }
+    std::chrono::nanoseconds Max() const noexcept {
+        for (std::size_t i = kBuckets; i-- > 0;) {
+            if (counts_[i] != 0) {
+                return std::chrono::nanoseconds(static_cast<std::int64_t>(BucketUpperBound(i)));
+            }
+        }
+        return std::chrono::nanoseconds{0};
+    }
+
+private:
+    static unsigned HighestBit(std::uint64_t v) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63u - static_cast<unsigned>(__builtin_clzll(v));
+#else
+        unsigned bit = 0;
+        while (v >>= 1) {
+            ++bit;
+        }
+        return bit;
+#endif
+    }
+
+    std::array<std::uint64_t, kBuckets> counts_{};
+};
+
+// Single-writer recorder: only the owning worker records, so a bucket update is a relaxed
+// load+store on memory it owns; readers copy the buckets out at any time. Counters only grow,
+// so a snapshot may miss in-flight samples but never reports a torn bucket.
+class LatencyRecorder {
+public:
+    void Record(std::uint64_t ns) noexcept {
+        auto& c = counts_[LatencyHistogram::BucketIndex(ns)];
+        c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+    void AddTo(LatencyHistogram& out) const noexcept {
+        for (std::size_t i = 0; i < LatencyHistogram::kBuckets; ++i) {
+            out.AddToBucket(i, counts_[i].load(std::memory_order_relaxed));
+        }
+    }
+
+private:
+    std::array<std::atomic<std::uint64_t>, LatencyHistogram::kBuckets> counts_{};
+};
+
+// Latency distributions across all workers, merged on read
+struct LatencyHistograms {
+    LatencyHistogram queue_wait;  // enqueue -> a worker starts the task
+    LatencyHistogram execution;   // task body run time
+    LatencyHistogram end_to_end;  // Submit/Post call -> task finished
+};
+
+}
@@ -0,0 +1,268 @@
+#pragma once
+
+#include "thread_pool/thread_pool.hpp"
+#include "mpmc/event_count.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Structured parallel loops on a ThreadPool: ParallelFor, ParallelReduce, ParallelInclusiveScan.
+//
+// The index range is cut into chunks of `grain` elements (0 = pick one from the worker count).
+// The calling thread splits the chunk range in halves, posts each right half as one task and
+// keeps the left half, down to a single chunk it runs itself. On the way back it claims every
+// half it posted that no worker has started and runs that inline too. Posted tasks split the
+// same way. Halves go out with TryPost, so a full queue never blocks the split. The caller
+// always does useful work, a half nobody picked up (or that did not fit in the queue) simply
+// runs on the caller, and the final wait is only ever for chunks already running on a
+// worker: calling these from inside a pool task cannot deadlock.
+// Completion is one latch per call, so a loop costs one shared-state allocation plus one
+// pooled task per split instead of a heap task and future per element.
+// The first exception thrown by a body is rethrown on the caller once every chunk has finished;
+// chunks that had not started by then are skipped.
+namespace thread_pool {
+namespace detail {
+
+// Counts down once per chunk; waiters park on an EventCount
+class CompletionLatch {
+public:
+    explicit CompletionLatch(std::size_t count) noexcept : count_(count) {}
+
+    void CountDown() noexcept {
+        if (count_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            done_.NotifyAll();
+        }
+    }
+    bool Done() const noexcept {
+        return count_.load(std::memory_order_acquire) == 0;
+    }
+    void Wait() noexcept {
+        while (!Done()) {
+            const auto key = done_.PrepareWait();
+            if (Done()) {
+                done_.CancelWait();
+                return;
+            }
+            done_.Wait(key);
+        }
+    }
+
+private:
+    std::atomic<std::size_t> count_;
+    EventCount               done_;
+};
+
+// Shared state of one parallel call. Tasks that lose the claim race only touch the flags, so
+// the chunk function (which lives on the caller's stack) is never used after the latch opens.
+template <typename ChunkFn>
+struct ForkJoinState {
+    ForkJoinState(ThreadPool& owner, std::size_t chunk_count, const ChunkFn& chunk_fn)
+        : pool(&owner)
+        , fn(&chunk_fn)
+        , chunks(chunk_count)
+        , claimed(new std::atomic<bool>[chunk_count])
+        , latch(chunk_count)
+    {
+        for (std::size_t i = 0; i < chunk_count; ++i) {
+            claimed[i].store(false, std::memory_order_relaxed);
+        }
+    }
+
+    ThreadPool*                          pool;
+    const ChunkFn*                       fn;
+    std::size_t                          chunks;
+    std::unique_ptr<std::atomic<bool>[]> claimed;  // [c]: the split whose right half starts at chunk c was taken
+    CompletionLatch                      latch;
+    std::atomic<bool>                    failed{false};
+    std::exception_ptr                   error;    // written once by the thread that set `failed`
+};
+
+template <typename ChunkFn>
+void RunChunks(const std::shared_ptr<ForkJoinState<ChunkFn>>& state, std::size_t first, std::size_t last) {
+    // Right halves posted at each split level; log2(chunks) deep at most
+    std::size_t posted[64];
+    std::size_t depth = 0;
+    while (last - first > 1) {
+        const std::size_t mid = first + (last - first) / 2;
+        // A half that cannot be posted (full queue) stays unclaimed and runs here on the way back
+        state->pool->TryPost([state, mid, last]() {
+            if (!state->claimed[mid].exchange(true, std::memory_order_acq_rel)) {
+                RunChunks(state, mid, last);
+            }
+        });
+        posted[depth++] = mid;
+        posted[depth++] = last;
+        last = mid;
+    }
+
+    if (!state->failed.load(std::memory_order_relaxed)) {
+        try {
+            (*state->fn)(first);
+        } catch (...) {
+            if (!state->failed.exchange(true, std::memory_order_acq_rel)) {
+                state->error = std::current_exception();
+            }
+        }
+    }
+    state->latch.CountDown();
+
+    // Innermost split first: its half is the smallest and the least likely to be taken yet
+    while (depth != 0) {
+        const std::size_t hi = posted[--depth];
+        const std::size_t lo = posted[--depth];
+        if (!state->claimed[lo].exchange(true, std::memory_order_acq_rel)) {
+            RunChunks(state, lo, hi);
+        }
+    }
+}
+
+// Default grain: about 8 chunks per thread (workers + caller) so splits can balance load
+template <typename Index>
+Index AutoGrain(const ThreadPool& pool, Index count) noexcept {
+    const auto threads = static_cast<Index>(pool.CurrentThreads() + 1);
+    const Index chunks = threads * 8;
+    return std::max<Index>(1, (count + chunks - 1) / chunks);
+}
+
+// Run chunk_fn(c) for every c in [0, chunks) on the pool and the calling thread
+template <typename ChunkFn>
+void ForkJoin(ThreadPool& pool, std::size_t chunks, const ChunkFn& chunk_fn) {
+    if (chunks == 0) {
+        return;
+    }
+    if (chunks == 1 || !pool.Running()) {
+        // Nothing to split, or no workers to hand halves to (stopped/paused): run on the caller
+        for (std::size_t c = 0; c < chunks; ++c) {
+            chunk_fn(c);
+        }
+        return;
+    }
+    auto state = std::make_shared<ForkJoinState<ChunkFn>>(pool, chunks, chunk_fn);
+    RunChunks(state, 0, chunks);
+    state->latch.Wait();
+    if (state->failed.load(std::memory_order_acquire)) {
+        std::rethrow_exception(state->error);
+    }
+}
+
+}
+
+// body(i) for every i in [first, last)
+template <typename Index, typename Body>
+void ParallelFor(ThreadPool& pool, Index first, Index last, Index grain, Body&& body) {
+    static_assert(std::is_integral_v<Index>, "ParallelFor: Index must be an integral type");
+    if (!(first < last)) {
+        return;
+    }
+    const Index count = last - first;
+    if (!(grain > 0)) {
+        grain = detail::AutoGrain(pool, count);
+    }
+    const auto chunks = static_cast<std::size_t>((count + grain - 1) / grain);
+    detail::ForkJoin(pool, chunks, [&](std::size_t c) {
+        const Index lo = first + static_cast<Index>(c) * grain;
+        const Index hi = (last - lo) > grain ? lo + grain : last;
+        for (Index i = lo; i < hi; ++i) {
+            body(i);
+        }
+    });
+}
+
+template <typename Index, typename Body>
+void ParallelFor(ThreadPool& pool, Index first, Index last, Body&& body) {
+    ParallelFor(pool, first, last, Index{0}, std::forward<Body>(body));
+}
+
+// Folds [first, last): each chunk computes body(lo, hi, identity) -> T, then the chunk results
+// are combined left to right on the caller, so `combine` only has to be associative
+template <typename Index, typename T, typename Body, typename Combine>
+T ParallelReduce(ThreadPool& pool, Index first, Index last, Index grain, T identity, Body&& body, Combine&& combine) {
+    static_assert(std::is_integral_v<Index>, "ParallelReduce: Index must be an integral type");
+    if (!(first < last)) {
+        return identity;
+    }
+    const Index count = last - first;
+    if (!(grain > 0)) {
+        grain = detail::AutoGrain(pool, count);
+    }
+    const auto chunks = static_cast<std::size_t>((count + grain - 1) / grain);
+    std::vector<std::optional<T>> partial(chunks);
+    detail::ForkJoin(pool, chunks, [&](std::size_t c) {
+        const Index lo = first + static_cast<Index>(c) * grain;
+        const Index hi = (last - lo) > grain ? lo + grain : last;
+        partial[c].emplace(body(lo, hi, identity));
+    });
+    T result = std::move(identity);
+    for (auto& p : partial) {
+        result = combine(std::move(result), std::move(*p));
+    }
+    return result;
+}
+
+// out[i] = in[0] op in[1] op ... op in[i], for random-access iterators. Two passes over the
+// input: chunk totals in parallel, a serial prefix over the totals, then each chunk scans
+// with its carry-in in parallel. `op` has to be associative.
+template <typename InputIt, typename OutputIt, typename BinaryOp>
+OutputIt ParallelInclusiveScan(ThreadPool& pool, InputIt first, InputIt last, OutputIt out, BinaryOp op,
+                               std::ptrdiff_t grain = 0) {
+    using T = typename std::iterator_traits<InputIt>::value_type;
+    const std::ptrdiff_t count = std::distance(first, last);
+    if (count <= 0) {
+        return out;
+    }
+    if (!(grain > 0)) {
+        grain = detail::AutoGrain(pool, count);
+    }
+    const auto chunks = static_cast<std::size_t>((count + grain - 1) / grain);
+    auto bounds = [&](std::size_t c) {
+        const std::ptrdiff_t lo = static_cast<std::ptrdiff_t>(c) * grain;
+        return std::make_pair(lo, std::min(count, lo + grain));
+    };
+
+    // Pass 1: totals of every chunk but the last
+    std::vector<std::optional<T>> carry(chunks);
+    detail::ForkJoin(pool, chunks - 1, [&](std::size_t c) {
+        const auto [lo, hi] = bounds(c);
+        auto it = first + lo;
+        T acc = *it;
+        for (++it; it != first + hi; ++it) {
+            acc = op(std::move(acc), *it);
+        }
+        carry[c + 1].emplace(std::move(acc));
+    });
+    // Exclusive prefix of the totals: carry[c] = everything before chunk c
+    for (std::size_t c = 2; c < chunks; ++c) {
+        T prefix = op(*carry[c - 1], std::move(*carry[c]));
+        carry[c] = std::move(prefix);
+    }
+
+    // Pass 2: scan each chunk from its carry-in
+    detail::ForkJoin(pool, chunks, [&](std::size_t c) {
+        const auto [lo, hi] = bounds(c);
+        auto src = first + lo;
+        auto dst = out + lo;
+        T acc = carry[c] ? op(*carry[c], *src) : T(*src);
+        *dst = acc;
+        for (++src, ++dst; src != first + hi; ++src, ++dst) {
+            acc = op(std::move(acc), *src);
+            *dst = acc;
+        }
+    });
+    return out + count;
+}
+
+template <typename InputIt, typename OutputIt>
+OutputIt ParallelInclusiveScan(ThreadPool& pool, InputIt first, InputIt last, OutputIt out) {
+    return ParallelInclusiveScan(pool, first, last, out, std::plus<>{});
+}
+
+}
@@ -2,7 +2,10 @@
 
 #include "thread_pool/fwd.hpp"
 #include "mpmc/blocking_queue_adapter.hpp"
+#include "mpmc/work_stealing_deque.hpp"
+#include "mpmc/event_count.hpp"
 #include "thread_pool/config.hpp"
+#include "thread_pool/timing_wheel.hpp"
 #include "logger.hpp"
 
 #include <thread>
@@ -14,10 +17,27 @@
 #include <future>
 #include <functional>
 #include <exception>
+#include <mutex>
+#include <condition_variable>
+#include <unordered_map>
+#include <utility>
+
+// C++20 coroutine support; set by the THREADPOOL_ENABLE_COROUTINES CMake option
+#ifndef TP_COROUTINES
+#define TP_COROUTINES 0
+#endif
 
 namespace thread_pool {
+#if TP_COROUTINES
+namespace coro {
+class ScheduleAwaitable;
+}
+#endif
+
 class ThreadPool {
 public:
+    using TimerId = std::uint64_t;  // 0 = not scheduled
+
     explicit ThreadPool(std::size_t threads_count, std::size_t queue_cap = 1024);
     explicit ThreadPool(const ThreadPoolConfig& cfg);
     ~ThreadPool();
@@ -29,20 +49,54 @@ public:
 
     void Start();
     void Stop(StopMode mode = StopMode::Graceful);
+    // single_submitter: Normal-lane pushes from the calling thread go to a single-producer ring
+    // (no CAS per push); every other thread, workers included, uses the shared ring. Start()
+    // binds its caller. Hand over only once the previous submitter has stopped submitting
+    void BindSubmitter() noexcept;
     void ShutDown(ShutDownOption opt = ShutDownOption::Graceful, 
         std::chrono::milliseconds timeout = std::chrono::seconds(30));
 
-    void Post(std::function<void()> f);
+    void Post(TaskFunction<void()> f);
+    void Post(TaskPriority priority, TaskFunction<void()> f);
+    // Never blocks and ignores the queue-full policy: false (task dropped, nothing counted) if
+    // the pool is not RUNNING or the lane is full
+    bool TryPost(TaskFunction<void()> f, TaskPriority priority = TaskPriority::Normal);
     template <typename Func, typename... Args>
-    auto Submit(Func&& f, Args&&... args) -> std::future<std::invoke_result_t<Func, Args...>>;
+    auto Submit(Func&& f, Args&&... args) -> Future<std::invoke_result_t<Func, Args...>>;
+    template <typename Func, typename... Args>
+    auto Submit(TaskPriority priority, Func&& f, Args&&... args) -> Future<std::invoke_result_t<Func, Args...>>;
 
-    // Batch submission APIs
+    // Batch submission APIs. Tasks that do not fit are handled by the queue-full policy only
+    // for CallerRuns (run inline) and BlockFor (one queue_block_timeout for the whole batch);
+    // otherwise they are dropped. Returns the tasks queued or run inline
     template <typename Iterator>
     std::size_t PostBatch(Iterator begin, Iterator end);
     
     template <typename Func>
     std::size_t PostBatch(Func generator, std::size_t count);
 
+    // Delayed and periodic tasks. A timing wheel on a dedicated timer thread (started on first
+    // use) pushes each due task to its lane without ever blocking or running it inline: under
+    // Block and CallerRuns a full lane keeps the firing for the next tick, BlockFor does so until
+    // queue_block_timeout, Discard drops it and Overwrite evicts. Deadlines round up to the next
+    // timer_tick, so a task never runs early. A fixed-rate task keeps its phase and has at most one
+    // firing out at a time: a period that comes due while the previous firing still waits for a
+    // lane, is queued or is running is skipped, so a slow body or a full lane never builds a backlog.
+    // Each returns 0 (and counts a rejection) unless the pool is RUNNING or PAUSED.
+    TimerId ScheduleAfter(std::chrono::steady_clock::duration delay, TaskFunction<void()> f,
+                          TaskPriority priority = TaskPriority::Normal);
+    TimerId ScheduleAt(std::chrono::steady_clock::time_point when, TaskFunction<void()> f,
+                       TaskPriority priority = TaskPriority::Normal);
+    TimerId ScheduleAtFixedRate(std::chrono::steady_clock::duration period, TaskFunction<void()> f,
+                                TaskPriority priority = TaskPriority::Normal);
+    bool CancelTimer(TimerId id);     // O(1); false if already fired, cancelled or unknown
+    std::size_t PendingTimers() const;
+
+#if TP_COROUTINES
+    // co_await pool.Schedule() resumes the awaiting coroutine on a worker (thread_pool/coroutine.hpp)
+    coro::ScheduleAwaitable Schedule(TaskPriority priority = TaskPriority::Normal) noexcept;
+#endif
+
     // Policy
     QueueFullPolicy GetQueueFullPolicy() const noexcept;
     void SetQueueFullPolicy(QueueFullPolicy policy) noexcept;
@@ -54,36 +108,137 @@ public:
     // State queries
     bool Running() const noexcept;
     std::size_t Pending() const noexcept;
+    std::size_t Pending(TaskPriority priority) const noexcept;  // one lane
     std::size_t ActiveTasks() const noexcept;
     PoolState State() const noexcept;
 
     std::size_t DiscardedTasks() const noexcept;
     std::size_t OverwrittedTasks() const noexcept;
     std::size_t PausedWait() const noexcept;
+    std::size_t StolenTasks() const noexcept;
+    SchedulingMode Scheduling() const noexcept;
 
     // Dynamic thread management
     void TriggerLoadCheck();  // Manually trigger load balancer
 
     std::size_t CurrentThreads() const noexcept;  // Current live worker threads
     std::size_t ActiveThreads() const noexcept;   // Active (busy) worker threads
-    
+
+    // Managed blocking. Wrap a call that blocks a worker (file I/O, a contended lock, a
+    // synchronous RPC) so the pool keeps its parallelism: if no other worker is idle, a
+    // compensating worker starts right away (up to max_blocking_threads extra). Once the
+    // region ends and the backlog is gone one worker retires again; a region entered before
+    // that reuses it. Off this pool's workers both are no-ops.
+    class BlockingRegion {
+    public:
+        explicit BlockingRegion(ThreadPool& pool) noexcept;
+        ~BlockingRegion();
+        BlockingRegion(const BlockingRegion&) = delete;
+        BlockingRegion& operator=(const BlockingRegion&) = delete;
+
+    private:
+        ThreadPool* pool_;  // null when not entered
+        bool        compensated_{false};
+    };
+    template <typename Func>
+    decltype(auto) RunBlocking(Func&& f) {
+        BlockingRegion region(*this);
+        return std::forward<Func>(f)();
+    }
+
+    // Submission buffering (producer token). Normal-priority Posts collect in the buffer and go
+    // to the queue as one batch push when `capacity` tasks are waiting, on Flush() and on
+    // destruction; each task that does not fit then gets Post's queue-full policy. Once the
+    // oldest has waited `linger` (0 = never), the timer thread, sweeping at the shortest linger
+    // in use, queues what fits without blocking and leaves the rest for its next sweep. Tasks
+    // count as submitted, and in Pending(), once flushed; Stop(Graceful) flushes every live
+    // buffer first, Stop(Force) rejects what they hold. Meant for one submitting thread, and
+    // must not outlive its pool
+    class SubmitBuffer {
+    public:
+        explicit SubmitBuffer(ThreadPool& pool, std::size_t capacity = 64,
+                              std::chrono::microseconds linger = std::chrono::milliseconds(1));
+        ~SubmitBuffer();
+        SubmitBuffer(const SubmitBuffer&) = delete;
+        SubmitBuffer& operator=(const SubmitBuffer&) = delete;
+
+        void Post(TaskFunction<void()> f);
+        std::size_t Flush();                // tasks queued or run inline
+        std::size_t Size() const noexcept;  // tasks waiting in the buffer
+
+    private:
+        friend class ThreadPool;
+        std::size_t FlushLocked();  // requires mu_
+
+        ThreadPool&                           pool_;
+        std::size_t                           capacity_;
+        std::chrono::microseconds             linger_;
+        std::mutex                            mu_;        // owner vs the linger sweep and Stop
+        std::vector<Task>                     tasks_;
+        std::chrono::steady_clock::time_point first_{};   // when the oldest buffered task arrived
+        std::atomic<std::size_t>              size_{0};   // tasks_.size() for lock-free readers
+    };
+
     // Statistics API
     Statistics GetStatistics() const noexcept;
     void ResetStatistics() noexcept;
+    LatencyHistograms GetLatencyHistograms() const;  // empty when built with TP_LATENCY_HISTOGRAMS=0
 private:
+#if TP_COROUTINES
+    friend class coro::ScheduleAwaitable;
+#endif
+
+    // Per-worker counters. Only the owning worker writes them, so updates are plain
+    // load+store on its own cache line; readers take a seqlock-consistent snapshot.
+    struct alignas(64) WorkerStats {
+        std::atomic<std::uint64_t> seq{0};           // odd while an update is in progress
+        std::atomic<std::size_t>   completed{0};     // tasks executed successfully
+        std::atomic<std::size_t>   failed{0};        // tasks failed during execution
+        std::atomic<std::size_t>   exec_time_ns{0};  // total execution time (ns)
+        std::atomic<std::size_t>   wait_time_ns{0};  // total queue wait of timed tasks (ns)
+        std::atomic<std::size_t>   waited{0};        // tasks whose queue wait was timed
+        std::atomic<std::size_t>   active{0};        // 1 while executing a task
+    };
+#if TP_LATENCY_HISTOGRAMS
+    // Per-worker latency histograms, written only by the owning worker
+    struct alignas(64) WorkerLatency {
+        LatencyRecorder queue_wait;
+        LatencyRecorder execution;
+        LatencyRecorder end_to_end;
+    };
+#endif
+    struct StatsTotals {
+        std::size_t completed{0};
+        std::size_t failed{0};
+        std::size_t exec_time_ns{0};
+        std::size_t wait_time_ns{0};
+        std::size_t waited{0};
+    };
+
     struct WorkerSlot {
         std::thread                           thread;              // worker object
-        std::atomic<bool>                     should_exit{false};  // shrink/shutdown indicator
+        bool                                  retired{false};      // claimed a keep-alive exit (owner thread only)
         std::atomic<bool>                     idle{true};          // worker idle state
         std::atomic<std::uint64_t>            idle_nums{0};        // consecutive idle count
         std::chrono::steady_clock::time_point last_active{};       // last time a task executed
-    };
-
-    struct ExitTask final : TaskBase {
-        explicit ExitTask(WorkerSlot* target) noexcept : slot(target) {}
-        void Execute() noexcept override {}
-        void Cancel(std::exception_ptr) noexcept override {}
-        WorkerSlot* slot{nullptr};
+        alignas(64) std::atomic<bool>         starting{false};     // between pause check and task start
+        WorkerStats                           stats;               // sharded statistics
+#if TP_LATENCY_HISTOGRAMS
+        WorkerLatency                         latency;             // sharded latency histograms
+#endif
+
+        // Work-stealing mode only
+        WorkStealingDeque<Task>* local_tasks{nullptr};          // owned deque (nullptr in Shared mode)
+        std::size_t                 index{0};                      // position in local_queues_
+        std::uint64_t               steal_seed{0};                 // xorshift state for victim selection
+        std::chrono::microseconds   steal_park{0};                 // current park interval on the shared queue
+
+        // SpinThenPark idle strategy only
+        std::size_t                 spin_budget{0};                // pause iterations before yielding
+        std::size_t                 spin_gap{0};                   // smoothed pause iterations until work arrived
+
+        // Priority lanes
+        std::size_t                 lane_picks{0};                 // tasks taken; drives the aged pick
     };
 
     class WorkerCounterHelper {
@@ -107,16 +262,102 @@ private:
     void WorkerLoop(WorkerSlot* slot);
     void SetState(PoolState new_state) noexcept;
 
+    // Pause gate
+    bool TryBeginTask(WorkerSlot& slot) noexcept;  // false if paused; otherwise the task may start
+    bool TryBeginInline() noexcept;                // CallerRuns counterpart; true: InlineStarted() or RunInCaller() next
+    void InlineStarted() noexcept;                 // the inline task counts as started
+    void ParkWhilePaused() noexcept;               // block on pause_gate_ until the pool leaves PAUSED
+
+    // Work-stealing helpers
+    bool TryPushLocal(Task& task) noexcept;                    // push to the calling worker's deque
+    bool TryTakeLocalOrSteal(WorkerSlot& slot, Task& task);    // own deque first, then random victims
+    void FlushLocalTasks(WorkerSlot& slot);                       // hand leftovers back on worker exit
+
+    // Priority lane helpers
+    BlockingQueueAdapter<Task>& Lane(TaskPriority priority) noexcept;
+    const BlockingQueueAdapter<Task>& Lane(TaskPriority priority) const noexcept;
+    bool TryTakeLane(WorkerSlot& slot, std::size_t lane, Task& task);  // Normal includes the worker deques
+    bool WaitTake(WorkerSlot& slot, Task& task);                       // park on lane_ready_ until any lane has work
+    bool WaitTakeFor(WorkerSlot& slot, Task& task, std::chrono::microseconds timeout);
+    std::size_t LaneCapacity() const noexcept;                         // all lanes together
+
+    // Idle strategy helpers
+    bool TryTakeNoWait(WorkerSlot& slot, Task& task);          // one non-blocking pass over every source
+    bool SpinForTask(WorkerSlot& slot, Task& task);            // pause-spin, then yield, before parking
+    bool SpinAllowed() const noexcept;                         // pool still hands out tasks
+
+    // Submission buffers
+    void ArmBufferSweep(std::chrono::microseconds linger);  // start or shorten the sweep timer
+    void SweepSubmitBuffers();                              // timer thread: queue what fits from buffers whose linger ran out
+    void DrainSubmitBuffers(bool enqueue);                  // Stop: flush (or reject) every live buffer
+
+    // Timer helpers
+    struct PeriodicTimer {
+        TaskFunction<void()> fn;
+        std::uint64_t        period_ticks{1};
+        std::atomic<bool>    outstanding{false};  // a firing is waiting for a lane, queued or running
+        std::atomic<bool>    cancelled{false};    // CancelTimer: a firing already out runs nothing
+        bool                 internal{false}; // pool housekeeping: runs on the timer thread, never rejected or counted
+    };
+    struct TimerTask {
+        TaskFunction<void()> fn;              // one-shot body; empty for periodic timers
+        TaskPriority         priority{TaskPriority::Normal};
+    };
+    struct TimerFiring {
+        Task                                  task;
+        TaskPriority                          priority{TaskPriority::Normal};
+        std::chrono::steady_clock::time_point due_at;    // first hand-over attempt (BlockFor's clock)
+    };
+    TimerId       AddTimer(std::uint64_t deadline, TimerTask task, std::shared_ptr<PeriodicTimer> periodic);
+    TimerId       AddFixedRate(std::chrono::steady_clock::duration period, TaskFunction<void()> f,
+                               TaskPriority priority, bool internal);
+    std::uint64_t TimerTick(std::chrono::steady_clock::time_point when) const noexcept;  // rounded up
+    void          TimerLoop();
+    bool          HandOverTimerTask(TimerFiring& firing);  // never blocks or runs inline; false = retry next tick
+    void          CancelTimerEvicted();                    // worker or Stop: cancel what timer firings overwrote
+    void          StopTimerThread();
+
+    // Post's enqueue path for any task type: pause wait, local deque, lane by queue-full policy.
+    // False if the task was rejected or dropped (it is not cancelled). Under CallerRuns a task
+    // the lane cannot take runs before Dispatch returns true, unless `caller_runs` is given:
+    // then it is handed back there (and Dispatch returns false) for the caller to run
+    bool Dispatch(Task task, TaskPriority priority, Task* caller_runs = nullptr);
+    bool Enqueue(Task task, TaskPriority priority, Task* caller_runs);  // Dispatch past the state gate and local deque
+    std::size_t DispatchBatch(std::vector<Task>& tasks);  // PostBatch's enqueue path
+    std::size_t DispatchBuffered(std::vector<Task>& tasks);  // SubmitBuffer flush: pause gate, then EnqueueBuffered
+    std::size_t EnqueueBuffered(std::vector<Task>& tasks);   // batch push, the rest one by one under the policy
+    void RunInCaller(Task& task) noexcept;                // CallerRuns: execute on the submitting thread, after TryBeginInline()
+
     template <class R>
-    static std::future<R> BrokenFuture(std::exception_ptr eptr);
+    static Future<R> BrokenFuture(std::exception_ptr eptr);
 private:
     std::atomic<PoolState> state_;
-    BlockingQueueAdapter<TaskPtr> queue_;
+    EventCount lane_ready_;                // consumer side of every lane; idle workers park here
+    BlockingQueueAdapter<Task> queue_;     // Normal lane (the shared queue)
+    BlockingQueueAdapter<Task> high_lane_;
+    BlockingQueueAdapter<Task> low_lane_;
+    std::size_t priority_aging_{0};        // every Nth pick starts at a lower lane (0 = strict)
     std::vector<std::unique_ptr<WorkerSlot>> workers_;
+    std::vector<std::unique_ptr<WorkerSlot>> exited_workers_;  // retired on keep-alive, not joined yet
     std::atomic<QueueFullPolicy> policy_;
+    std::chrono::milliseconds    block_timeout_{0};  // BlockFor: longest wait for queue space
+
+    // Work-stealing scheduling
+    SchedulingMode                                          scheduling_{SchedulingMode::Shared};
+    std::vector<std::unique_ptr<WorkStealingDeque<Task>>> local_queues_;     // one per worker index, up to max_threads_
+    std::atomic<std::size_t>                                local_pending_{0};  // tasks parked in local deques
+
+    // Idle strategy
+    IdleStrategy             idle_strategy_{IdleStrategy::Park};  // behaviour when the queue runs dry
+    std::size_t              idle_spin_max_{0};                   // adaptive spin budget upper bound
+    std::size_t              idle_yield_count_{0};                // yield rounds before parking
+    std::size_t              max_spinning_workers_{0};            // concurrent spinner cap
+    std::atomic<std::size_t> spinning_workers_{0};                // workers currently spinning
+    static thread_local const ThreadPool*                   tls_pool_;          // pool owning the current worker thread
+    static thread_local WorkerSlot*                         tls_worker_;        // slot of the current worker thread
 
     // Dynamic thread management
-    mutable                 std::mutex workers_mu_;  // protects workers_ container
+    mutable                 std::mutex workers_mu_;  // protects workers_ and exited_workers_
     std::thread             load_balancer_;          // balancer thread
     std::atomic<bool>       balancer_stop_{true};    // balancer exit flag
     std::atomic<bool>       balancer_kick_{false};   // manual wake flag
@@ -124,8 +365,7 @@ private:
     std::mutex              load_cv_mu_;             // load-balancing mutex
 
     // State management
-    std::mutex pause_mtx_;  // pause lock
-    std::condition_variable pause_cv_;
+    EventCount pause_gate_;  // paused workers/submitters park here
     mutable std::mutex drain_mtx_;  // drain lock
     std::condition_variable drain_cv_;
     mutable std::mutex submit_mtx_;  // submission lock
@@ -135,51 +375,113 @@ private:
     std::size_t               core_threads_{0};            // core thread count
     std::size_t               max_threads_{0};             // maximum thread count
     std::chrono::milliseconds load_check_interval_{0};     // load balancer sampling interval
-    std::chrono::milliseconds keep_alive_{0};              // idle thread keep-alive time
+    std::chrono::milliseconds keep_alive_{0};              // idle time after which a surplus worker retires
     double                    scale_up_threshold_{0.0};    // busy ratio upper bound (scale up if exceeded)
-    double                    scale_down_threshold_{0.0};  // busy ratio lower bound (scale down if below)
     std::size_t               pending_hi_{0};              // pending threshold (upper)
-    std::size_t               pending_low_{0};             // pending threshold (lower)
     std::size_t               debounce_hits_{0};           // debounce hit count
     std::chrono::milliseconds cooldown_{0};                // cooldown after capacity change
+    AutoscaleMode             autoscale_mode_{AutoscaleMode::Thresholds};  // balancer controller
+    std::chrono::nanoseconds  sojourn_target_{0};          // Sojourn: queue wait to steer towards
+    double                    sojourn_kp_{0.0};            // Sojourn: proportional gain
+    double                    sojourn_ki_{0.0};            // Sojourn: integral gain (per second)
+    std::atomic<std::size_t>  thread_cap_{0};              // workers above this retire at their next idle moment
+    std::atomic<std::size_t>  thread_floor_{0};            // no retirement below this (core_threads_, or the HillClimb count)
+    std::chrono::milliseconds hill_climb_window_{0};       // HillClimb: measurement window per probe
+    double                    cpu_quota_{1.0};             // HillClimb: CPUs the process may use (cgroup quota or hardware)
+
+    // Delayed/periodic scheduling; timers_fired_ and the evicted list aside, guarded by timer_mu_
+    mutable std::mutex                                          timer_mu_;
+    std::condition_variable                                     timer_cv_;          // timer thread wake-up
+    std::thread                                                 timer_thread_;      // started by the first Schedule*
+    bool                                                        timer_stop_{false};
+    TimingWheel<TimerTask>                                      timers_;
+    std::unordered_map<TimerId, std::shared_ptr<PeriodicTimer>> periodic_timers_;   // fixed-rate state by id
+    std::chrono::steady_clock::time_point                       timer_origin_;      // tick 0
+    std::chrono::steady_clock::duration                         timer_tick_{};      // wheel resolution
+    std::uint64_t                                               timer_wake_tick_{0};  // tick the timer thread sleeps until
+    std::size_t                                                 internal_timers_{0};  // housekeeping timers in timers_, not reported
+    std::size_t                                                 timer_unplaced_{0};   // firings the timer thread still held at Stop
+    std::atomic<std::size_t>                                    timers_fired_{0};
+    std::mutex                                                  timer_evicted_mu_;
+    std::vector<Task>                                           timer_evicted_;       // Overwrite victims of timer firings
+    std::atomic<bool>                                           timer_evicted_pending_{false};
 
     // Dynamic thread management interfaces
     void                     LaunchLoadBalancer();                                         // background balancer thread
     void                     StopLoadBalancer();                                           // stop and join balancer thread
     void                     LoadBalancerLoop();                                           // periodically sample load and adjust capacity
+    void                     SojournStep(double level, double wait_ewma_ns);              // size to a Sojourn controller output in [0, 1]
+    void                     HillClimbStep(std::size_t count, const TunerSample& sample, double cpu_used);  // record a window, run `count` workers
     void                     CreateWorkerUnlocked();                                       // create WorkerSlot and run WorkerLoop
-    std::vector<WorkerSlot*> ScheduleShrinkUnlocked(std::size_t count);                    // mark workers to retire
-    void                     EnqueueExitSignals(const std::vector<WorkerSlot*>& targets);  // enqueue directed exit tasks
-    void                     RetireWorkerUnlocked(WorkerSlot& slot);                       // retire worker
+    bool                     TryRetire(WorkerSlot& slot, std::size_t floor = 0) noexcept;  // claim an exit while above floor and thread_floor_
+    void                     DetachRetiredWorker(WorkerSlot& slot);                        // move own slot to exited_workers_
+    void                     ReapExitedWorkers();                                          // join retired worker threads
 private:
     // Task state
-    std::atomic<size_t>      active_tasks_{0};  // active tasks
     std::atomic<std::size_t> submit_ing_{0};    // submissions in progress
 
     // Statistics
     std::atomic<std::size_t> total_submitted_{0};  // total tasks submitted successfully
-    std::atomic<std::size_t> total_completed_{0};  // total tasks executed successfully
-    std::atomic<std::size_t> total_failed_{0};     // total tasks failed during execution
     std::atomic<std::size_t> total_cancelled_{0};  // total tasks cancelled
     std::atomic<std::size_t> total_rejected_{0};   // total tasks rejected on submit
 
-    std::atomic<std::size_t> total_exec_time_ns_{0};  // total execution time (ns)
+    // Sharded per-worker statistics
+    mutable std::mutex       stats_mu_;        // guards the three members below
+    std::vector<WorkerSlot*> stats_shards_;    // live workers whose counters are not folded yet
+    StatsTotals              stats_retired_;   // counters folded in from exited workers
+    StatsTotals              stats_base_;      // totals at the last ResetStatistics()
+#if TP_LATENCY_HISTOGRAMS
+    LatencyHistograms        latency_retired_;  // histograms folded in from exited workers
+    LatencyHistograms        latency_base_;     // histograms at the last ResetStatistics()
+#endif
 
     // pending is maintained by queue_
     std::atomic<double> busy_ratio_{0.0};     // busy thread ratio
     std::atomic<double> pending_ratio_{0.0};  // queue utilization ratio
+    std::atomic<std::int64_t> queue_wait_ewma_ns_{0};  // smoothed queue wait, updated by the balancer
+    std::atomic<std::size_t>  tuned_threads_{0};       // HillClimb: count chosen for the current window
+    mutable std::mutex        tuner_mu_;               // guards tuner_samples_
+    std::vector<TunerSample>  tuner_samples_;          // HillClimb: latest windows, oldest first
 
     std::atomic<std::size_t> current_threads_{0};          // current running worker count
-    std::atomic<std::size_t> active_threads_{0};           // workers currently executing tasks
     std::atomic<std::size_t> peak_threads_{0};             // peak worker count
     std::atomic<std::size_t> total_threads_created_{0};    // total workers created
     std::atomic<std::size_t> total_threads_destroyed_{0};  // total workers destroyed
 
     std::atomic<std::size_t> discard_cnt_{0};      // discarded task count
     std::atomic<std::size_t> overwrite_cnt_{0};    // overwritten task count
+    std::atomic<std::size_t> caller_runs_cnt_{0};  // tasks run inline by their submitter
     std::atomic<std::size_t> paused_wait_cnt_{0};  // times waited due to pause
-
-    void RecordTaskComplete(const TaskBase& task, std::chrono::steady_clock::duration duration) noexcept;
+    std::atomic<std::size_t> steal_cnt_{0};        // tasks taken from another worker's deque
+    std::atomic<std::size_t> spin_hit_cnt_{0};     // tasks found while spinning
+    std::atomic<std::size_t> park_cnt_{0};         // blocking waits on the queue
+    std::atomic<std::size_t> inline_starting_{0};  // CallerRuns submitters between pause check and task start
+    std::atomic<std::size_t> buffer_flush_cnt_{0}; // SubmitBuffer batches handed to the queue
+
+    // Submission buffers
+    mutable std::mutex         buffers_mu_;           // guards submit_buffers_ and sweep_timer_
+    std::vector<SubmitBuffer*> submit_buffers_;       // live buffers
+    TimerId                    sweep_timer_{0};       // fixed-rate linger sweep (0 = none)
+    std::atomic<std::int64_t>  sweep_period_us_{0};   // its period in us; 0 = not armed
+
+    // Managed blocking
+    std::size_t              max_blocking_threads_{0};     // cap on live compensating workers
+    std::atomic<std::size_t> blocked_workers_{0};          // workers inside a BlockingRegion
+    std::atomic<std::size_t> compensating_workers_{0};     // extra workers started for them, not yet given back
+    std::atomic<std::size_t> retire_owed_{0};              // ended regions whose extra worker has yet to leave
+    std::atomic<std::size_t> compensation_cnt_{0};         // compensating workers started
+
+    bool EnterBlocking() noexcept;                  // true if a compensating worker was started
+    void LeaveBlocking(bool compensated) noexcept;
+    bool TryRetireOwed(WorkerSlot& slot) noexcept;  // give back one compensating worker
+
+    void RecordTaskComplete(WorkerSlot& slot, const Task& task, std::chrono::steady_clock::duration duration) noexcept;
+    static StatsTotals SnapshotShard(const WorkerStats& shard) noexcept;  // seqlock read
+    StatsTotals AggregateStatsLocked() const noexcept;                   // requires stats_mu_
+#if TP_LATENCY_HISTOGRAMS
+    void AggregateLatencyLocked(LatencyHistograms& out) const noexcept;  // requires stats_mu_
+#endif
+    void FoldWorkerStats(WorkerSlot& slot) noexcept;                      // on worker exit
     void RecordTaskCancel() noexcept;
     void RecordTaskRejected() noexcept;
 };
@@ -191,21 +493,25 @@ inline std::size_t ThreadPool::PostBatch(Iterator begin, Iterator end) {
         return 0;
     }
 
-    std::vector<TaskPtr> tasks;
+    std::vector<Task> tasks;
     tasks.reserve(std::distance(begin, end));
     
     for (auto it = begin; it != end; ++it) {
         // Use lightweight SimpleTask to avoid future overhead
-        auto task = std::make_unique<SimpleTask>(
+        auto task = Task::Make<SimpleTask>(
             typename SimpleTask::Func([f = *it]() mutable { f(); })
         );
         tasks.push_back(std::move(task));
     }
+#if TP_LATENCY_HISTOGRAMS
+    const auto now_ns = LatencyClockNs();  // one stamp for the whole batch
+    for (auto& task : tasks) {
+        task.StampSubmitted(now_ns);
+    }
+#endif
 
-    const auto count = queue_.TryPushBatch(tasks.begin(), tasks.end());
-    total_submitted_.fetch_add(count, std::memory_order_relaxed);
-    
-    return count;
+
+    return DispatchBatch(tasks);
 }
 
 // Batch submission using a generator function (uses lightweight SimpleTask)
@@ -215,33 +521,40 @@ inline std::size_t ThreadPool::PostBatch(Func generator, std::size_t count) {
         return 0;
     }
 
-    std::vector<TaskPtr> tasks;
+    std::vector<Task> tasks;
     tasks.reserve(count);
     
     for (std::size_t i = 0; i < count; ++i) {
         auto f = generator(i);
         // Use lightweight SimpleTask to avoid future overhead
-        auto task = std::make_unique<SimpleTask>(
+        auto task = Task::Make<SimpleTask>(
             typename SimpleTask::Func(std::move(f))
         );
         tasks.push_back(std::move(task));
     }
+#if TP_LATENCY_HISTOGRAMS
+    const auto now_ns = LatencyClockNs();  // one stamp for the whole batch
+    for (auto& task : tasks) {
+        task.StampSubmitted(now_ns);
+    }
+#endif
 
-    const auto pushed = queue_.TryPushBatch(tasks.begin(), tasks.end());
-    total_submitted_.fetch_add(pushed, std::memory_order_relaxed);
-    
-    return pushed;
+
+    return DispatchBatch(tasks);
 }
 
 template <class R>
-inline std::future<R> ThreadPool::BrokenFuture(std::exception_ptr eptr) {
-    std::promise<R> promise; 
-    promise.set_exception(std::move(eptr)); 
-    return promise.get_future();
+inline Future<R> ThreadPool::BrokenFuture(std::exception_ptr eptr) {
+    return Future<R>::FromException(std::move(eptr));
 }
 
 template <typename Func, typename... Args>
-auto ThreadPool::Submit(Func&& f, Args&&... args) -> std::future<std::invoke_result_t<Func, Args...>> {
+auto ThreadPool::Submit(Func&& f, Args&&... args) -> Future<std::invoke_result_t<Func, Args...>> {
+    return Submit(TaskPriority::Normal, std::forward<Func>(f), std::forward<Args>(args)...);
+}
+
+template <typename Func, typename... Args>
+auto ThreadPool::Submit(TaskPriority priority, Func&& f, Args&&... args) -> Future<std::invoke_result_t<Func, Args...>> {
     using Return = std::invoke_result_t<Func, Args...>;
 
     // Package into a closure
@@ -251,13 +564,17 @@ auto ThreadPool::Submit(Func&& f, Args&&... args) -> std::future<std::invoke_res
         return std::apply(std::move(ff), std::move(tup)); 
     }; 
 
-    auto task_ptr = std::make_unique<FutureTask<Return>>(
+    // The task (and the closure, when it fits) lives inline in the Task handle
+    Task task = Task::Make<FutureTask<Return>>(
         typename FutureTask<Return>::Func(std::move(bound)) 
-        // typename FutureTask<Return>::Func = std::function<Return()> (type erasure)
+        // typename FutureTask<Return>::Func = TaskFunction<Return()> (inline type erasure)
     );
-    std::future<Return> fut;
+#if TP_LATENCY_HISTOGRAMS
+    task.StampSubmitted(LatencyClockNs());
+#endif
+    Future<Return> fut;
     try {
-        fut = task_ptr->GetFuture();
+        fut = static_cast<FutureTask<Return>*>(task.get())->GetFuture();
     } catch (const std::exception& ex) {
         TP_LOG_ERROR("Submit failed to acquire future: {}", ex.what());
         throw;
@@ -293,12 +610,8 @@ auto ThreadPool::Submit(Func&& f, Args&&... args) -> std::future<std::invoke_res
         }
         if (s == PoolState::PAUSED) {
             TP_LOG_DEBUG("Submit blocked: pool paused");
-            std::unique_lock<std::mutex> lk(pause_mtx_);
             paused_wait_cnt_.fetch_add(1, std::memory_order_relaxed);
-            pause_cv_.wait(lk, [this] {
-                auto t = state_.load(std::memory_order_acquire);
-                return t != PoolState::PAUSED;
-            });
+            ParkWhilePaused();
             waited_in_pause = true;
             // Check wake reason (e.g., Stop)
             continue;
@@ -314,7 +627,7 @@ auto ThreadPool::Submit(Func&& f, Args&&... args) -> std::future<std::invoke_res
             auto eptr = std::make_exception_ptr(
                 std::runtime_error("force stopped")
             );
-            task_ptr->Cancel(eptr);
+            task->Cancel(eptr);
             TP_LOG_ERROR("Submit cancelled: pool force stopping; pending={}", Pending());
             return BrokenFuture<Return>(eptr);
         }
@@ -322,12 +635,25 @@ auto ThreadPool::Submit(Func&& f, Args&&... args) -> std::future<std::invoke_res
         TP_LOG_ERROR("Submit rejected: pool state={} (expected RUNNING)", s);
         throw std::runtime_error("ThreadPool::Submit: pool is not RUNNING");
     }
+#if TP_LATENCY_HISTOGRAMS
+    if (waited_in_pause) {
+        task.StampEnqueued(LatencyClockNs()); // time parked behind Pause() is not queue wait
+    }
+#endif
+
+    // Normal tasks submitted from one of our workers stay on its local deque
+    if (priority == TaskPriority::Normal && TryPushLocal(task)) {
+        total_submitted_.fetch_add(1, std::memory_order_relaxed);
+        TP_LOG_TRACE("Submit kept on local deque: pending={}", Pending());
+        return fut;
+    }
 
     // Dispatch by queue policy
+    auto& lane = Lane(priority);
     const auto policy = policy_.load(std::memory_order_relaxed);
     switch (policy) {
         case QueueFullPolicy::Block: {
-            if (!queue_.WaitPush(std::move(task_ptr))) {
+            if (!lane.WaitPush(std::move(task))) {
                 RecordTaskRejected(); // task rejected
                 auto eptr = std::make_exception_ptr(
                     std::runtime_error("ThreadPool::Submit: queue closed")
@@ -338,12 +664,12 @@ auto ThreadPool::Submit(Func&& f, Args&&... args) -> std::future<std::invoke_res
             }
             total_submitted_.fetch_add(1, std::memory_order_relaxed); // successfully enqueued
             TP_LOG_TRACE("Submit succeeded (policy=Block): pending={} queue_cap={}",
-                         Pending(), queue_.Capacity());
+                         Pending(), lane.Capacity());
             return fut;
         }
 
         case QueueFullPolicy::Discard: {
-             if (!queue_.TryPush(std::move(task_ptr))) {
+             if (!lane.TryPush(std::move(task))) {
                 RecordTaskRejected(); // task rejected
                 discard_cnt_.fetch_add(1, std::memory_order_relaxed);
                 auto eptr = std::make_exception_ptr(
@@ -360,8 +686,8 @@ auto ThreadPool::Submit(Func&& f, Args&&... args) -> std::future<std::invoke_res
         }
         
         case QueueFullPolicy::Overwrite: {
-            TaskPtr overwritten;
-            bool pushed = queue_.OverwritePush(std::move(task_ptr), &overwritten);
+            Task overwritten;
+            bool pushed = lane.OverwritePush(std::move(task), &overwritten);
             if (overwritten) {
                 overwritten->Cancel(std::make_exception_ptr(
                     std::runtime_error("ThreadPool::Submit: overwritten")
@@ -372,12 +698,11 @@ auto ThreadPool::Submit(Func&& f, Args&&... args) -> std::future<std::invoke_res
                              overwrite_cnt_.load(std::memory_order_relaxed));
             }
             if (!pushed) {
-                RecordTaskRejected(); // task rejected
-                discard_cnt_.fetch_add(1, std::memory_order_relaxed);
+                RecordTaskRejected(); // task rejected; the drop-oldest push only fails once closed
                 auto eptr = std::make_exception_ptr(
-                    std::runtime_error("ThreadPool::Submit: overwrite failed"));
-                TP_LOG_WARN("Submit failed (policy=Overwrite): queue could not accept task, pending={}, discard_cnt={}",
-                            Pending(), discard_cnt_.load(std::memory_order_relaxed));
+                    std::runtime_error("ThreadPool::Submit: queue closed"));
+                TP_LOG_WARN("Submit failed (policy=Overwrite): queue closed, pending={}, state={}",
+                            Pending(), State());
                 return BrokenFuture<Return>(eptr);
             }
             total_submitted_.fetch_add(1, std::memory_order_relaxed); // successfully enqueued
@@ -385,6 +710,48 @@ auto ThreadPool::Submit(Func&& f, Args&&... args) -> std::future<std::invoke_res
                          Pending(), overwrite_cnt_.load(std::memory_order_relaxed));
             return fut;
         }
+
+        case QueueFullPolicy::CallerRuns: {
+            for (;;) {
+                if (lane.TryPush(std::move(task))) {
+                    total_submitted_.fetch_add(1, std::memory_order_relaxed); // successfully enqueued
+                    return fut;
+                }
+                if (lane.Closed()) {
+                    RecordTaskRejected(); // task rejected
+                    TP_LOG_WARN("Submit failed (policy=CallerRuns): queue closed, state={}", State());
+                    return BrokenFuture<Return>(std::make_exception_ptr(
+                        std::runtime_error("ThreadPool::Submit: queue closed")));
+                }
+                if (TryBeginInline()) {
+                    RunInCaller(task);  // fut is ready (value or exception) on return
+                    TP_LOG_TRACE("Submit ran in caller (policy=CallerRuns): pending={}", Pending());
+                    return fut;
+                }
+                // Paused: no task may start, inline ones included; the lane may have room after
+                paused_wait_cnt_.fetch_add(1, std::memory_order_relaxed);
+                ParkWhilePaused();
+            }
+        }
+
+        case QueueFullPolicy::BlockFor: {
+            if (!lane.WaitPushFor(std::move(task), block_timeout_)) {
+                RecordTaskRejected(); // task rejected
+                const bool closed = lane.Closed();
+                if (!closed) {
+                    discard_cnt_.fetch_add(1, std::memory_order_relaxed);
+                }
+                auto eptr = std::make_exception_ptr(std::runtime_error(
+                    closed ? "ThreadPool::Submit: queue closed" : "ThreadPool::Submit: timed out"));
+                TP_LOG_WARN("Submit failed (policy=BlockFor): {} after {}ms, pending={}",
+                            closed ? "queue closed" : "no space", block_timeout_.count(), Pending());
+                return BrokenFuture<Return>(eptr);
+            }
+            total_submitted_.fetch_add(1, std::memory_order_relaxed); // successfully enqueued
+            TP_LOG_TRACE("Submit succeeded (policy=BlockFor): pending={} queue_cap={}",
+                         Pending(), lane.Capacity());
+            return fut;
+        }
     }
 
     // Should not reach here
@@ -394,3 +761,7 @@ auto ThreadPool::Submit(Func&& f, Args&&... args) -> std::future<std::invoke_res
     return BrokenFuture<Return>(eptr);
 }
 }
+
+#if TP_COROUTINES
+#include "thread_pool/coroutine.hpp"
+#endif
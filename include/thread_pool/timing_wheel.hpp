@@ -0,0 +1,259 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace thread_pool {
+
+// Hierarchical timing wheel (Varghese & Lauck): four levels of 256 slots cover 2^32 ticks;
+// a deadline further out waits in the top level and is re-filed whenever that slot cascades.
+// Add and Cancel are O(1), and a timer moves down at most three levels before it fires.
+// Timers live in a chunked node pool linked by 32-bit indices, so an outstanding timer costs
+// one node (payload + 24 bytes) and no allocation of its own.
+// Not thread-safe: the owner serialises every call.
+template <typename Payload>
+class TimingWheel {
+public:
+    using TimerId = std::uint64_t;  // (generation << 32) | (node index + 1); 0 is never issued
+    static constexpr TimerId       kInvalidTimer = 0;
+    static constexpr std::uint64_t kNever = std::numeric_limits<std::uint64_t>::max();
+
+    explicit TimingWheel(std::uint64_t now_tick = 0) noexcept : now_(now_tick) {
+        heads_.fill(kNil);
+    }
+    TimingWheel(const TimingWheel&) = delete;
+    TimingWheel& operator=(const TimingWheel&) = delete;
+
+    // Last tick processed by Advance
+    std::uint64_t Now() const noexcept {
+        return now_;
+    }
+    std::size_t Size() const noexcept {
+        return size_;
+    }
+    std::size_t MemoryFootprint() const noexcept {
+        return sizeof(*this) + chunks_.capacity() * sizeof(chunks_[0]) + chunks_.size() * kChunkSize * sizeof(Node);
+    }
+
+    // Deadlines at or before Now() fire on the next tick
+    TimerId Add(std::uint64_t deadline, Payload payload) {
+        const std::uint32_t index = Allocate();
+        Node& node = At(index);
+        node.payload = std::move(payload);
+        node.deadline = deadline;
+        node.live = true;
+        Link(index);
+        ++size_;
+        return (static_cast<TimerId>(node.gen) << 32) | (static_cast<TimerId>(index) + 1);
+    }
+
+    // O(1); false if the timer already fired (one-shot), was cancelled, or never existed
+    bool Cancel(TimerId id) noexcept {
+        const auto low = static_cast<std::uint32_t>(id & 0xFFFFFFFFu);
+        if (low == 0 || low > allocated_) {
+            return false;
+        }
+        const std::uint32_t index = low - 1;
+        Node& node = At(index);
+        if (!node.live || node.gen != static_cast<std::uint32_t>(id >> 32)) {
+            return false;
+        }
+        Unlink(index);
+        Release(index);
+        --size_;
+        return true;
+    }
+
+    // Drop every timer and release the node pool; Now() is kept
+    void Clear() noexcept {
+        heads_.fill(kNil);
+        chunks_.clear();
+        chunks_.shrink_to_fit();
+        allocated_ = 0;
+        free_ = kNil;
+        size_ = 0;
+    }
+
+    // Process every tick up to and including `to`, skipping straight over ticks with nothing to
+    // fire or cascade. For each due timer, on_expire(TimerId, Payload&, deadline) returns the
+    // next deadline to re-arm it under the same id, or kNever to retire it.
+    // on_expire must not call Add or Cancel.
+    template <typename OnExpire>
+    void Advance(std::uint64_t to, OnExpire&& on_expire) {
+        while (now_ < to) {
+            const std::uint64_t tick = NextTick();
+            if (tick > to) {
+                now_ = to;  // nothing is filed before `tick`, so every slot stays valid
+                return;
+            }
+            if ((tick & kSlotMask) == 0) {
+                now_ = tick - 1;
+                // Re-file the upper-level slots that start at this tick, top level first
+                for (unsigned level = kLevels - 1; level > 0; --level) {
+                    const std::uint64_t span_mask = (std::uint64_t{1} << (kSlotBits * level)) - 1;
+                    if ((tick & span_mask) == 0) {
+                        Cascade(level, static_cast<std::size_t>((tick >> (kSlotBits * level)) & kSlotMask));
+                    }
+                }
+            }
+            now_ = tick;
+            Expire(static_cast<std::size_t>(tick & kSlotMask), on_expire);
+        }
+    }
+
+    // Earliest tick at which Advance has work: a non-empty level-0 slot, or a cascade boundary
+    // of a non-empty upper-level slot (exact for level 0, an upper bound on the next expiry
+    // otherwise); kNever when no timer is pending. At most kLevels * kSlots probes.
+    std::uint64_t NextTick() const noexcept {
+        if (size_ == 0) {
+            return kNever;
+        }
+        std::uint64_t best = kNever;
+        for (std::uint64_t tick = now_ + 1; tick <= now_ + kSlots; ++tick) {
+            if (heads_[tick & kSlotMask] != kNil) {
+                best = tick;
+                break;
+            }
+        }
+        for (unsigned level = 1; level < kLevels; ++level) {
+            const unsigned shift = kSlotBits * level;
+            for (std::uint64_t k = 1; k <= kSlots; ++k) {
+                const std::uint64_t boundary = ((now_ >> shift) + k) << shift;
+                if (boundary >= best) {
+                    break;
+                }
+                if (heads_[level * kSlots + ((boundary >> shift) & kSlotMask)] != kNil) {
+                    best = boundary;
+                    break;
+                }
+            }
+        }
+        return best;
+    }
+
+private:
+    static constexpr unsigned      kLevels = 4;
+    static constexpr unsigned      kSlotBits = 8;
+    static constexpr std::size_t   kSlots = std::size_t{1} << kSlotBits;
+    static constexpr std::uint64_t kSlotMask = kSlots - 1;
+    static constexpr std::uint32_t kNil = std::numeric_limits<std::uint32_t>::max();
+    static constexpr std::size_t   kChunkSize = 4096;
+
+    struct Node {
+        Payload       payload{};
+        std::uint64_t deadline{0};
+        std::uint32_t prev{kNil};
+        std::uint32_t next{kNil};     // also the free-list link
+        std::uint32_t gen{1};
+        std::uint16_t bucket{0};      // level * kSlots + slot
+        bool          live{false};
+    };
+
+    Node& At(std::uint32_t index) noexcept {
+        return chunks_[index / kChunkSize][index % kChunkSize];
+    }
+
+    std::uint32_t Allocate() {
+        if (free_ != kNil) {
+            const std::uint32_t index = free_;
+            free_ = At(index).next;
+            return index;
+        }
+        if (allocated_ % kChunkSize == 0) {
+            chunks_.push_back(std::make_unique<Node[]>(kChunkSize));
+        }
+        return allocated_++;
+    }
+    void Release(std::uint32_t index) noexcept {
+        Node& node = At(index);
+        node.payload = Payload{};
+        node.live = false;
+        ++node.gen;
+        node.prev = kNil;
+        node.next = free_;
+        free_ = index;
+    }
+
+    // File a node by its distance from now_: level L holds deadlines 256^L..256^(L+1) ticks out,
+    // indexed by the deadline's L-th byte, so each slot is reached exactly when it is due
+    void Link(std::uint32_t index) noexcept {
+        Node& node = At(index);
+        std::uint64_t due = node.deadline > now_ ? node.deadline : now_ + 1;
+        std::uint64_t offset = due - now_ - 1;
+        const std::uint64_t horizon = (std::uint64_t{1} << (kSlotBits * kLevels)) - 1;
+        if (offset > horizon) {
+            due = now_ + 1 + horizon;
+            offset = horizon;
+        }
+        unsigned level = 0;
+        while (level + 1 < kLevels && offset >= (std::uint64_t{1} << (kSlotBits * (level + 1)))) {
+            ++level;
+        }
+        const auto slot = static_cast<std::size_t>((due >> (kSlotBits * level)) & kSlotMask);
+        const auto bucket = static_cast<std::uint16_t>(level * kSlots + slot);
+        node.bucket = bucket;
+        node.prev = kNil;
+        node.next = heads_[bucket];
+        if (node.next != kNil) {
+            At(node.next).prev = index;
+        }
+        heads_[bucket] = index;
+    }
+    void Unlink(std::uint32_t index) noexcept {
+        Node& node = At(index);
+        if (node.prev != kNil) {
+            At(node.prev).next = node.next;
+        } else {
+            heads_[node.bucket] = node.next;
+        }
+        if (node.next != kNil) {
+            At(node.next).prev = node.prev;
+        }
+    }
+
+    void Cascade(unsigned level, std::size_t slot) noexcept {
+        const std::size_t bucket = level * kSlots + slot;
+        std::uint32_t index = heads_[bucket];
+        heads_[bucket] = kNil;
+        while (index != kNil) {
+            const std::uint32_t next = At(index).next;
+            Link(index);
+            index = next;
+        }
+    }
+
+    template <typename OnExpire>
+    void Expire(std::size_t slot, OnExpire& on_expire) {
+        std::uint32_t index = heads_[slot];
+        heads_[slot] = kNil;
+        while (index != kNil) {
+            Node& node = At(index);
+            const std::uint32_t next = node.next;
+            const TimerId id = (static_cast<TimerId>(node.gen) << 32) | (static_cast<TimerId>(index) + 1);
+            const std::uint64_t again = on_expire(id, node.payload, node.deadline);
+            if (again == kNever) {
+                Release(index);
+                --size_;
+            } else {
+                node.deadline = again;
+                Link(index);
+            }
+            index = next;
+        }
+    }
+
+private:
+    std::array<std::uint32_t, kLevels * kSlots> heads_{};
+    std::vector<std::unique_ptr<Node[]>>         chunks_;
+    std::uint32_t                                allocated_{0};
+    std::uint32_t                                free_{kNil};
+    std::size_t                                  size_{0};
+    std::uint64_t                                now_{0};
+};
+
+}
@@ -1,6 +1,7 @@
 #include "thread_pool/config.hpp"
 #include "logger.hpp"
 
+#include <atomic>
 #include <fstream>
 #include <sstream>
 #include <stdexcept>
@@ -84,14 +85,14 @@ namespace thread_pool {
             RawConfig raw = ParseRaw(jcfg);
             ThreadPoolConfig cfg = Normalize(raw);
             TP_LOG_INFO(
-                "ThreadPool config loaded from {} (queue_cap={} core_threads={} max_threads={} pending_hi={} pending_low={} policy={})",
+                "ThreadPool config loaded from {} (queue_cap={} core_threads={} max_threads={} pending_hi={} policy={} scheduling={})",
                 source_desc,
                 cfg.queue_cap,
                 cfg.core_threads,
                 cfg.max_threads,
                 cfg.pending_hi,
-                cfg.pending_low,
-                cfg.queue_policy);
+                cfg.queue_policy,
+                cfg.scheduling);
             {
                 std::lock_guard<std::mutex> lk(cfg_mtx_);
                 config_ = std::move(cfg);
@@ -137,12 +138,79 @@ namespace thread_pool {
         if (jcfg.contains("debounce_hits")) {
             raw.debounce_hits = jcfg.at("debounce_hits").get<std::size_t>();
         }
+        if (raw.scale_down_threshold.has_value() || raw.pending_low.has_value()) {
+            static std::atomic<bool> warned{false};
+            if (!warned.exchange(true, std::memory_order_relaxed)) {
+                TP_LOG_WARN("ThreadPoolConfigLoader: scale_down_threshold and pending_low are deprecated and ignored; "
+                            "surplus workers retire after keep_alive_ms idle");
+            }
+        }
         if (jcfg.contains("cooldown_ms")) {
             raw.cooldown_ms = jcfg.at("cooldown_ms").get<std::size_t>();
         }
         if (jcfg.contains("queue_policy")) {
             raw.queue_policy = jcfg.at("queue_policy").get<std::string>();
         }
+        if (jcfg.contains("scheduling_mode")) {
+            raw.scheduling_mode = jcfg.at("scheduling_mode").get<std::string>();
+        }
+        if (jcfg.contains("local_queue_cap")) {
+            raw.local_queue_cap = jcfg.at("local_queue_cap").get<std::size_t>();
+        }
+        if (jcfg.contains("idle_strategy")) {
+            raw.idle_strategy = jcfg.at("idle_strategy").get<std::string>();
+        }
+        if (jcfg.contains("idle_spin_max")) {
+            raw.idle_spin_max = jcfg.at("idle_spin_max").get<std::size_t>();
+        }
+        if (jcfg.contains("idle_yield_count")) {
+            raw.idle_yield_count = jcfg.at("idle_yield_count").get<std::size_t>();
+        }
+        if (jcfg.contains("max_spinning_workers")) {
+            raw.max_spinning_workers = jcfg.at("max_spinning_workers").get<std::size_t>();
+        }
+        if (jcfg.contains("priority_lane_cap")) {
+            raw.priority_lane_cap = jcfg.at("priority_lane_cap").get<std::size_t>();
+        }
+        if (jcfg.contains("priority_aging")) {
+            raw.priority_aging = jcfg.at("priority_aging").get<std::size_t>();
+        }
+        if (jcfg.contains("timer_tick_us")) {
+            raw.timer_tick_us = jcfg.at("timer_tick_us").get<std::size_t>();
+        }
+        if (jcfg.contains("autoscale_mode")) {
+            raw.autoscale_mode = jcfg.at("autoscale_mode").get<std::string>();
+        }
+        if (jcfg.contains("sojourn_target_us")) {
+            raw.sojourn_target_us = jcfg.at("sojourn_target_us").get<std::size_t>();
+        }
+        if (jcfg.contains("sojourn_kp")) {
+            raw.sojourn_kp = jcfg.at("sojourn_kp").get<double>();
+        }
+        if (jcfg.contains("sojourn_ki")) {
+            raw.sojourn_ki = jcfg.at("sojourn_ki").get<double>();
+        }
+        if (jcfg.contains("hill_climb_window_ms")) {
+            raw.hill_climb_window_ms = jcfg.at("hill_climb_window_ms").get<std::size_t>();
+        }
+        if (jcfg.contains("max_blocking_threads")) {
+            raw.max_blocking_threads = jcfg.at("max_blocking_threads").get<std::size_t>();
+        }
+        if (jcfg.contains("queue_block_timeout_ms")) {
+            raw.queue_block_timeout_ms = jcfg.at("queue_block_timeout_ms").get<std::size_t>();
+        }
+        if (jcfg.contains("queue_backend")) {
+            raw.queue_backend = jcfg.at("queue_backend").get<std::string>();
+        }
+        if (jcfg.contains("single_submitter")) {
+            raw.single_submitter = jcfg.at("single_submitter").get<bool>();
+        }
+        if (jcfg.contains("queue_shards")) {
+            raw.queue_shards = jcfg.at("queue_shards").get<std::size_t>();
+        }
+        if (jcfg.contains("queue_routing")) {
+            raw.queue_routing = jcfg.at("queue_routing").get<std::string>();
+        }
 
         return raw;
     }
@@ -154,11 +222,67 @@ namespace thread_pool {
             return QueueFullPolicy::Discard;
         } else if (policy == "Overwrite") {
             return QueueFullPolicy::Overwrite;
+        } else if (policy == "CallerRuns") {
+            return QueueFullPolicy::CallerRuns;
+        } else if (policy == "BlockFor") {
+            return QueueFullPolicy::BlockFor;
         } else {
             throw std::invalid_argument("Invalid queue_policy: " + policy);
         }
     }
 
+    SchedulingMode ThreadPoolConfigLoader::ParseScheduling(const std::string& mode) {
+        if (mode == "Shared") {
+            return SchedulingMode::Shared;
+        } else if (mode == "WorkStealing") {
+            return SchedulingMode::WorkStealing;
+        } else {
+            throw std::invalid_argument("Invalid scheduling_mode: " + mode);
+        }
+    }
+
+    IdleStrategy ThreadPoolConfigLoader::ParseIdleStrategy(const std::string& strategy) {
+        if (strategy == "Park") {
+            return IdleStrategy::Park;
+        } else if (strategy == "SpinThenPark") {
+            return IdleStrategy::SpinThenPark;
+        } else {
+            throw std::invalid_argument("Invalid idle_strategy: " + strategy);
+        }
+    }
+
+    AutoscaleMode ThreadPoolConfigLoader::ParseAutoscaleMode(const std::string& mode) {
+        if (mode == "Thresholds") {
+            return AutoscaleMode::Thresholds;
+        } else if (mode == "Sojourn") {
+            return AutoscaleMode::Sojourn;
+        } else if (mode == "HillClimb") {
+            return AutoscaleMode::HillClimb;
+        } else {
+            throw std::invalid_argument("Invalid autoscale_mode: " + mode);
+        }
+    }
+
+    QueueBackend ThreadPoolConfigLoader::ParseQueueBackend(const std::string& backend) {
+        if (backend == "Bounded") {
+            return QueueBackend::Bounded;
+        } else if (backend == "Segmented") {
+            return QueueBackend::Segmented;
+        } else {
+            throw std::invalid_argument("Invalid queue_backend: " + backend);
+        }
+    }
+
+    QueueRouting ThreadPoolConfigLoader::ParseQueueRouting(const std::string& routing) {
+        if (routing == "Home") {
+            return QueueRouting::Home;
+        } else if (routing == "TwoChoice") {
+            return QueueRouting::TwoChoice;
+        } else {
+            throw std::invalid_argument("Invalid queue_routing: " + routing);
+        }
+    }
+
     // Validation/Normalization layer
     ThreadPoolConfig ThreadPoolConfigLoader::Normalize(const RawConfig& raw) {
         ThreadPoolConfig cfg;
@@ -200,12 +324,80 @@ namespace thread_pool {
         if (raw.queue_policy.has_value()) {
             cfg.queue_policy = ParsePolicy(raw.queue_policy.value());
         }
+        if (raw.scheduling_mode.has_value()) {
+            cfg.scheduling = ParseScheduling(raw.scheduling_mode.value());
+        }
+        if (raw.local_queue_cap.has_value()) {
+            cfg.local_queue_cap = raw.local_queue_cap.value();
+        }
+        if (raw.idle_strategy.has_value()) {
+            cfg.idle_strategy = ParseIdleStrategy(raw.idle_strategy.value());
+        }
+        if (raw.idle_spin_max.has_value()) {
+            cfg.idle_spin_max = raw.idle_spin_max.value();
+        }
+        if (raw.idle_yield_count.has_value()) {
+            cfg.idle_yield_count = raw.idle_yield_count.value();
+        }
+        if (raw.max_spinning_workers.has_value()) {
+            cfg.max_spinning_workers = raw.max_spinning_workers.value();
+        }
+        if (raw.priority_lane_cap.has_value()) {
+            cfg.priority_lane_cap = raw.priority_lane_cap.value();
+        }
+        if (raw.priority_aging.has_value()) {
+            cfg.priority_aging = raw.priority_aging.value();
+        }
+        if (raw.timer_tick_us.has_value()) {
+            cfg.timer_tick = std::chrono::microseconds(raw.timer_tick_us.value());
+        }
+        if (raw.autoscale_mode.has_value()) {
+            cfg.autoscale_mode = ParseAutoscaleMode(raw.autoscale_mode.value());
+        }
+        if (raw.sojourn_target_us.has_value()) {
+            cfg.sojourn_target = std::chrono::microseconds(raw.sojourn_target_us.value());
+        }
+        if (raw.sojourn_kp.has_value()) {
+            cfg.sojourn_kp = raw.sojourn_kp.value();
+        }
+        if (raw.sojourn_ki.has_value()) {
+            cfg.sojourn_ki = raw.sojourn_ki.value();
+        }
+        if (raw.hill_climb_window_ms.has_value()) {
+            cfg.hill_climb_window = std::chrono::milliseconds(raw.hill_climb_window_ms.value());
+        }
+        if (raw.max_blocking_threads.has_value()) {
+            cfg.max_blocking_threads = raw.max_blocking_threads.value();
+        }
+        if (raw.queue_block_timeout_ms.has_value()) {
+            cfg.queue_block_timeout = std::chrono::milliseconds(raw.queue_block_timeout_ms.value());
+        }
+        if (raw.queue_backend.has_value()) {
+            cfg.queue_backend = ParseQueueBackend(raw.queue_backend.value());
+        }
+        if (raw.single_submitter.has_value()) {
+            cfg.single_submitter = raw.single_submitter.value();
+        }
+        if (raw.queue_shards.has_value()) {
+            cfg.queue_shards = raw.queue_shards.value();
+        }
+        if (raw.queue_routing.has_value()) {
+            cfg.queue_routing = ParseQueueRouting(raw.queue_routing.value());
+        }
 
         // Sanity adjustments
         cfg.core_threads = std::max<std::size_t>(1, cfg.core_threads);
         cfg.max_threads = std::max(cfg.core_threads, cfg.max_threads);
         cfg.pending_low = std::min(cfg.pending_hi, cfg.pending_low);
         cfg.debounce_hits = std::max<std::size_t>(1, cfg.debounce_hits);
+        cfg.local_queue_cap = std::max<std::size_t>(2, cfg.local_queue_cap);
+        cfg.queue_shards = std::max<std::size_t>(1, cfg.queue_shards);
+        cfg.priority_lane_cap = std::max<std::size_t>(2, cfg.priority_lane_cap);
+        cfg.timer_tick = std::max(std::chrono::microseconds{1}, cfg.timer_tick);
+        cfg.sojourn_target = std::max(std::chrono::microseconds{1}, cfg.sojourn_target);
+        cfg.sojourn_kp = std::max(0.0, cfg.sojourn_kp);
+        cfg.sojourn_ki = std::max(0.0, cfg.sojourn_ki);
+        cfg.hill_climb_window = std::max(cfg.load_check_interval, cfg.hill_climb_window);  // at least one balancer tick
         return cfg;
     }
 
@@ -240,9 +432,7 @@ namespace thread_pool {
         jcfg["load_check_interval_ms"] = cfg.load_check_interval.count();
         jcfg["keep_alive_ms"] = cfg.keep_alive.count();
         jcfg["scale_up_threshold"] = cfg.scale_up_threshold;
-        jcfg["scale_down_threshold"] = cfg.scale_down_threshold;
         jcfg["pending_hi"] = cfg.pending_hi;
-        jcfg["pending_low"] = cfg.pending_low;
         jcfg["debounce_hits"] = cfg.debounce_hits;
         jcfg["cooldown_ms"] = cfg.cooldown.count();
         switch (cfg.queue_policy) {
@@ -255,6 +445,70 @@ namespace thread_pool {
             case QueueFullPolicy::Overwrite:
                 jcfg["queue_policy"] = "Overwrite";
                 break;
+            case QueueFullPolicy::CallerRuns:
+                jcfg["queue_policy"] = "CallerRuns";
+                break;
+            case QueueFullPolicy::BlockFor:
+                jcfg["queue_policy"] = "BlockFor";
+                break;
+        }
+        switch (cfg.scheduling) {
+            case SchedulingMode::Shared:
+                jcfg["scheduling_mode"] = "Shared";
+                break;
+            case SchedulingMode::WorkStealing:
+                jcfg["scheduling_mode"] = "WorkStealing";
+                break;
+        }
+        jcfg["local_queue_cap"] = cfg.local_queue_cap;
+        switch (cfg.idle_strategy) {
+            case IdleStrategy::Park:
+                jcfg["idle_strategy"] = "Park";
+                break;
+            case IdleStrategy::SpinThenPark:
+                jcfg["idle_strategy"] = "SpinThenPark";
+                break;
+        }
+        jcfg["idle_spin_max"] = cfg.idle_spin_max;
+        jcfg["idle_yield_count"] = cfg.idle_yield_count;
+        jcfg["max_spinning_workers"] = cfg.max_spinning_workers;
+        jcfg["priority_lane_cap"] = cfg.priority_lane_cap;
+        jcfg["priority_aging"] = cfg.priority_aging;
+        jcfg["timer_tick_us"] = cfg.timer_tick.count();
+        switch (cfg.autoscale_mode) {
+            case AutoscaleMode::Thresholds:
+                jcfg["autoscale_mode"] = "Thresholds";
+                break;
+            case AutoscaleMode::Sojourn:
+                jcfg["autoscale_mode"] = "Sojourn";
+                break;
+            case AutoscaleMode::HillClimb:
+                jcfg["autoscale_mode"] = "HillClimb";
+                break;
+        }
+        jcfg["sojourn_target_us"] = cfg.sojourn_target.count();
+        jcfg["sojourn_kp"] = cfg.sojourn_kp;
+        jcfg["sojourn_ki"] = cfg.sojourn_ki;
+        jcfg["hill_climb_window_ms"] = cfg.hill_climb_window.count();
+        jcfg["max_blocking_threads"] = cfg.max_blocking_threads;
+        jcfg["queue_block_timeout_ms"] = cfg.queue_block_timeout.count();
+        switch (cfg.queue_backend) {
+            case QueueBackend::Bounded:
+                jcfg["queue_backend"] = "Bounded";
+                break;
+            case QueueBackend::Segmented:
+                jcfg["queue_backend"] = "Segmented";
+                break;
+        }
+        jcfg["single_submitter"] = cfg.single_submitter;
+        jcfg["queue_shards"] = cfg.queue_shards;
+        switch (cfg.queue_routing) {
+            case QueueRouting::Home:
+                jcfg["queue_routing"] = "Home";
+                break;
+            case QueueRouting::TwoChoice:
+                jcfg["queue_routing"] = "TwoChoice";
+                break;
         }
         return jcfg;
     }
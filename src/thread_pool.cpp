@@ -1,5 +1,6 @@
 #include "thread_pool/fwd.hpp"
 #include "thread_pool/thread_pool.hpp"
+#include "thread_pool/hill_climber.hpp"
 #include "mpmc/blocking_queue_adapter.hpp"
 #include "logger.hpp"
 
@@ -9,6 +10,17 @@
 #include <utility>
 #include <chrono>
 #include <string>
+#include <algorithm>
+#include <iterator>
+#include <cmath>
+#include <thread>
+#include <ctime>
+#include <cstdlib>
+#include <fstream>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <intrin.h>
+#endif
 
 namespace thread_pool {
 namespace {
@@ -18,11 +30,96 @@ long long ToMilliseconds(Duration duration) noexcept {
     return std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
 }
 
+// Work-stealing idle workers park on the shared queue with exponential backoff,
+// then probe the other deques again
+constexpr std::chrono::microseconds kStealParkMin{100};
+constexpr std::chrono::microseconds kStealParkMax{5000};
+
+// SpinThenPark: the adaptive budget never drops below this many pause iterations
+constexpr std::size_t kSpinBudgetMin = 32;
+
+// Workers needed to keep up with `arrival_per_s` tasks of `service_s` each (Little's law:
+// busy workers = arrival rate x service time), plus enough to clear `pending` within `drain_s`
+inline std::size_t LittleLawWorkers(double arrival_per_s, double service_s, std::size_t pending, double drain_s) noexcept {
+    const double steady = arrival_per_s * service_s;
+    const double backlog = drain_s > 0.0 ? static_cast<double>(pending) * service_s / drain_s : 0.0;
+    const double need = std::ceil(steady + backlog);
+    return need >= 1e9 ? static_cast<std::size_t>(1e9) : static_cast<std::size_t>(need);
 }
 
+// Weight of the newest window in the smoothed queue wait
+constexpr double kQueueWaitEwmaAlpha = 0.3;
+
+// PI controller for AutoscaleMode::Sojourn. The error is the relative distance of the smoothed
+// queue wait from its target; the output is the share of the core..max range to run
+struct SojournPi {
+    double integral{0.0};
+    double Update(double error, double dt_s, double kp, double ki) noexcept {
+        integral = std::clamp(integral + ki * error * dt_s, 0.0, 1.0);  // clamped, so no wind-up
+        return std::clamp(kp * error + integral, 0.0, 1.0);
+    }
+};
+
+// HillClimb: windows kept for Statistics, and the share of the CPU quota above which the
+// process counts as CPU-bound (more workers would only be throttled)
+constexpr std::size_t kTunerSamples = 16;
+constexpr double      kCpuBoundShare = 0.9;
+
+// CPUs this process may use: the cgroup quota (v2 cpu.max, else v1 cfs quota/period) when
+// one is set, otherwise the hardware thread count
+double CpuQuota() {
+    const double hardware = static_cast<double>(std::max(1u, std::thread::hardware_concurrency()));
+    double quota = 0.0;
+    std::string max;
+    double period = 0.0;
+    std::ifstream v2("/sys/fs/cgroup/cpu.max");
+    if (v2 >> max >> period) {
+        if (max != "max" && period > 0.0) {
+            quota = std::strtod(max.c_str(), nullptr) / period;
+        }
+    } else {
+        std::ifstream quota_us("/sys/fs/cgroup/cpu/cpu.cfs_quota_us");
+        std::ifstream period_us("/sys/fs/cgroup/cpu/cpu.cfs_period_us");
+        double q = 0.0;
+        if (quota_us >> q && period_us >> period && q > 0.0 && period > 0.0) {
+            quota = q / period;
+        }
+    }
+    return quota > 0.0 ? std::min(hardware, quota) : hardware;
+}
+
+// Normal-lane storage for a config: Segmented wins, then sharding, then the submitter's ring
+QueueStorage NormalLaneStorage(const ThreadPoolConfig& cfg) noexcept {
+    if (cfg.queue_backend == QueueBackend::Segmented) {
+        return QueueStorage::Segmented;
+    }
+    if (cfg.queue_shards > 1) {
+        return QueueStorage::Sharded;
+    }
+    return cfg.single_submitter ? QueueStorage::OwnerRing : QueueStorage::Ring;
+}
+
+inline void CpuRelax() noexcept {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_pause();
+#elif defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield" ::: "memory");
+#endif
+}
+
+}
+
+thread_local const ThreadPool* ThreadPool::tls_pool_ = nullptr;
+thread_local ThreadPool::WorkerSlot* ThreadPool::tls_worker_ = nullptr;
+
 ThreadPool::ThreadPool(std::size_t threads_count, std::size_t queue_cap) 
     : state_(PoolState::CREATED)
-    , queue_(queue_cap)
+    , queue_(queue_cap, lane_ready_)
+    , high_lane_(ThreadPoolConfig{}.priority_lane_cap, lane_ready_)
+    , low_lane_(ThreadPoolConfig{}.priority_lane_cap, lane_ready_)
+    , priority_aging_(ThreadPoolConfig{}.priority_aging)
     , workers_()
     , policy_(QueueFullPolicy::Block)
 {
@@ -31,11 +128,15 @@ ThreadPool::ThreadPool(std::size_t threads_count, std::size_t queue_cap)
     load_check_interval_  = std::chrono::milliseconds{100};           // Load balancer sampling interval
     keep_alive_           = std::chrono::milliseconds{5000};          // Idle thread keep-alive time
     scale_up_threshold_   = 0.75;                                     // Busy ratio upper bound; scale up when exceeded
-    scale_down_threshold_ = 0.25;                                     // Busy ratio lower bound; scale down when below
     pending_hi_           = queue_cap / 2;                            // Pending threshold (upper)
-    pending_low_          = std::max<std::size_t>(1, queue_cap / 8);  // Pending threshold (lower)
     debounce_hits_        = 3;                                        // Debounce hits for scale up/down
     cooldown_             = std::chrono::milliseconds{500};           // Cooldown after capacity change
+    timer_origin_         = std::chrono::steady_clock::now();         // Timer tick 0
+    timer_tick_           = ThreadPoolConfig{}.timer_tick;            // Timing wheel resolution
+    thread_cap_.store(max_threads_, std::memory_order_relaxed);        // Only the Sojourn/HillClimb controllers lower it
+    thread_floor_.store(core_threads_, std::memory_order_relaxed);     // Only HillClimb moves it
+    max_blocking_threads_ = ThreadPoolConfig{}.max_blocking_threads;   // BlockingRegion compensation cap
+    block_timeout_        = ThreadPoolConfig{}.queue_block_timeout;    // BlockFor wait bound
     const auto policy = policy_.load(std::memory_order_relaxed);
 
     TP_LOG_DEBUG("ThreadPool constructed (direct): core_threads={} max_threads={} queue_cap={} policy={}",
@@ -44,24 +145,64 @@ ThreadPool::ThreadPool(std::size_t threads_count, std::size_t queue_cap)
 
 ThreadPool::ThreadPool(const ThreadPoolConfig& cfg)
     : state_(PoolState::CREATED)
-    , queue_(cfg.queue_cap)
+    , queue_(cfg.queue_cap, lane_ready_, NormalLaneStorage(cfg), cfg.queue_shards,
+             cfg.queue_routing == QueueRouting::TwoChoice ? ShardRouting::TwoChoice : ShardRouting::Home)
+    , high_lane_(cfg.priority_lane_cap, lane_ready_)
+    , low_lane_(cfg.priority_lane_cap, lane_ready_)
+    , priority_aging_(cfg.priority_aging)
     , workers_()
     , policy_(cfg.queue_policy)
+    , scheduling_(cfg.scheduling)
 {
     core_threads_         = std::max<std::size_t>(1, cfg.core_threads);   // Default core threads equals configured value
     max_threads_          = std::max(core_threads_, cfg.max_threads);     // Ensure max >= core
     load_check_interval_  = cfg.load_check_interval;                      // Load balancer sampling interval
     keep_alive_           = cfg.keep_alive;                               // Idle thread keep-alive time
     scale_up_threshold_   = cfg.scale_up_threshold;                       // Busy ratio upper bound; scale up when exceeded
-    scale_down_threshold_ = cfg.scale_down_threshold;                     // Busy ratio lower bound; scale down when below
     pending_hi_           = cfg.pending_hi;                               // Pending threshold (upper)
-    pending_low_          = std::min(cfg.pending_hi, cfg.pending_low);    // Pending threshold (lower)
     debounce_hits_        = std::max<std::size_t>(1, cfg.debounce_hits);  // Debounce hits
     cooldown_             = cfg.cooldown;                                 // Cooldown after capacity change
+    idle_strategy_        = cfg.idle_strategy;                            // Worker idle strategy
+    idle_spin_max_        = cfg.idle_spin_max;                            // Spin budget upper bound
+    idle_yield_count_     = cfg.idle_yield_count;                         // Yield rounds before parking
+    max_spinning_workers_ = cfg.max_spinning_workers;                     // Concurrent spinner cap
+    timer_origin_         = std::chrono::steady_clock::now();             // Timer tick 0
+    timer_tick_           = std::max<std::chrono::steady_clock::duration>(  // Timing wheel resolution
+                                std::chrono::microseconds{1}, cfg.timer_tick);
+    autoscale_mode_       = cfg.autoscale_mode;                           // Load balancer controller
+    sojourn_target_       = std::max<std::chrono::nanoseconds>(           // Sojourn: target queue wait
+                                std::chrono::microseconds{1}, cfg.sojourn_target);
+    sojourn_kp_           = std::max(0.0, cfg.sojourn_kp);                // Sojourn: proportional gain
+    sojourn_ki_           = std::max(0.0, cfg.sojourn_ki);                // Sojourn: integral gain
+    hill_climb_window_    = std::max(load_check_interval_, cfg.hill_climb_window);  // HillClimb: at least one tick
+    thread_cap_.store(max_threads_, std::memory_order_relaxed);            // Only the Sojourn/HillClimb controllers lower it
+    thread_floor_.store(core_threads_, std::memory_order_relaxed);         // Only HillClimb moves it
+    max_blocking_threads_ = cfg.max_blocking_threads;                      // BlockingRegion compensation cap
+    block_timeout_        = cfg.queue_block_timeout;                       // BlockFor wait bound
+    if (autoscale_mode_ == AutoscaleMode::HillClimb) {
+        cpu_quota_ = CpuQuota();
+        TP_LOG_DEBUG("HillClimb: CPU quota {:.2f}", cpu_quota_);
+    }
     const auto policy = policy_.load(std::memory_order_relaxed);
+#if !TP_LATENCY_HISTOGRAMS
+    if (autoscale_mode_ == AutoscaleMode::Sojourn) {
+        // Without enqueue stamps the queue wait is either 0 or a whole interval: nothing to steer on
+        TP_LOG_WARN("autoscale_mode=Sojourn needs TP_LATENCY_HISTOGRAMS for queue wait; using Thresholds");
+        autoscale_mode_ = AutoscaleMode::Thresholds;
+    }
+#endif
+
+    if (scheduling_ == SchedulingMode::WorkStealing) {
+        // One deque per worker index; slots borrow them so thieves never touch freed memory
+        local_queues_.reserve(max_threads_);
+        for (std::size_t i = 0; i < max_threads_; ++i) {
+            local_queues_.push_back(std::make_unique<WorkStealingDeque<Task>>(cfg.local_queue_cap));
+        }
+    }
     
-    TP_LOG_DEBUG("ThreadPool constructed (config): core_threads={} max_threads={} queue_cap={} policy={}",
-                 core_threads_, max_threads_, queue_.Capacity(), policy);
+    TP_LOG_DEBUG("ThreadPool constructed (config): core_threads={} max_threads={} queue_cap={} backend={} single_submitter={} shards={} routing={} policy={} scheduling={} idle={} autoscale={}",
+                 core_threads_, max_threads_, queue_.Capacity(), cfg.queue_backend, queue_.OwnerRing(), queue_.Shards(),
+                 cfg.queue_routing, policy, scheduling_, idle_strategy_, autoscale_mode_);
 }
 
 ThreadPool::~ThreadPool () {
@@ -91,18 +232,18 @@ void ThreadPool::Start() {
         std::lock_guard<std::mutex> lk(workers_mu_);
         workers_.reserve(max_threads_); // Reserve up to max threads to avoid frequent reallocation
         current_threads_.store(0, std::memory_order_relaxed);
-        active_threads_.store(0, std::memory_order_relaxed);
         for  (std::size_t i = 0; i < core_threads_; ++i) {
             CreateWorkerUnlocked();
         }
     }
     balancer_stop_.store(false, std::memory_order_release); // Enable dynamic load balancing
     LaunchLoadBalancer();
+    BindSubmitter();
     const auto current_policy = policy_.load(std::memory_order_relaxed);
-    TP_LOG_INFO("ThreadPool started with {} workers (policy={}, pending_hi={}, pending_low={})",
+    TP_LOG_INFO("ThreadPool started with {} workers (policy={}, pending_hi={})",
                 current_threads_.load(std::memory_order_relaxed),
                 current_policy,
-                pending_hi_, pending_low_);
+                pending_hi_);
 }
 
 void ThreadPool::Stop(StopMode mode) {
@@ -148,16 +289,14 @@ void ThreadPool::Stop(StopMode mode) {
     }
 
     // Wake all paused producers/consumers
-    {
-        std::lock_guard<std::mutex> lk(pause_mtx_);
-        pause_cv_.notify_all();
-    }
+    pause_gate_.NotifyAll();
 
     // Shutdown: graceful / force
     PoolState cur = state_.load(std::memory_order_acquire);
     TP_LOG_DEBUG("ThreadPool stop entering phase {}", cur);
 
     if (cur == PoolState::SHUTTING_DOWN) {
+        DrainSubmitBuffers(true);  // buffered Posts were accepted by their caller; queue them before the drain
         TP_LOG_INFO("ThreadPool graceful shutdown: waiting for {} submissions in-flight", submit_ing_.load(std::memory_order_acquire));
         // Drain in-flight submissions
         {
@@ -169,24 +308,33 @@ void ThreadPool::Stop(StopMode mode) {
         TP_LOG_INFO("ThreadPool submissions drained, waiting for {} pending / {} active tasks",
                     Pending(), ActiveTasks());
         // All submissions done; wait for execution to complete
+        // Workers only signal once they see SHUTTING_DOWN, so poll as a backstop
         {
             std::unique_lock<std::mutex> lk(drain_mtx_);
-            drain_cv_.wait(lk, [this] {
+            while (!drain_cv_.wait_for(lk, std::chrono::milliseconds(10), [this] {
                 return Pending() == 0 && ActiveTasks() == 0;
-            });
+            })) {}
         }
+        high_lane_.Close();
+        low_lane_.Close();
         queue_.Close();
         TP_LOG_INFO("ThreadPool queue closed after graceful drain");
     } else if (cur == PoolState::FORCE_STOPPING) {
+        DrainSubmitBuffers(false);
         const auto pending = Pending();
         TP_LOG_WARN("ThreadPool force stop: cancelling {} pending tasks", pending);
-        // Force clear the queue
-        queue_.Clear([&](TaskPtr& t) {
+        // Force clear every lane
+        auto cancel = [&](Task& t) {
             if (t) {
                 t->Cancel(std::make_exception_ptr(std::runtime_error("force stopped")));
                 RecordTaskCancel();
             }
-        });
+        };
+        high_lane_.Clear(cancel);
+        queue_.Clear(cancel);
+        low_lane_.Clear(cancel);
+        high_lane_.Close();
+        low_lane_.Close();
         queue_.Close();
         TP_LOG_WARN("ThreadPool queue cleared; {} tasks marked cancelled", pending);
     } else if (cur == PoolState::STOPPED) {
@@ -194,6 +342,10 @@ void ThreadPool::Stop(StopMode mode) {
         return;
     }
 
+    // Timers not yet due and firings still waiting for a lane are dropped; firings after the
+    // state change were already rejected
+    StopTimerThread();
+
     // Stop dynamic load balancing
     StopLoadBalancer();
 
@@ -202,6 +354,10 @@ void ThreadPool::Stop(StopMode mode) {
     {
         std::lock_guard<std::mutex> lk(workers_mu_);
         to_join.swap(workers_); // Take ownership of all worker slots
+        for (auto& slot : exited_workers_) {
+            to_join.push_back(std::move(slot));
+        }
+        exited_workers_.clear();
     }
     const auto self = std::this_thread::get_id(); // Avoid self-join deadlock
     for (auto& slot : to_join) {
@@ -241,47 +397,72 @@ void ThreadPool::ShutDown(ShutDownOption opt, std::chrono::milliseconds timeout)
     }
 }
 
-void ThreadPool::Post(std::function<void()> f) {
+void ThreadPool::Post(TaskFunction<void()> f) {
+    Post(TaskPriority::Normal, std::move(f));
+}
+
+void ThreadPool::Post(TaskPriority priority, TaskFunction<void()> f) {
     // Use lightweight SimpleTask to avoid future overhead
-    auto task_ptr = std::make_unique<SimpleTask>(std::move(f));
+    Dispatch(Task::Make<SimpleTask>(std::move(f)), priority);
+}
+
+bool ThreadPool::Dispatch(Task task_ptr, TaskPriority priority, Task* caller_runs) {
+#if TP_LATENCY_HISTOGRAMS
+    task_ptr.StampSubmitted(LatencyClockNs());
+#endif
     
     // Fast state check
+    bool waited_in_pause = false;
     for (;;) {
         PoolState s = state_.load(std::memory_order_acquire);
         if (s == PoolState::RUNNING) {
             break;
         }
         if (s == PoolState::PAUSED) {
-            std::unique_lock<std::mutex> lk(pause_mtx_);
             paused_wait_cnt_.fetch_add(1, std::memory_order_relaxed);
-            pause_cv_.wait(lk, [this] {
-                auto t = state_.load(std::memory_order_acquire);
-                return t != PoolState::PAUSED;
-            });
+            ParkWhilePaused();
+            waited_in_pause = true;
             continue;
         }
         // Other states: reject the submission
         RecordTaskRejected();
-        return;
+        return false;
+    }
+#if TP_LATENCY_HISTOGRAMS
+    if (waited_in_pause) {
+        task_ptr.StampEnqueued(LatencyClockNs()); // time parked behind Pause() is not queue wait
     }
+#else
+    (void)waited_in_pause;
+#endif
 
+    // Normal tasks posted from one of our workers stay on its local deque
+    if (priority == TaskPriority::Normal && TryPushLocal(task_ptr)) {
+        total_submitted_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return Enqueue(std::move(task_ptr), priority, caller_runs);
+}
+
+bool ThreadPool::Enqueue(Task task_ptr, TaskPriority priority, Task* caller_runs) {
     // Dispatch by queue policy
+    auto& lane = Lane(priority);
     const auto policy = policy_.load(std::memory_order_relaxed);
     bool success = false;
     
     switch (policy) {
         case QueueFullPolicy::Block:
-            success = queue_.WaitPush(std::move(task_ptr));
+            success = lane.WaitPush(std::move(task_ptr));
             break;
         case QueueFullPolicy::Discard:
-            success = queue_.TryPush(std::move(task_ptr));
+            success = lane.TryPush(std::move(task_ptr));
             if (!success) {
                 discard_cnt_.fetch_add(1, std::memory_order_relaxed);
             }
             break;
         case QueueFullPolicy::Overwrite: {
-            TaskPtr overwritten;
-            success = queue_.OverwritePush(std::move(task_ptr), &overwritten);
+            Task overwritten;
+            success = lane.OverwritePush(std::move(task_ptr), &overwritten);
             if (overwritten) {
                 overwritten->Cancel(std::make_exception_ptr(
                     std::runtime_error("ThreadPool::Post: overwritten")
@@ -289,11 +470,36 @@ void ThreadPool::Post(std::function<void()> f) {
                 RecordTaskCancel();
                 overwrite_cnt_.fetch_add(1, std::memory_order_relaxed);
             }
-            if (!success) {
+            break;
+        }
+        case QueueFullPolicy::CallerRuns:
+            for (;;) {
+                success = lane.TryPush(std::move(task_ptr));
+                if (success || lane.Closed()) {
+                    break;
+                }
+                if (!TryBeginInline()) {
+                    // Paused: no task may start, inline ones included; the lane may have room after
+                    paused_wait_cnt_.fetch_add(1, std::memory_order_relaxed);
+                    ParkWhilePaused();
+                    continue;
+                }
+                if (caller_runs != nullptr) {
+                    caller_runs_cnt_.fetch_add(1, std::memory_order_relaxed);
+                    *caller_runs = std::move(task_ptr);
+                    InlineStarted();
+                    return false;
+                }
+                RunInCaller(task_ptr);
+                return true;
+            }
+            break;
+        case QueueFullPolicy::BlockFor:
+            success = lane.WaitPushFor(std::move(task_ptr), block_timeout_);
+            if (!success && !lane.Closed()) {
                 discard_cnt_.fetch_add(1, std::memory_order_relaxed);
             }
             break;
-        }
     }
     
     if (success) {
@@ -301,12 +507,543 @@ void ThreadPool::Post(std::function<void()> f) {
     } else {
         RecordTaskRejected();
     }
+    return success;
+}
+
+std::size_t ThreadPool::DispatchBatch(std::vector<Task>& tasks) {
+    // From a worker thread, fill the local deque first
+    auto first = tasks.begin();
+    while (first != tasks.end() && TryPushLocal(*first)) {
+        ++first;
+    }
+    const auto local = static_cast<std::size_t>(std::distance(tasks.begin(), first));
+    std::size_t pushed = local + queue_.TryPushBatch(first, tasks.end());
+    first = tasks.begin() + static_cast<std::ptrdiff_t>(pushed);
+
+    // TryPushBatch stops at the first full slot and leaves the rest untouched
+    std::size_t inline_runs = 0;
+    switch (policy_.load(std::memory_order_relaxed)) {
+        case QueueFullPolicy::CallerRuns:
+            while (first != tasks.end() && !queue_.Closed()) {
+                if (queue_.TryPush(std::move(*first))) {
+                    ++pushed;
+                } else if (TryBeginInline()) {
+                    RunInCaller(*first);
+                    ++inline_runs;
+                } else {
+                    paused_wait_cnt_.fetch_add(1, std::memory_order_relaxed);
+                    ParkWhilePaused();
+                    continue;  // retry the push once the pool resumes
+                }
+                ++first;
+            }
+            if (first != tasks.end()) {
+                // The queue closed under us: neither queued nor run
+                total_rejected_.fetch_add(static_cast<std::size_t>(std::distance(first, tasks.end())),
+                                          std::memory_order_relaxed);
+            }
+            break;
+        case QueueFullPolicy::BlockFor: {
+            const auto deadline = std::chrono::steady_clock::now() + block_timeout_;
+            for (; first != tasks.end(); ++first) {
+                const auto left = std::max(std::chrono::steady_clock::duration::zero(),
+                                           deadline - std::chrono::steady_clock::now());
+                if (!queue_.WaitPushFor(std::move(*first), left)) {
+                    break;
+                }
+                ++pushed;
+            }
+            if (first != tasks.end() && !queue_.Closed()) {
+                discard_cnt_.fetch_add(static_cast<std::size_t>(std::distance(first, tasks.end())),
+                                       std::memory_order_relaxed);
+            }
+            break;
+        }
+        default:
+            break;  // Block/Discard/Overwrite: whatever did not fit is dropped
+    }
+
+    total_submitted_.fetch_add(pushed, std::memory_order_relaxed);
+    return pushed + inline_runs;
+}
+
+std::size_t ThreadPool::DispatchBuffered(std::vector<Task>& tasks) {
+    // Same gate as Dispatch, once for the whole batch
+    bool waited_in_pause = false;
+    for (;;) {
+        PoolState s = state_.load(std::memory_order_acquire);
+        if (s == PoolState::RUNNING) {
+            break;
+        }
+        if (s == PoolState::PAUSED) {
+            paused_wait_cnt_.fetch_add(1, std::memory_order_relaxed);
+            ParkWhilePaused();
+            waited_in_pause = true;
+            continue;
+        }
+        total_rejected_.fetch_add(tasks.size(), std::memory_order_relaxed);
+        return 0;
+    }
+#if TP_LATENCY_HISTOGRAMS
+    if (waited_in_pause) {
+        const auto now_ns = LatencyClockNs();
+        for (auto& task : tasks) {
+            task.StampEnqueued(now_ns);
+        }
+    }
+#else
+    (void)waited_in_pause;
+#endif
+    return EnqueueBuffered(tasks);
+}
+
+std::size_t ThreadPool::EnqueueBuffered(std::vector<Task>& tasks) {
+    buffer_flush_cnt_.fetch_add(1, std::memory_order_relaxed);
+    auto first = tasks.begin();
+    while (first != tasks.end() && TryPushLocal(*first)) {
+        ++first;
+    }
+    std::size_t queued = static_cast<std::size_t>(std::distance(tasks.begin(), first));
+    queued += queue_.TryPushBatch(first, tasks.end());
+    total_submitted_.fetch_add(queued, std::memory_order_relaxed);
+
+    // Unlike PostBatch, what did not fit gets Post's queue-full policy one task at a time
+    for (auto it = tasks.begin() + static_cast<std::ptrdiff_t>(queued); it != tasks.end(); ++it) {
+        if (Enqueue(std::move(*it), TaskPriority::Normal, nullptr)) {
+            ++queued;
+        }
+    }
+    return queued;
+}
+
+void ThreadPool::ArmBufferSweep(std::chrono::microseconds linger) {
+    const auto s = state_.load(std::memory_order_acquire);
+    if (s != PoolState::RUNNING && s != PoolState::PAUSED) {
+        return;  // not started, or stopping (Stop drains the buffers); the next Post tries again
+    }
+    std::lock_guard<std::mutex> lk(buffers_mu_);
+    const auto period = sweep_period_us_.load(std::memory_order_relaxed);
+    if (period != 0 && period <= linger.count()) {
+        return;
+    }
+    const auto id = AddFixedRate(linger, [this] { SweepSubmitBuffers(); }, TaskPriority::Normal, true);
+    if (id == 0) {
+        return;
+    }
+    if (sweep_timer_ != 0) {
+        CancelTimer(sweep_timer_);
+    }
+    sweep_timer_ = id;
+    sweep_period_us_.store(linger.count(), std::memory_order_relaxed);
+}
+
+void ThreadPool::SweepSubmitBuffers() {
+    if (State() != PoolState::RUNNING) {
+        return;  // Stop drains the buffers itself
+    }
+    const auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lk(buffers_mu_);
+    for (auto* buffer : submit_buffers_) {
+        // A buffer its owner holds is being posted to or flushed right now
+        std::unique_lock<std::mutex> buffer_lk(buffer->mu_, std::try_to_lock);
+        if (!buffer_lk.owns_lock() || buffer->tasks_.empty() || buffer->linger_.count() == 0
+            || now - buffer->first_ < buffer->linger_) {
+            continue;
+        }
+        // Never blocks and never runs a task here: a full lane keeps the rest for the next sweep
+        auto& tasks = buffer->tasks_;
+        const auto queued = queue_.TryPushBatch(tasks.begin(), tasks.end());
+        if (queued == 0) {
+            continue;
+        }
+        buffer_flush_cnt_.fetch_add(1, std::memory_order_relaxed);
+        total_submitted_.fetch_add(queued, std::memory_order_relaxed);
+        tasks.erase(tasks.begin(), tasks.begin() + static_cast<std::ptrdiff_t>(queued));
+        buffer->size_.store(tasks.size(), std::memory_order_relaxed);
+    }
+}
+
+void ThreadPool::DrainSubmitBuffers(bool enqueue) {
+    // Take the tasks out under the locks, queue them after: Enqueue may block under Block
+    std::vector<Task> drained;
+    {
+        std::lock_guard<std::mutex> lk(buffers_mu_);
+        for (auto* buffer : submit_buffers_) {
+            std::lock_guard<std::mutex> buffer_lk(buffer->mu_);
+            std::move(buffer->tasks_.begin(), buffer->tasks_.end(), std::back_inserter(drained));
+            buffer->tasks_.clear();
+            buffer->size_.store(0, std::memory_order_relaxed);
+        }
+    }
+    if (drained.empty()) {
+        return;
+    }
+    if (enqueue) {
+        EnqueueBuffered(drained);
+    } else {
+        total_rejected_.fetch_add(drained.size(), std::memory_order_relaxed);
+    }
+}
+
+ThreadPool::SubmitBuffer::SubmitBuffer(ThreadPool& pool, std::size_t capacity, std::chrono::microseconds linger)
+    : pool_(pool)
+    , capacity_(std::max<std::size_t>(1, capacity))
+    , linger_(std::max(std::chrono::microseconds::zero(), linger)) {
+    tasks_.reserve(capacity_);
+    std::lock_guard<std::mutex> lk(pool_.buffers_mu_);
+    pool_.submit_buffers_.push_back(this);
+}
+
+ThreadPool::SubmitBuffer::~SubmitBuffer() {
+    Flush();
+    std::lock_guard<std::mutex> lk(pool_.buffers_mu_);
+    auto& buffers = pool_.submit_buffers_;
+    buffers.erase(std::find(buffers.begin(), buffers.end(), this));
+    if (buffers.empty() && pool_.sweep_timer_ != 0) {
+        pool_.CancelTimer(pool_.sweep_timer_);  // an idle pool stops waking up for the sweep
+        pool_.sweep_timer_ = 0;
+        pool_.sweep_period_us_.store(0, std::memory_order_relaxed);
+    }
+}
+
+void ThreadPool::SubmitBuffer::Post(TaskFunction<void()> f) {
+    if (linger_.count() != 0) {
+        const auto period = pool_.sweep_period_us_.load(std::memory_order_relaxed);
+        if (period == 0 || period > linger_.count()) {
+            pool_.ArmBufferSweep(linger_);
+        }
+    }
+    auto task = Task::Make<SimpleTask>(std::move(f));
+#if TP_LATENCY_HISTOGRAMS
+    task.StampSubmitted(LatencyClockNs());  // time spent buffered counts as queue wait
+#endif
+    std::lock_guard<std::mutex> lk(mu_);
+    if (tasks_.empty()) {
+        first_ = std::chrono::steady_clock::now();
+    }
+    tasks_.push_back(std::move(task));
+    if (tasks_.size() >= capacity_) {
+        FlushLocked();
+    } else {
+        size_.store(tasks_.size(), std::memory_order_relaxed);
+    }
+}
+
+std::size_t ThreadPool::SubmitBuffer::Flush() {
+    std::lock_guard<std::mutex> lk(mu_);
+    return tasks_.empty() ? 0 : FlushLocked();
+}
+
+std::size_t ThreadPool::SubmitBuffer::Size() const noexcept {
+    return size_.load(std::memory_order_relaxed);
+}
+
+std::size_t ThreadPool::SubmitBuffer::FlushLocked() {
+    const auto queued = pool_.DispatchBuffered(tasks_);
+    tasks_.clear();
+    size_.store(0, std::memory_order_relaxed);
+    return queued;
+}
+
+void ThreadPool::RunInCaller(Task& task) noexcept {
+    caller_runs_cnt_.fetch_add(1, std::memory_order_relaxed);
+    InlineStarted();
+    task->Execute();
+}
+
+ThreadPool::TimerId ThreadPool::ScheduleAfter(std::chrono::steady_clock::duration delay,
+                                              TaskFunction<void()> f, TaskPriority priority) {
+    return ScheduleAt(std::chrono::steady_clock::now() + delay, std::move(f), priority);
+}
+
+ThreadPool::TimerId ThreadPool::ScheduleAt(std::chrono::steady_clock::time_point when,
+                                           TaskFunction<void()> f, TaskPriority priority) {
+    return AddTimer(TimerTick(when), TimerTask{std::move(f), priority}, nullptr);
+}
+
+ThreadPool::TimerId ThreadPool::ScheduleAtFixedRate(std::chrono::steady_clock::duration period,
+                                                    TaskFunction<void()> f, TaskPriority priority) {
+    return AddFixedRate(period, std::move(f), priority, false);
+}
+
+ThreadPool::TimerId ThreadPool::AddFixedRate(std::chrono::steady_clock::duration period,
+                                             TaskFunction<void()> f, TaskPriority priority, bool internal) {
+    auto periodic = std::make_shared<PeriodicTimer>();
+    periodic->fn = std::move(f);
+    periodic->internal = internal;
+    const auto tick = timer_tick_.count();
+    const auto span = std::max<std::chrono::steady_clock::rep>(period.count(), 1);
+    periodic->period_ticks = static_cast<std::uint64_t>((span + tick - 1) / tick);
+    const auto first = TimerTick(std::chrono::steady_clock::now() + period);
+    return AddTimer(first, TimerTask{TaskFunction<void()>{}, priority}, std::move(periodic));
+}
+
+bool ThreadPool::CancelTimer(TimerId id) {
+    std::lock_guard<std::mutex> lk(timer_mu_);
+    auto it = periodic_timers_.find(id);
+    if (it != periodic_timers_.end()) {
+        it->second->cancelled.store(true, std::memory_order_relaxed);
+        internal_timers_ -= it->second->internal ? 1 : 0;
+        periodic_timers_.erase(it);
+    }
+    return timers_.Cancel(id);
+}
+
+std::size_t ThreadPool::PendingTimers() const {
+    std::lock_guard<std::mutex> lk(timer_mu_);
+    return timers_.Size() - internal_timers_;
+}
+
+std::uint64_t ThreadPool::TimerTick(std::chrono::steady_clock::time_point when) const noexcept {
+    const auto since = (when - timer_origin_).count();
+    if (since <= 0) {
+        return 0;
+    }
+    const auto tick = timer_tick_.count();
+    return static_cast<std::uint64_t>((since + tick - 1) / tick);
+}
+
+ThreadPool::TimerId ThreadPool::AddTimer(std::uint64_t deadline, TimerTask task,
+                                         std::shared_ptr<PeriodicTimer> periodic) {
+    const bool internal = periodic && periodic->internal;
+    const auto s = state_.load(std::memory_order_acquire);
+    if (s != PoolState::RUNNING && s != PoolState::PAUSED) {
+        if (!internal) {
+            RecordTaskRejected();
+            TP_LOG_WARN("Schedule rejected: pool state={} (expected RUNNING or PAUSED)", s);
+        }
+        return TimingWheel<TimerTask>::kInvalidTimer;
+    }
+    std::lock_guard<std::mutex> lk(timer_mu_);
+    if (timer_stop_) {
+        if (!internal) {
+            RecordTaskRejected();
+        }
+        return TimingWheel<TimerTask>::kInvalidTimer;
+    }
+    const TimerId id = timers_.Add(deadline, std::move(task));
+    if (periodic) {
+        internal_timers_ += internal ? 1 : 0;
+        periodic_timers_.emplace(id, std::move(periodic));
+    }
+    if (!timer_thread_.joinable()) {
+        timer_thread_ = std::thread([this] { TimerLoop(); });
+    } else if (deadline < timer_wake_tick_) {
+        // Only an earlier deadline than the one the timer thread sleeps towards needs a wake-up
+        timer_wake_tick_ = deadline;
+        timer_cv_.notify_one();
+    }
+    return id;
+}
+
+void ThreadPool::TimerLoop() {
+    using Wheel = TimingWheel<TimerTask>;
+    std::vector<TimerFiring> due;                              // firings not yet in a lane, oldest first
+    std::vector<std::shared_ptr<PeriodicTimer>> internal_due;  // run right here, not queued
+    std::unique_lock<std::mutex> lk(timer_mu_);
+    while (!timer_stop_) {
+        const auto now = std::chrono::steady_clock::now();
+        const auto since = (now - timer_origin_).count();
+        const auto now_tick = since <= 0 ? 0 : static_cast<std::uint64_t>(since / timer_tick_.count());
+        const auto retries = due.size();
+        timers_.Advance(now_tick, [&](TimerId id, TimerTask& t, std::uint64_t deadline) -> std::uint64_t {
+            if (t.fn) {
+                due.push_back({Task::Make<SimpleTask>(std::move(t.fn)), t.priority, now});
+                return Wheel::kNever;
+            }
+            auto it = periodic_timers_.find(id);
+            if (it == periodic_timers_.end()) {
+                return Wheel::kNever;
+            }
+            auto& periodic = it->second;
+            if (periodic->internal) {
+                internal_due.push_back(periodic);
+            } else if (!periodic->outstanding.exchange(true, std::memory_order_acq_rel)) {
+                // The firing owns the outstanding flag until it has run or is dropped unrun
+                // (rejected, evicted, cancelled at Stop): whichever way its task is destroyed
+                struct Outstanding {
+                    std::shared_ptr<PeriodicTimer> timer;
+                    explicit Outstanding(std::shared_ptr<PeriodicTimer> p) noexcept : timer(std::move(p)) {}
+                    Outstanding(Outstanding&&) noexcept = default;
+                    ~Outstanding() {
+                        if (timer) {
+                            timer->outstanding.store(false, std::memory_order_release);
+                        }
+                    }
+                };
+                due.push_back({Task::Make<SimpleTask>([slot = Outstanding(periodic)]() mutable {
+                    if (!slot.timer->cancelled.load(std::memory_order_relaxed)) {
+                        slot.timer->fn();
+                    }
+                }), t.priority, now});
+            }
+            // Keep the phase; periods missed while the timer thread or the firing was behind are skipped
+            const auto period = periodic->period_ticks;
+            return deadline + period * ((now_tick - deadline) / period + 1);
+        });
+
+        const bool fired = due.size() != retries || !internal_due.empty();
+        if (!due.empty() || !internal_due.empty()) {
+            timer_wake_tick_ = 0;  // busy: AddTimer need not notify
+            lk.unlock();
+            for (auto& periodic : internal_due) {
+                periodic->fn();
+            }
+            internal_due.clear();
+            // Lanes that are full keep their firings here for the next tick, in order
+            due.erase(std::remove_if(due.begin(), due.end(),
+                                     [this](TimerFiring& firing) { return HandOverTimerTask(firing); }),
+                      due.end());
+            lk.lock();
+            if (fired) {
+                continue;  // dispatching took time; look again before sleeping
+            }
+        }
+
+        timer_wake_tick_ = timers_.NextTick();
+        if (!due.empty()) {
+            timer_wake_tick_ = std::min(timer_wake_tick_, now_tick + 1);
+        }
+        if (timer_wake_tick_ == Wheel::kNever) {
+            timer_cv_.wait(lk);
+        } else {
+            timer_cv_.wait_until(lk, timer_origin_ + timer_tick_ * static_cast<std::int64_t>(timer_wake_tick_));
+        }
+    }
+    // Firings still waiting for a full lane are dropped with the wheel
+    timer_unplaced_ = due.size();
+    total_rejected_.fetch_add(due.size(), std::memory_order_relaxed);
+}
+
+bool ThreadPool::HandOverTimerTask(TimerFiring& firing) {
+    const auto s = state_.load(std::memory_order_acquire);
+    if (s != PoolState::RUNNING && s != PoolState::PAUSED) {
+        RecordTaskRejected();
+        return true;
+    }
+#if TP_LATENCY_HISTOGRAMS
+    firing.task.StampSubmitted(LatencyClockNs());
+#endif
+    auto& lane = Lane(firing.priority);
+    if (lane.TryPush(std::move(firing.task))) {
+        total_submitted_.fetch_add(1, std::memory_order_relaxed);
+        timers_fired_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    if (lane.Closed()) {
+        RecordTaskRejected();
+        return true;
+    }
+    switch (policy_.load(std::memory_order_relaxed)) {
+        case QueueFullPolicy::Discard:
+            discard_cnt_.fetch_add(1, std::memory_order_relaxed);
+            RecordTaskRejected();
+            return true;
+        case QueueFullPolicy::Overwrite: {
+            Task overwritten;
+            if (!lane.OverwritePush(std::move(firing.task), &overwritten)) {
+                RecordTaskRejected();
+                return true;
+            }
+            if (overwritten) {
+                // Cancel() may resume a coroutine: leave it to the next worker between tasks
+                std::lock_guard<std::mutex> lk(timer_evicted_mu_);
+                timer_evicted_.push_back(std::move(overwritten));
+                timer_evicted_pending_.store(true, std::memory_order_release);
+                overwrite_cnt_.fetch_add(1, std::memory_order_relaxed);
+            }
+            total_submitted_.fetch_add(1, std::memory_order_relaxed);
+            timers_fired_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        case QueueFullPolicy::BlockFor:
+            if (std::chrono::steady_clock::now() - firing.due_at < block_timeout_) {
+                return false;
+            }
+            discard_cnt_.fetch_add(1, std::memory_order_relaxed);
+            RecordTaskRejected();
+            return true;
+        default:
+            // Block and CallerRuns: the timer thread neither waits for space nor runs user
+            // code, which would hold up every other timer; the firing waits for the next tick
+            return false;
+    }
+}
+
+void ThreadPool::CancelTimerEvicted() {
+    std::vector<Task> evicted;
+    {
+        std::lock_guard<std::mutex> lk(timer_evicted_mu_);
+        evicted.swap(timer_evicted_);
+        timer_evicted_pending_.store(false, std::memory_order_relaxed);
+    }
+    for (auto& task : evicted) {
+        task->Cancel(std::make_exception_ptr(std::runtime_error("ThreadPool::Post: overwritten")));
+        RecordTaskCancel();
+    }
+}
+
+void ThreadPool::StopTimerThread() {
+    {
+        std::lock_guard<std::mutex> lk(timer_mu_);
+        timer_stop_ = true;
+        timer_cv_.notify_all();
+    }
+    if (timer_thread_.joinable()) {
+        timer_thread_.join();
+    }
+    CancelTimerEvicted();  // workers may be gone or about to go
+    std::lock_guard<std::mutex> lk(timer_mu_);
+    const auto dropped = timers_.Size() - internal_timers_ + timer_unplaced_;
+    timers_.Clear();
+    periodic_timers_.clear();
+    internal_timers_ = 0;
+    timer_unplaced_ = 0;
+    if (dropped != 0) {
+        TP_LOG_INFO("ThreadPool stop dropped {} pending timers", dropped);
+    }
+}
+
+void ThreadPool::BindSubmitter() noexcept {
+    if (queue_.OwnerRing()) {
+        queue_.BindProducer();
+    }
+}
+
+bool ThreadPool::TryPost(TaskFunction<void()> f, TaskPriority priority) {
+    if (state_.load(std::memory_order_acquire) != PoolState::RUNNING) {
+        return false;
+    }
+    Task task = Task::Make<SimpleTask>(std::move(f));
+#if TP_LATENCY_HISTOGRAMS
+    task.StampSubmitted(LatencyClockNs());
+#endif
+    if ((priority == TaskPriority::Normal && TryPushLocal(task)) || Lane(priority).TryPush(std::move(task))) {
+        total_submitted_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
 }
 
 void ThreadPool::Pause() noexcept {
     PoolState expected = PoolState::RUNNING;
     if (state_.compare_exchange_strong(expected, PoolState::PAUSED,
-            std::memory_order_acq_rel, std::memory_order_acquire)) {
+            std::memory_order_seq_cst, std::memory_order_acquire)) {
+        // Pairs with the fence in TryBeginTask: a worker either sees PAUSED there, or its
+        // starting flag is visible here and we wait until that task has started
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        {
+            std::lock_guard<std::mutex> lk(workers_mu_);
+            for (const auto& w : workers_) {
+                while (w->starting.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+        // CallerRuns submitters that passed the same check are about to run their task inline
+        while (inline_starting_.load(std::memory_order_acquire) != 0) {
+            std::this_thread::yield();
+        }
         TP_LOG_INFO("ThreadPool paused");
     } else {
         TP_LOG_DEBUG("ThreadPool pause ignored: state={}", expected);
@@ -317,8 +1054,7 @@ void ThreadPool::Resume() noexcept {
     PoolState expected = PoolState::PAUSED;
     if (state_.compare_exchange_strong(expected, PoolState::RUNNING,
             std::memory_order_acq_rel, std::memory_order_acquire)) {
-        std::lock_guard<std::mutex> lk(pause_mtx_);
-        pause_cv_.notify_all();
+        pause_gate_.NotifyAll();
         TP_LOG_INFO("ThreadPool resumed");
     } else {
         TP_LOG_DEBUG("ThreadPool resume ignored: state={}", expected);
@@ -330,28 +1066,82 @@ void ThreadPool::WorkerLoop(WorkerSlot* slot) {
     TP_LOG_DEBUG("Worker {} started (thread_id_hash={})",
                  static_cast<const void*>(slot), tid_hash);
     WorkerCounterHelper counter(*this, *slot);
+    tls_pool_ = this;
+    tls_worker_ = slot;
+    std::chrono::steady_clock::time_point idle_since{};  // start of the current idle stretch (work-stealing parks)
     for (;;) {
-        {
-            std::unique_lock<std::mutex> lk(pause_mtx_);
-            while (state_.load(std::memory_order_acquire) == PoolState::PAUSED) {
-                paused_wait_cnt_.fetch_add(1, std::memory_order_relaxed);
-                TP_LOG_DEBUG("Worker {} waiting due to pool paused", static_cast<const void*>(slot));
-                pause_cv_.wait(lk, [this] {
-                    auto s = state_.load(std::memory_order_acquire);
-                    return s != PoolState::PAUSED;
-                });
-            }
+        // Running path: a single relaxed read; Pause() itself is enforced by TryBeginTask below
+        if (state_.load(std::memory_order_relaxed) == PoolState::PAUSED) {
+            paused_wait_cnt_.fetch_add(1, std::memory_order_relaxed);
+            TP_LOG_DEBUG("Worker {} waiting due to pool paused", static_cast<const void*>(slot));
+            ParkWhilePaused();
         }
         if (state_.load(std::memory_order_acquire) == PoolState::FORCE_STOPPING) {
             TP_LOG_DEBUG("Worker {} exiting because pool is force stopping", static_cast<const void*>(slot));
             break;
         }
+        if (timer_evicted_pending_.load(std::memory_order_relaxed)) {
+            CancelTimerEvicted();
+        }
 
     slot->idle.store(true, std::memory_order_release); // Mark thread idle
     slot->idle_nums.fetch_add(1, std::memory_order_relaxed); // Increment idle counter
 
-        TaskPtr task;
-        const bool ok = queue_.WaitPop(task);
+        // A BlockingRegion that added a worker ended (and the backlog is gone), or a controller
+        // lowered the cap: surplus workers leave between tasks. Compensating workers don't
+        // count against the cap
+        if (retire_owed_.load(std::memory_order_relaxed) != 0
+            && high_lane_.Size() + queue_.Size() + low_lane_.Size() == 0
+            && TryRetireOwed(*slot)) {
+            break;
+        }
+        const auto cap = thread_cap_.load(std::memory_order_relaxed) + compensating_workers_.load(std::memory_order_relaxed);
+        if (current_threads_.load(std::memory_order_relaxed) > cap && TryRetire(*slot, cap)) {
+            break;
+        }
+
+        Task task;
+        bool ok = SpinForTask(*slot, task);
+        if (ok) {
+            slot->steal_park = kStealParkMin;
+        } else if (slot->local_tasks) {
+            // Work-stealing: lanes (own deque and random victims on the Normal lane), then park briefly
+            ok = TryTakeNoWait(*slot, task);
+            if (!ok) {
+                park_cnt_.fetch_add(1, std::memory_order_relaxed);
+                ok = WaitTakeFor(*slot, task, slot->steal_park);
+            }
+            if (!ok && !queue_.Closed()) {
+                const auto now = std::chrono::steady_clock::now();
+                if (idle_since == std::chrono::steady_clock::time_point{}) {
+                    idle_since = now;
+                } else if (now - idle_since >= keep_alive_ && TryRetire(*slot)) {
+                    break;
+                }
+                slot->steal_park = std::min(slot->steal_park * 2, kStealParkMax);
+                continue; // Re-check pause/stop before probing victims again
+            }
+            slot->steal_park = kStealParkMin;
+        } else if (current_threads_.load(std::memory_order_relaxed) > thread_floor_.load(std::memory_order_relaxed)) {
+            // Surplus worker: idling for keep_alive_ retires it. Under the Sojourn and HillClimb
+            // controllers it also wakes every balancer tick so a lowered cap takes it out sooner
+            const auto park = autoscale_mode_ != AutoscaleMode::Thresholds ? std::min(keep_alive_, load_check_interval_) : keep_alive_;
+            if (idle_since == std::chrono::steady_clock::time_point{}) {
+                idle_since = std::chrono::steady_clock::now();
+            }
+            park_cnt_.fetch_add(1, std::memory_order_relaxed);
+            ok = WaitTakeFor(*slot, task, park);
+            if (!ok && !queue_.Closed()) {
+                if (std::chrono::steady_clock::now() - idle_since >= keep_alive_ && TryRetire(*slot)) {
+                    break;
+                }
+                continue;
+            }
+        } else {
+            park_cnt_.fetch_add(1, std::memory_order_relaxed);
+            ok = WaitTake(*slot, task);
+        }
+        idle_since = {};
 
         if (!ok) {
             if (queue_.Closed()) {
@@ -367,23 +1157,25 @@ void ThreadPool::WorkerLoop(WorkerSlot* slot) {
             continue;
         }
 
-        if (auto* exit_task = dynamic_cast<ExitTask*>(task.get())) {
-            if (exit_task->slot == slot) {
-                slot->should_exit.store(false, std::memory_order_release);
-                TP_LOG_INFO("Worker {} received directed exit request", static_cast<const void*>(slot));
-                break; // Directed exit
-            }
-            TP_LOG_DEBUG("Worker {} forwarding exit task to {}", static_cast<const void*>(slot),
-                         static_cast<const void*>(exit_task->slot));
-            if (!queue_.WaitPush(std::move(task))) {
-                TP_LOG_WARN("Worker {} failed to requeue exit task", static_cast<const void*>(slot));
+        // A task taken while Pause() was in progress waits here rather than starting
+        bool cancelled = false;
+        while (!TryBeginTask(*slot)) {
+            paused_wait_cnt_.fetch_add(1, std::memory_order_relaxed);
+            ParkWhilePaused();
+            if (state_.load(std::memory_order_acquire) == PoolState::FORCE_STOPPING) {
+                task->Cancel(std::make_exception_ptr(std::runtime_error("force stopped")));
+                RecordTaskCancel();
+                cancelled = true;
                 break;
             }
-            continue;
+        }
+        if (cancelled) {
+            break;
         }
 
         slot->last_active = std::chrono::steady_clock::now();
         counter.TaskOn();
+        slot->starting.store(false, std::memory_order_release);
         std::chrono::nanoseconds exec_span{0};
         bool exception_thrown = false;
         bool unknown_exception = false;
@@ -391,9 +1183,9 @@ void ThreadPool::WorkerLoop(WorkerSlot* slot) {
         {
             TP_PERF_SCOPE_HOOK_LEVEL(
                 "WorkerLoop::ExecuteTask",
-                ([this, &task, &exec_span](std::chrono::nanoseconds ns) {
+                ([this, slot, &task, &exec_span](std::chrono::nanoseconds ns) {
                     exec_span = ns;
-                    RecordTaskComplete(*task, ns);
+                    RecordTaskComplete(*slot, task, ns);
                 }),
                 spdlog::level::trace);
             try {
@@ -421,21 +1213,263 @@ void ThreadPool::WorkerLoop(WorkerSlot* slot) {
             continue;
         }
 
-        TP_LOG_DEBUG("Worker {} completed task={} success={} duration={}us pending={} active={}",
+        TP_LOG_DEBUG("Worker {} completed task={} success={} duration={}us pending={}",
                      static_cast<const void*>(slot),
                      static_cast<const void*>(task.get()),
                      task->Success(),
                      duration_us,
-                     Pending(), ActiveTasks());
+                     Pending());
 
-        if (ActiveTasks() == 0 && Pending() == 0) {
+        // Only a graceful stop waits for the drain; skip the aggregate while running
+        if (state_.load(std::memory_order_relaxed) == PoolState::SHUTTING_DOWN
+            && Pending() == 0 && ActiveTasks() == 0) {
             std::lock_guard<std::mutex> lk(drain_mtx_);
             drain_cv_.notify_all();
         }
     }
+    FlushLocalTasks(*slot);
+    tls_pool_ = nullptr;
+    tls_worker_ = nullptr;
+    if (slot->retired) {
+        // After the flush: the deque index may be handed to a new worker from here on
+        DetachRetiredWorker(*slot);
+    }
     TP_LOG_DEBUG("Worker {} exiting loop", static_cast<const void*>(slot));
 }
 
+bool ThreadPool::TryBeginTask(WorkerSlot& slot) noexcept {
+    // Dekker handshake with Pause(): publish the flag, then read the state
+    slot.starting.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (state_.load(std::memory_order_relaxed) != PoolState::PAUSED) {
+        return true; // Caller clears the flag once the task counts as started
+    }
+    slot.starting.store(false, std::memory_order_release);
+    return false;
+}
+
+bool ThreadPool::TryBeginInline() noexcept {
+    // Same handshake as TryBeginTask, counted instead of flagged: any thread may run inline
+    inline_starting_.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (state_.load(std::memory_order_relaxed) != PoolState::PAUSED) {
+        return true;
+    }
+    inline_starting_.fetch_sub(1, std::memory_order_release);
+    return false;
+}
+void ThreadPool::InlineStarted() noexcept {
+    inline_starting_.fetch_sub(1, std::memory_order_release);
+}
+void ThreadPool::ParkWhilePaused() noexcept {
+    for (;;) {
+        const auto key = pause_gate_.PrepareWait();
+        if (state_.load(std::memory_order_acquire) != PoolState::PAUSED) {
+            pause_gate_.CancelWait();
+            return;
+        }
+        pause_gate_.Wait(key);
+    }
+}
+
+bool ThreadPool::TryPushLocal(Task& task) noexcept {
+    WorkerSlot* slot = tls_worker_;
+    if (tls_pool_ != this || !slot || !slot->local_tasks) {
+        return false;
+    }
+    // Count first so Pending() never under-reports a task a thief already took
+    local_pending_.fetch_add(1, std::memory_order_acq_rel);
+    if (slot->local_tasks->TryPush(std::move(task))) {
+        return true;
+    }
+    local_pending_.fetch_sub(1, std::memory_order_acq_rel);
+    return false; // Deque full; caller falls back to the shared queue
+}
+
+bool ThreadPool::TryTakeLocalOrSteal(WorkerSlot& slot, Task& task) {
+    if (slot.local_tasks->TryPop(task)) {
+        local_pending_.fetch_sub(1, std::memory_order_acq_rel);
+        return true;
+    }
+
+    // Probe every other deque once, starting from a random victim
+    const std::size_t victims = local_queues_.size();
+    slot.steal_seed ^= slot.steal_seed << 13;
+    slot.steal_seed ^= slot.steal_seed >> 7;
+    slot.steal_seed ^= slot.steal_seed << 17;
+    const std::size_t start = static_cast<std::size_t>(slot.steal_seed % victims);
+    for (std::size_t i = 0; i < victims; ++i) {
+        auto& victim = local_queues_[(start + i) % victims];
+        if (victim.get() == slot.local_tasks) {
+            continue;
+        }
+        if (victim->TrySteal(task)) {
+            local_pending_.fetch_sub(1, std::memory_order_acq_rel);
+            steal_cnt_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+BlockingQueueAdapter<Task>& ThreadPool::Lane(TaskPriority priority) noexcept {
+    switch (priority) {
+        case TaskPriority::High:
+            return high_lane_;
+        case TaskPriority::Low:
+            return low_lane_;
+        default:
+            return queue_;
+    }
+}
+
+const BlockingQueueAdapter<Task>& ThreadPool::Lane(TaskPriority priority) const noexcept {
+    return const_cast<ThreadPool*>(this)->Lane(priority);
+}
+
+std::size_t ThreadPool::LaneCapacity() const noexcept {
+    return queue_.Capacity() + high_lane_.Capacity() + low_lane_.Capacity();
+}
+
+bool ThreadPool::TryTakeLane(WorkerSlot& slot, std::size_t lane, Task& task) {
+    const auto priority = static_cast<TaskPriority>(lane);
+    if (priority == TaskPriority::Normal && slot.local_tasks && TryTakeLocalOrSteal(slot, task)) {
+        return true;
+    }
+    return Lane(priority).TryPop(task);
+}
+
+bool ThreadPool::TryTakeNoWait(WorkerSlot& slot, Task& task) {
+    // Lanes are scanned High -> Normal -> Low, except that every priority_aging_'th pick
+    // first tries a lower lane (Low and Normal in turn), so a steady stream of urgent work
+    // cannot starve the rest: each lower lane gets at least one pick in 2 * priority_aging_
+    bool found = false;
+    if (priority_aging_ != 0 && (slot.lane_picks + 1) % priority_aging_ == 0) {
+        const bool low_turn = ((slot.lane_picks + 1) / priority_aging_) % 2 == 1;
+        const auto aged = static_cast<std::size_t>(low_turn ? TaskPriority::Low : TaskPriority::Normal);
+        found = TryTakeLane(slot, aged, task);
+    }
+    for (std::size_t lane = 0; !found && lane < kPriorityLanes; ++lane) {
+        found = TryTakeLane(slot, lane, task);
+    }
+    if (found) {
+        ++slot.lane_picks;
+    }
+    return found;
+}
+
+bool ThreadPool::WaitTake(WorkerSlot& slot, Task& task) {
+    // Same protocol as BlockingQueueAdapter::Await, over every lane: re-poll after
+    // PrepareWait so a push between the failed poll and the park is never missed
+    for (;;) {
+        if (TryTakeNoWait(slot, task)) {
+            return true;
+        }
+        if (queue_.Closed()) {
+            return false;
+        }
+        const auto key = lane_ready_.PrepareWait();
+        if (TryTakeNoWait(slot, task)) {
+            lane_ready_.CancelWait();
+            return true;
+        }
+        if (queue_.Closed()) {
+            lane_ready_.CancelWait();
+            return false;
+        }
+        lane_ready_.Wait(key);
+    }
+}
+
+bool ThreadPool::WaitTakeFor(WorkerSlot& slot, Task& task, std::chrono::microseconds timeout) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    for (;;) {
+        if (TryTakeNoWait(slot, task)) {
+            return true;
+        }
+        if (queue_.Closed()) {
+            return false;
+        }
+        const auto key = lane_ready_.PrepareWait();
+        if (TryTakeNoWait(slot, task)) {
+            lane_ready_.CancelWait();
+            return true;
+        }
+        if (queue_.Closed()) {
+            lane_ready_.CancelWait();
+            return false;
+        }
+        if (!lane_ready_.WaitUntil(key, deadline)) {
+            return TryTakeNoWait(slot, task); // Last chance if the wake-up and the deadline raced
+        }
+    }
+}
+
+bool ThreadPool::SpinAllowed() const noexcept {
+    const auto s = state_.load(std::memory_order_relaxed);
+    return (s == PoolState::RUNNING || s == PoolState::SHUTTING_DOWN) && !queue_.Closed();
+}
+
+bool ThreadPool::SpinForTask(WorkerSlot& slot, Task& task) {
+    if (idle_strategy_ != IdleStrategy::SpinThenPark) {
+        return false;
+    }
+    // Bound idle CPU burn: only max_spinning_workers_ spin at once, the rest park right away
+    std::size_t spinning = spinning_workers_.load(std::memory_order_relaxed);
+    do {
+        if (spinning >= max_spinning_workers_) {
+            return false;
+        }
+    } while (!spinning_workers_.compare_exchange_weak(spinning, spinning + 1,
+                                                      std::memory_order_acq_rel,
+                                                      std::memory_order_relaxed));
+
+    bool found = false;
+    std::size_t spins = 0;
+    for (; spins < slot.spin_budget && SpinAllowed(); ++spins) {
+        if (TryTakeNoWait(slot, task)) {
+            found = true;
+            break;
+        }
+        CpuRelax();
+    }
+    for (std::size_t i = 0; !found && i < idle_yield_count_ && SpinAllowed(); ++i) {
+        std::this_thread::yield();
+        found = TryTakeNoWait(slot, task);
+    }
+    spinning_workers_.fetch_sub(1, std::memory_order_release);
+
+    // Track the typical gap until work shows up and spin about twice that long. A miss means
+    // arrivals are further apart than the budget, so back off towards the minimum.
+    if (found) {
+        slot.spin_gap = (slot.spin_gap * 7 + spins) / 8;
+        spin_hit_cnt_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        slot.spin_gap /= 2;
+    }
+    slot.spin_budget = std::min(idle_spin_max_, std::max(slot.spin_gap * 2, kSpinBudgetMin));
+    return found;
+}
+
+void ThreadPool::FlushLocalTasks(WorkerSlot& slot) {
+    if (!slot.local_tasks) {
+        return;
+    }
+    const bool force = state_.load(std::memory_order_acquire) == PoolState::FORCE_STOPPING;
+    Task task;
+    while (slot.local_tasks->TryPop(task)) {
+        // Hand the task back to the shared queue; cancel it if that is no longer possible
+        if (!task || force || !queue_.TryPush(std::move(task))) {
+            if (task) {
+                task->Cancel(std::make_exception_ptr(std::runtime_error("worker exited")));
+                RecordTaskCancel();
+            }
+        }
+        local_pending_.fetch_sub(1, std::memory_order_acq_rel);
+        task.reset();
+    }
+}
+
 bool ThreadPool::Running() const noexcept {
     return state_.load(std::memory_order_acquire) == PoolState::RUNNING;
 }
@@ -445,11 +1479,23 @@ bool ThreadPool::Paused() const noexcept {
 }
 
 std::size_t ThreadPool::Pending() const noexcept {
-    return queue_.Size();
+    return high_lane_.Size() + queue_.Size() + low_lane_.Size() + local_pending_.load(std::memory_order_acquire);
+}
+
+std::size_t ThreadPool::Pending(TaskPriority priority) const noexcept {
+    if (priority == TaskPriority::Normal) {
+        return queue_.Size() + local_pending_.load(std::memory_order_acquire);
+    }
+    return Lane(priority).Size();
 }
 
 std::size_t ThreadPool::ActiveTasks() const noexcept {
-    return active_tasks_.load(std::memory_order_acquire);
+    std::lock_guard<std::mutex> lk(stats_mu_);
+    std::size_t active = 0;
+    for (const WorkerSlot* slot : stats_shards_) {
+        active += slot->stats.active.load(std::memory_order_acquire);
+    }
+    return active;
 }
 
 PoolState ThreadPool::State() const noexcept {
@@ -492,6 +1538,14 @@ std::size_t ThreadPool::PausedWait() const noexcept {
     return paused_wait_cnt_.load(std::memory_order_relaxed);
 }
 
+std::size_t ThreadPool::StolenTasks() const noexcept {
+    return steal_cnt_.load(std::memory_order_relaxed);
+}
+
+SchedulingMode ThreadPool::Scheduling() const noexcept {
+    return scheduling_;
+}
+
 // Dynamic thread management utilities
 void ThreadPool::LaunchLoadBalancer() {
     // Start the balancer thread
@@ -515,9 +1569,29 @@ void ThreadPool::StopLoadBalancer() {
 
 void ThreadPool::LoadBalancerLoop() {
     std::unique_lock<std::mutex> lk(load_cv_mu_);
-    auto last_adjust = std::chrono::steady_clock::now();
+    const auto started = std::chrono::steady_clock::now();
+    auto last_adjust = started - cooldown_;  // cooldown follows capacity changes, not Start()
     std::size_t up_hits = 0;
-    std::size_t down_hits = 0;
+
+    // Arrival rate and mean service time between consecutive ticks, for sizing scale-up steps
+    auto last_sample = started;
+    std::size_t last_submitted = total_submitted_.load(std::memory_order_relaxed);
+    StatsTotals last_totals;
+    double arrival_per_s = 0.0;
+    double service_s = 0.0;  // 0 until a window has seen a completion
+    double wait_ewma_ns = 0.0;
+    SojournPi sojourn;
+
+    // HillClimb: completions, CPU time and backlog over the current measurement window
+    HillClimber climber(core_threads_, 1, max_threads_);
+    auto window_start = started;
+    std::size_t window_finished = last_totals.completed + last_totals.failed;
+    std::clock_t window_cpu = std::clock();
+    std::size_t window_ticks = 0;
+    std::size_t window_backlog_ticks = 0;
+    if (autoscale_mode_ == AutoscaleMode::HillClimb) {
+        tuned_threads_.store(climber.Current(), std::memory_order_relaxed);
+    }
 
     while (!balancer_stop_.load(std::memory_order_acquire)) {
         load_cv_.wait_for(lk, load_check_interval_, [this] {
@@ -528,39 +1602,113 @@ void ThreadPool::LoadBalancerLoop() {
         if (balancer_stop_.load(std::memory_order_acquire)) {
             break;        
         }
+        ReapExitedWorkers();
         const bool kicked = balancer_kick_.exchange(false, std::memory_order_acq_rel);
         const auto now = std::chrono::steady_clock::now();
-        if (!kicked && now - last_adjust < cooldown_) {
-            continue;
-        }
 
-        const std::size_t pending = queue_.Size();
+        // Backlog across all lanes
+        const std::size_t pending = high_lane_.Size() + queue_.Size() + low_lane_.Size();
         const std::size_t current = current_threads_.load(std::memory_order_acquire);
-        const std::size_t active = active_threads_.load(std::memory_order_acquire);
+        const std::size_t active = ActiveThreads();
         const double busy_ratio = current == 0 ? 0.0 : static_cast<double>(active) / current;
 
+        // Reported in every mode and every tick, cooldown or not
         busy_ratio_.store(busy_ratio, std::memory_order_release); // Update busy ratio
-        pending_ratio_.store(static_cast<double>(pending) / queue_.Capacity(), std::memory_order_relaxed); // Update queue utilization
+        pending_ratio_.store(static_cast<double>(pending) / LaneCapacity(), std::memory_order_relaxed); // Update queue utilization
+
+        const double window_s = std::chrono::duration<double>(now - last_sample).count();
+        if (window_s > 0.0) {
+            const std::size_t submitted = total_submitted_.load(std::memory_order_relaxed);
+            StatsTotals totals;
+            {
+                std::lock_guard<std::mutex> guard(stats_mu_);
+                totals = AggregateStatsLocked();
+            }
+            const std::size_t finished = (totals.completed + totals.failed) - (last_totals.completed + last_totals.failed);
+            // ResetStatistics() zeroes the submit counter; skip that window
+            arrival_per_s = submitted >= last_submitted ? static_cast<double>(submitted - last_submitted) / window_s : arrival_per_s;
+            if (finished != 0) {
+                service_s = static_cast<double>(totals.exec_time_ns - last_totals.exec_time_ns) * 1e-9 / static_cast<double>(finished);
+            }
+            // Mean queue wait of the tasks that started in this window. If none started while
+            // work was queued, the oldest task has waited at least the whole window
+            const std::size_t waited = totals.waited - last_totals.waited;
+            const double wait_ns = waited != 0
+                ? static_cast<double>(totals.wait_time_ns - last_totals.wait_time_ns) / static_cast<double>(waited)
+                : (pending != 0 ? window_s * 1e9 : 0.0);
+            wait_ewma_ns += kQueueWaitEwmaAlpha * (wait_ns - wait_ewma_ns);
+            queue_wait_ewma_ns_.store(static_cast<std::int64_t>(wait_ewma_ns), std::memory_order_relaxed);
+            last_sample = now;
+            last_submitted = submitted;
+            last_totals = totals;
+        }
+
+        if (autoscale_mode_ == AutoscaleMode::Sojourn) {
+            if (window_s > 0.0) {
+                const double target_ns = static_cast<double>(sojourn_target_.count());
+                const double error = std::clamp((wait_ewma_ns - target_ns) / target_ns, -1.0, 4.0);
+                SojournStep(sojourn.Update(error, window_s, sojourn_kp_, sojourn_ki_), wait_ewma_ns);
+            }
+            continue;
+        }
+
+        if (autoscale_mode_ == AutoscaleMode::HillClimb) {
+            ++window_ticks;
+            window_backlog_ticks += pending != 0 ? 1 : 0;
+            const double elapsed_s = std::chrono::duration<double>(now - window_start).count();
+            if (now - window_start < hill_climb_window_ || elapsed_s <= 0.0) {
+                continue;
+            }
+            const std::size_t finished = last_totals.completed + last_totals.failed;
+            const std::clock_t cpu = std::clock();
+            // last_totals is the raw aggregate, which only grows (ResetStatistics moves the base)
+            TunerSample sample;
+            sample.threads = climber.Current();
+            sample.throughput = static_cast<double>(finished - window_finished) / elapsed_s;
+            sample.saturated = window_backlog_ticks * 2 >= window_ticks;
+            const double cpu_used = static_cast<double>(cpu - window_cpu) / CLOCKS_PER_SEC / elapsed_s;
+            const bool cpu_bound = cpu_used >= kCpuBoundShare * cpu_quota_;
+            HillClimbStep(climber.Update(sample.throughput, sample.saturated, cpu_bound), sample, cpu_used);
+            window_start = now;
+            window_finished = finished;
+            window_cpu = cpu;
+            window_ticks = 0;
+            window_backlog_ticks = 0;
+            continue;
+        }
+
+        if (!kicked && now - last_adjust < cooldown_) {
+            continue;
+        }
 
-        // Scale-up conditions: too many pending tasks / workers too busy
+        // Scale-up conditions: too many pending tasks / workers too busy. There is no
+        // scale-down here: surplus workers retire themselves once idle for keep_alive_
         const bool to_grow = pending >= pending_hi_ || busy_ratio >= scale_up_threshold_;
-        // Scale-down condition
-        const bool to_shrink = pending <= pending_low_ && busy_ratio <= scale_down_threshold_;
 
         if (to_grow) {
             // Require multiple hits before scaling up (debounce)
             ++up_hits;
             if (up_hits >= debounce_hits_) {
-                // Adjust capacity; reset hit counters
-                up_hits = down_hits = 0;
+                // Adjust capacity; reset hit counter
+                up_hits = 0;
                 last_adjust = now;
                 std::lock_guard<std::mutex> guard(workers_mu_);
-                if (current_threads_.load(std::memory_order_acquire) < max_threads_) {
-                    const auto before = current_threads_.load(std::memory_order_acquire);
-                    CreateWorkerUnlocked();
-                    TP_LOG_INFO("Load balancer scaled up: {} -> {} (pending={}, busy_ratio={:.2f})",
+                const auto before = current_threads_.load(std::memory_order_acquire);
+                if (before < max_threads_) {
+                    // Size the step from the load instead of adding one worker per cooldown. Aim
+                    // to clear the backlog within one cooldown; with no completion to time
+                    // (every worker stuck on long tasks) double instead
+                    const double drain_s = std::chrono::duration<double>(std::max(cooldown_, load_check_interval_)).count();
+                    const std::size_t target = service_s > 0.0
+                        ? LittleLawWorkers(arrival_per_s, service_s, pending, drain_s)
+                        : before * 2;
+                    const std::size_t step = std::min(max_threads_ - before, std::max<std::size_t>(1, target > before ? target - before : 0));
+                    for (std::size_t i = 0; i < step; ++i) {
+                        CreateWorkerUnlocked();
+                    }
+                    TP_LOG_INFO("Load balancer scaled up: {} -> {} (pending={}, busy_ratio={:.2f}, arrival={:.0f}/s, service={:.1f}us)",
                                 before, current_threads_.load(std::memory_order_acquire),
-                                pending, busy_ratio);
+                                pending, busy_ratio, arrival_per_s, service_s * 1e6);
                 } else {
                     TP_LOG_DEBUG("Load balancer scale-up skipped: already at max_threads={}", max_threads_);
                 }
@@ -568,49 +1716,93 @@ void ThreadPool::LoadBalancerLoop() {
             continue;
         }
 
-        if (to_shrink) {
-            // Require multiple hits before scaling down (debounce)
-            ++down_hits;
-            if (down_hits >= debounce_hits_) {
-                up_hits = down_hits = 0;
-                last_adjust = now;
-                std::vector<WorkerSlot*> target_workers;
-                {
-                    std::lock_guard<std::mutex> guard(workers_mu_);
-                    if (current_threads_.load(std::memory_order_acquire) > core_threads_) {
-                        target_workers = ScheduleShrinkUnlocked(1);
-                    }
-                }
-                if (!target_workers.empty()) {
-                    EnqueueExitSignals(target_workers);
-                    for (WorkerSlot* worker : target_workers) {
-                        if (worker) {
-                            RetireWorkerUnlocked(*worker);
-                        }
-                    }
-                    TP_LOG_INFO("Load balancer scaled down to {} workers (pending={}, busy_ratio={:.2f})",
-                                current_threads_.load(std::memory_order_acquire),
-                                pending, busy_ratio);
-                } else {
-                    TP_LOG_DEBUG("Load balancer scale-down skipped: no idle workers available");
-                }
-            }
-            continue;
-        }
-
-        up_hits = down_hits = 0;
+        up_hits = 0;
     }
     TP_LOG_DEBUG("Load balancer loop exiting");
 }
 
+void ThreadPool::SojournStep(double level, double wait_ewma_ns) {
+    // No thresholds, debounce or cooldown: every tick moves the worker count towards the PI
+    // output. Growth happens here; above the new cap workers retire between tasks, idle
+    // ones at the latest after keep_alive_
+    const auto desired = core_threads_ + static_cast<std::size_t>(std::lround(level * static_cast<double>(max_threads_ - core_threads_)));
+    const auto previous = thread_cap_.exchange(desired, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> guard(workers_mu_);
+    const auto before = current_threads_.load(std::memory_order_acquire);
+    while (current_threads_.load(std::memory_order_acquire) < desired) {
+        CreateWorkerUnlocked();
+    }
+    if (desired != previous) {
+        TP_LOG_DEBUG("Sojourn controller: queue_wait={:.0f}us target={}us level={:.2f} cap {} -> {} (workers={})",
+                     wait_ewma_ns * 1e-3, sojourn_target_.count() / 1000, level, previous, desired, before);
+    }
+}
+
+void ThreadPool::HillClimbStep(std::size_t count, const TunerSample& sample, double cpu_used) {
+    {
+        std::lock_guard<std::mutex> guard(tuner_mu_);
+        if (tuner_samples_.size() == kTunerSamples) {
+            tuner_samples_.erase(tuner_samples_.begin());
+        }
+        tuner_samples_.push_back(sample);
+    }
+    tuned_threads_.store(count, std::memory_order_relaxed);
+
+    // The tuner owns the count: pin floor and cap to it. Lower the floor first so workers
+    // above a lowered cap are free to retire
+    thread_floor_.store(count, std::memory_order_relaxed);
+    thread_cap_.store(count, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> guard(workers_mu_);
+    while (current_threads_.load(std::memory_order_acquire) < count) {
+        CreateWorkerUnlocked();
+    }
+    if (count != sample.threads) {
+        TP_LOG_DEBUG("Hill climb: {} workers -> {:.0f} tasks/s (saturated={}, cpu {:.2f}/{:.2f}); next {}",
+                     sample.threads, sample.throughput, sample.saturated, cpu_used, cpu_quota_, count);
+    }
+}
+
 void ThreadPool::CreateWorkerUnlocked() {
     auto slot = std::make_unique<WorkerSlot>();
     slot->last_active = std::chrono::steady_clock::now();
     WorkerSlot* raw = slot.get();
 
-    slot->thread = std::thread([this, raw] {
-        WorkerLoop(raw);
-    });
+    if (!local_queues_.empty()) {
+        // Borrow the lowest deque index not owned by a live worker
+        std::size_t index = 0;
+        for (; index < local_queues_.size(); ++index) {
+            const bool taken = std::any_of(workers_.begin(), workers_.end(),
+                [index](const std::unique_ptr<WorkerSlot>& w) {
+                    return w->local_tasks && w->index == index;
+                });
+            if (!taken) {
+                break;
+            }
+        }
+        if (index < local_queues_.size()) {
+            raw->index = index;
+            raw->local_tasks = local_queues_[index].get();
+            raw->steal_seed = (index + 1) * 0x9E3779B97F4A7C15ULL;
+            raw->steal_park = kStealParkMin;
+        }
+    }
+    raw->spin_gap = idle_spin_max_ / 4;
+    raw->spin_budget = idle_spin_max_ / 2;
+
+    {
+        std::lock_guard<std::mutex> lk(stats_mu_);
+        stats_shards_.push_back(raw);
+    }
+    try {
+        slot->thread = std::thread([this, raw] {
+            WorkerLoop(raw);
+        });
+    } catch (...) {
+        std::lock_guard<std::mutex> lk(stats_mu_);
+        stats_shards_.erase(std::remove(stats_shards_.begin(), stats_shards_.end(), raw), stats_shards_.end());
+        throw;
+    }
     const auto thread_id = slot->thread.get_id();
     const auto thread_token = std::hash<std::thread::id>{}(thread_id);
     workers_.push_back(std::move(slot));
@@ -631,70 +1823,118 @@ void ThreadPool::CreateWorkerUnlocked() {
                  peak_threads_.load(std::memory_order_relaxed));
 }
 
-std::vector<ThreadPool::WorkerSlot*> ThreadPool::ScheduleShrinkUnlocked(std::size_t count) {
-    std::vector<WorkerSlot*> targets;
-    targets.reserve(count);
-    for (auto& slot : workers_) {
-        if (targets.size() >= count) {
-            break;
+bool ThreadPool::TryRetire(WorkerSlot& slot, std::size_t floor) noexcept {
+    if (state_.load(std::memory_order_acquire) != PoolState::RUNNING) {
+        return false; // Stop joins everyone anyway; a paused pool keeps its workers
+    }
+    // Claim the exit on the live count itself so concurrent retirements never undershoot the floor
+    floor = std::max(floor, thread_floor_.load(std::memory_order_relaxed));
+    std::size_t current = current_threads_.load(std::memory_order_acquire);
+    while (current > floor) {
+        if (current_threads_.compare_exchange_weak(current, current - 1,
+                                                   std::memory_order_acq_rel,
+                                                   std::memory_order_acquire)) {
+            slot.retired = true;
+            return true;
         }
-        // Skip busy workers
-        if (!slot->idle.load(std::memory_order_acquire)) {
-            continue;
+    }
+    return false;
+}
+
+bool ThreadPool::TryRetireOwed(WorkerSlot& slot) noexcept {
+    std::size_t owed = retire_owed_.load(std::memory_order_acquire);
+    do {
+        if (owed == 0) {
+            return false;
         }
-        bool expected = false;
-        // Mark worker for exit
-        if (slot->should_exit.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
-            targets.push_back(slot.get());
+    } while (!retire_owed_.compare_exchange_weak(owed, owed - 1, std::memory_order_acq_rel, std::memory_order_acquire));
+    compensating_workers_.fetch_sub(1, std::memory_order_relaxed);
+    // Keep-alive may have brought the pool down to its floor meanwhile; then nobody has to go
+    return TryRetire(slot);
+}
+
+bool ThreadPool::EnterBlocking() noexcept {
+    blocked_workers_.fetch_add(1, std::memory_order_relaxed);
+    // A parked or spinning worker will pick up the slack by itself
+    if (lane_ready_.Waiters() != 0 || spinning_workers_.load(std::memory_order_relaxed) != 0) {
+        return false;
+    }
+    // Adopt the extra worker of an ended region that has not left yet instead of starting one
+    std::size_t owed = retire_owed_.load(std::memory_order_relaxed);
+    while (owed != 0) {
+        if (retire_owed_.compare_exchange_weak(owed, owed - 1, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+    std::size_t extra = compensating_workers_.load(std::memory_order_relaxed);
+    do {
+        if (extra >= max_blocking_threads_) {
+            return false;
+        }
+    } while (!compensating_workers_.compare_exchange_weak(extra, extra + 1, std::memory_order_relaxed));
+
+    try {
+        std::lock_guard<std::mutex> guard(workers_mu_);
+        if (state_.load(std::memory_order_acquire) == PoolState::RUNNING) {
+            CreateWorkerUnlocked();
+            compensation_cnt_.fetch_add(1, std::memory_order_relaxed);
+            return true;
         }
+    } catch (const std::exception& ex) {
+        TP_LOG_WARN("BlockingRegion: could not start a compensating worker: {}", ex.what());
     }
-    if (!targets.empty()) {
-        TP_LOG_DEBUG("Scheduled {} worker(s) for shrink", targets.size());
+    compensating_workers_.fetch_sub(1, std::memory_order_relaxed);
+    return false;
+}
+
+void ThreadPool::LeaveBlocking(bool compensated) noexcept {
+    blocked_workers_.fetch_sub(1, std::memory_order_relaxed);
+    if (compensated) {
+        retire_owed_.fetch_add(1, std::memory_order_release);  // this worker or another gives it back
     }
-    return targets;
 }
 
-void ThreadPool::EnqueueExitSignals(const std::vector<WorkerSlot*>& targets) {
-    for (WorkerSlot* slot : targets) {
-        if (!slot) {
-            continue;
-        }
-        // Create a directed exit task
-        TaskPtr exit_task = std::make_unique<ExitTask>(slot);
-        if (!queue_.WaitPush(std::move(exit_task))) {
-            break;
-        }
-        TP_LOG_DEBUG("Exit signal enqueued for worker {}", static_cast<const void*>(slot));
+ThreadPool::BlockingRegion::BlockingRegion(ThreadPool& pool) noexcept
+    : pool_(tls_pool_ == &pool && tls_worker_ != nullptr ? &pool : nullptr) {
+    if (pool_ != nullptr) {
+        compensated_ = pool_->EnterBlocking();
+    }
+}
+
+ThreadPool::BlockingRegion::~BlockingRegion() {
+    if (pool_ != nullptr) {
+        pool_->LeaveBlocking(compensated_);
+    }
+}
+
+void ThreadPool::DetachRetiredWorker(WorkerSlot& slot) {
+    std::lock_guard<std::mutex> guard(workers_mu_);
+    auto it = std::find_if(workers_.begin(), workers_.end(),
+        [&slot](const std::unique_ptr<WorkerSlot>& ptr) {
+            return ptr.get() == &slot;
+        });
+    if (it == workers_.end()) {
+        return; // Stop already took the slot and will join us
     }
+    exited_workers_.push_back(std::move(*it));
+    workers_.erase(it);
+    TP_LOG_DEBUG("Worker {} retired after {}ms idle; current_threads={}",
+                 static_cast<const void*>(&slot), ToMilliseconds(keep_alive_),
+                 current_threads_.load(std::memory_order_acquire));
 }
 
-void ThreadPool::RetireWorkerUnlocked(WorkerSlot& slot) {
-    std::unique_ptr<WorkerSlot> target_worker;
+void ThreadPool::ReapExitedWorkers() {
+    std::vector<std::unique_ptr<WorkerSlot>> exited;
     {
         std::lock_guard<std::mutex> guard(workers_mu_);
-        // Find the worker to retire
-        auto it = std::find_if(workers_.begin(), workers_.end(),
-            [&slot](const std::unique_ptr<WorkerSlot>& ptr) {
-                return ptr.get() == &slot;
-            });
-        if (it == workers_.end()) {
-            return;
-        }
-        target_worker = std::move(*it);
-        // Erase worker from pool
-        workers_.erase(it);
+        exited.swap(exited_workers_);
     }
-
-    // Wait for worker thread to finish
-    if (target_worker && target_worker->thread.joinable()) {
-        const auto self = std::this_thread::get_id();
-        if (target_worker->thread.get_id() != self) {
-            target_worker->thread.join();
+    // Join outside the lock: the exiting threads still fold their statistics
+    for (auto& slot : exited) {
+        if (slot->thread.joinable()) {
+            slot->thread.join();
         }
     }
-    TP_LOG_DEBUG("Worker {} retired; current_threads={}",
-                 static_cast<const void*>(&slot),
-                 current_threads_.load(std::memory_order_acquire));
 }
 
 void ThreadPool::TriggerLoadCheck() {
@@ -708,7 +1948,7 @@ std::size_t ThreadPool::CurrentThreads() const noexcept {
 }
 
 std::size_t ThreadPool::ActiveThreads() const noexcept {
-    return active_threads_.load(std::memory_order_acquire);
+    return ActiveTasks(); // One task per busy worker
 }
 
 ThreadPool::WorkerCounterHelper::WorkerCounterHelper(ThreadPool& pool, WorkerSlot& slot) noexcept
@@ -720,8 +1960,7 @@ ThreadPool::WorkerCounterHelper::WorkerCounterHelper(ThreadPool& pool, WorkerSlo
 void ThreadPool::WorkerCounterHelper::TaskOn() {
     slot_.idle.store(false, std::memory_order_release); // Mark thread busy
     slot_.idle_nums.store(0, std::memory_order_relaxed); // Reset idle counter
-    pool_.active_threads_.fetch_add(1, std::memory_order_acq_rel);
-    pool_.active_tasks_.fetch_add(1, std::memory_order_acq_rel);
+    slot_.stats.active.store(1, std::memory_order_release);
     normal_end_.store(true, std::memory_order_release);
 }
 
@@ -730,15 +1969,17 @@ void ThreadPool::WorkerCounterHelper::TaskOff() noexcept {
         return;
     }
     normal_end_.store(false, std::memory_order_release);
-    pool_.active_tasks_.fetch_sub(1, std::memory_order_acq_rel);
-    pool_.active_threads_.fetch_sub(1, std::memory_order_acq_rel);
+    slot_.stats.active.store(0, std::memory_order_release);
     slot_.idle.store(true, std::memory_order_release);
     slot_.idle_nums.fetch_add(1, std::memory_order_relaxed);
 }
 
 ThreadPool::WorkerCounterHelper::~WorkerCounterHelper() noexcept {
     TaskOff();
-    pool_.current_threads_.fetch_sub(1, std::memory_order_acq_rel);
+    pool_.FoldWorkerStats(slot_);
+    if (!slot_.retired) {
+        pool_.current_threads_.fetch_sub(1, std::memory_order_acq_rel); // TryRetire already counted it
+    }
     pool_.total_threads_destroyed_.fetch_add(1, std::memory_order_relaxed); // Increment total destroyed
     {
         std::lock_guard<std::mutex> lk(pool_.drain_mtx_);
@@ -751,12 +1992,20 @@ Statistics ThreadPool::GetStatistics() const noexcept {
     Statistics stats;
     // Overview
     stats.statistic_total_submitted = total_submitted_.load(std::memory_order_relaxed);
-    stats.statistic_total_completed = total_completed_.load(std::memory_order_relaxed);
-    stats.statistic_total_failed = total_failed_.load(std::memory_order_relaxed);
+    StatsTotals totals;
+    {
+        std::lock_guard<std::mutex> lk(stats_mu_);
+        totals = AggregateStatsLocked();
+        totals.completed -= stats_base_.completed;
+        totals.failed -= stats_base_.failed;
+        totals.exec_time_ns -= stats_base_.exec_time_ns;
+    }
+    stats.statistic_total_completed = totals.completed;
+    stats.statistic_total_failed = totals.failed;
     stats.statistic_total_cancelled = total_cancelled_.load(std::memory_order_relaxed);
     stats.statistic_total_rejected = total_rejected_.load(std::memory_order_relaxed);
     // Execution time
-    const auto exec_ns = total_exec_time_ns_.load(std::memory_order_acquire);
+    const auto exec_ns = totals.exec_time_ns;
     stats.statistic_total_exec_time = std::chrono::nanoseconds(exec_ns);           
     stats.statistic_avg_exec_time = (stats.statistic_total_completed == 0) 
                                     ? std::chrono::nanoseconds{0} 
@@ -764,8 +2013,18 @@ Statistics ThreadPool::GetStatistics() const noexcept {
     // Load metrics
     const auto pending = Pending();
     stats.statistic_pending_tasks = pending;
+    stats.statistic_pending_high = Pending(TaskPriority::High);
+    stats.statistic_pending_normal = Pending(TaskPriority::Normal);
+    stats.statistic_queue_bytes = queue_.MemoryFootprint();
+    stats.statistic_pending_low = Pending(TaskPriority::Low);
     stats.statistic_busy_ratio = busy_ratio_.load(std::memory_order_relaxed);
-    const auto cap = queue_.Capacity();
+    stats.statistic_queue_wait_ewma = std::chrono::nanoseconds(queue_wait_ewma_ns_.load(std::memory_order_relaxed));
+    stats.statistic_tuned_threads = tuned_threads_.load(std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lk(tuner_mu_);
+        stats.statistic_tuner_samples = tuner_samples_;
+    }
+    const auto cap = LaneCapacity();
     stats.statistic_pending_ratio = cap == 0
         ? 0.0
         : static_cast<double>(pending) / static_cast<double>(cap);
@@ -780,21 +2039,63 @@ Statistics ThreadPool::GetStatistics() const noexcept {
     // Policy-related
     stats.statistic_discard_cnt = DiscardedTasks();
     stats.statistic_overwrite_cnt = OverwrittedTasks();
+    stats.statistic_caller_runs = caller_runs_cnt_.load(std::memory_order_relaxed);
     stats.statistic_paused_wait_cnt = PausedWait();
+    stats.statistic_steal_cnt = StolenTasks();
+    stats.statistic_spin_hits = spin_hit_cnt_.load(std::memory_order_relaxed);
+    stats.statistic_park_cnt = park_cnt_.load(std::memory_order_relaxed);
+    stats.statistic_buffer_flushes = buffer_flush_cnt_.load(std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lk(buffers_mu_);
+        for (const auto* buffer : submit_buffers_) {
+            stats.statistic_buffered_tasks += buffer->Size();
+        }
+    }
+    stats.statistic_blocked_workers = blocked_workers_.load(std::memory_order_relaxed);
+    stats.statistic_blocking_compensations = compensation_cnt_.load(std::memory_order_relaxed);
+
+    // Timers
+    {
+        std::lock_guard<std::mutex> lk(timer_mu_);
+        stats.statistic_pending_timers = timers_.Size() - internal_timers_;
+    }
+    stats.statistic_timers_fired = timers_fired_.load(std::memory_order_relaxed);
     return stats;
 }
 
+LatencyHistograms ThreadPool::GetLatencyHistograms() const {
+    LatencyHistograms out;
+#if TP_LATENCY_HISTOGRAMS
+    std::lock_guard<std::mutex> lk(stats_mu_);
+    AggregateLatencyLocked(out);
+    out.queue_wait.Subtract(latency_base_.queue_wait);
+    out.execution.Subtract(latency_base_.execution);
+    out.end_to_end.Subtract(latency_base_.end_to_end);
+#endif
+    return out;
+}
+
 void ThreadPool::ResetStatistics() noexcept {
     total_submitted_.store(0, std::memory_order_relaxed); 
-    total_completed_.store(0, std::memory_order_relaxed); 
-    total_failed_.store(0, std::memory_order_relaxed); 
     total_cancelled_.store(0, std::memory_order_relaxed); 
     total_rejected_.store(0, std::memory_order_relaxed);
 
-    total_exec_time_ns_.store(0, std::memory_order_relaxed);
+    {
+        // Workers keep counting; later snapshots report the delta from here
+        std::lock_guard<std::mutex> lk(stats_mu_);
+        stats_base_ = AggregateStatsLocked();
+#if TP_LATENCY_HISTOGRAMS
+        AggregateLatencyLocked(latency_base_);
+#endif
+    }
 
     busy_ratio_.store(0.0, std::memory_order_relaxed);
     pending_ratio_.store(0.0, std::memory_order_relaxed);
+    queue_wait_ewma_ns_.store(0, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lk(tuner_mu_);
+        tuner_samples_.clear();
+    }
 
     peak_threads_.store(CurrentThreads(), std::memory_order_relaxed);
     total_threads_created_.store(0, std::memory_order_relaxed);
@@ -802,17 +2103,111 @@ void ThreadPool::ResetStatistics() noexcept {
     
     discard_cnt_.store(0, std::memory_order_relaxed);
     overwrite_cnt_.store(0, std::memory_order_relaxed);
+    caller_runs_cnt_.store(0, std::memory_order_relaxed);
     paused_wait_cnt_.store(0, std::memory_order_relaxed);
+    steal_cnt_.store(0, std::memory_order_relaxed);
+    spin_hit_cnt_.store(0, std::memory_order_relaxed);
+    park_cnt_.store(0, std::memory_order_relaxed);
+    buffer_flush_cnt_.store(0, std::memory_order_relaxed);
+    compensation_cnt_.store(0, std::memory_order_relaxed);
+    timers_fired_.store(0, std::memory_order_relaxed);
 }
 
-void ThreadPool::RecordTaskComplete(const TaskBase& task, std::chrono::steady_clock::duration duration) noexcept {
+void ThreadPool::RecordTaskComplete(WorkerSlot& slot, const Task& task, std::chrono::steady_clock::duration duration) noexcept {
     const auto elapsed_ns = static_cast<std::size_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
-    total_exec_time_ns_.fetch_add(elapsed_ns, std::memory_order_relaxed);  // Accumulate total execution time
-    if (task.Success()) {
-        total_completed_.fetch_add(1, std::memory_order_relaxed);  // Success count +1
+#if TP_LATENCY_HISTOGRAMS
+    // last_active was taken right before the task started, so no extra clock reads here
+    const auto start_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        slot.last_active.time_since_epoch()).count();
+    const bool timed = task.SubmittedNs() != 0;
+    const auto wait_ns = timed ? static_cast<std::uint64_t>(std::max<std::int64_t>(0, start_ns - task.EnqueuedNs())) : 0;
+#endif
+    WorkerStats& s = slot.stats;
+    // Single writer: bump seq to odd, update, bump to even
+    const auto seq = s.seq.load(std::memory_order_relaxed);
+    s.seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    s.exec_time_ns.store(s.exec_time_ns.load(std::memory_order_relaxed) + elapsed_ns, std::memory_order_relaxed);  // Accumulate total execution time
+    if (task->Success()) {
+        s.completed.store(s.completed.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);  // Success count +1
     } else {
-        total_failed_.fetch_add(1, std::memory_order_relaxed);  // Failure count +1
+        s.failed.store(s.failed.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);  // Failure count +1
+    }
+#if TP_LATENCY_HISTOGRAMS
+    if (timed) {
+        s.wait_time_ns.store(s.wait_time_ns.load(std::memory_order_relaxed) + wait_ns, std::memory_order_relaxed);
+        s.waited.store(s.waited.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+#endif
+    s.seq.store(seq + 2, std::memory_order_release);
+#if TP_LATENCY_HISTOGRAMS
+    const auto end_ns = start_ns + static_cast<std::int64_t>(elapsed_ns);
+    slot.latency.execution.Record(elapsed_ns);
+    if (timed) {
+        slot.latency.queue_wait.Record(wait_ns);
+        slot.latency.end_to_end.Record(static_cast<std::uint64_t>(std::max<std::int64_t>(0, end_ns - task.SubmittedNs())));
     }
+#endif
+}
+
+ThreadPool::StatsTotals ThreadPool::SnapshotShard(const WorkerStats& shard) noexcept {
+    StatsTotals out;
+    for (;;) {
+        const auto before = shard.seq.load(std::memory_order_acquire);
+        if (before & 1) {
+            std::this_thread::yield(); // Writer mid-update
+            continue;
+        }
+        out.completed = shard.completed.load(std::memory_order_relaxed);
+        out.failed = shard.failed.load(std::memory_order_relaxed);
+        out.exec_time_ns = shard.exec_time_ns.load(std::memory_order_relaxed);
+        out.wait_time_ns = shard.wait_time_ns.load(std::memory_order_relaxed);
+        out.waited = shard.waited.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (shard.seq.load(std::memory_order_relaxed) == before) {
+            return out;
+        }
+    }
+}
+
+ThreadPool::StatsTotals ThreadPool::AggregateStatsLocked() const noexcept {
+    StatsTotals sum = stats_retired_;
+    for (const WorkerSlot* slot : stats_shards_) {
+        const auto shard = SnapshotShard(slot->stats);
+        sum.completed += shard.completed;
+        sum.failed += shard.failed;
+        sum.exec_time_ns += shard.exec_time_ns;
+        sum.wait_time_ns += shard.wait_time_ns;
+        sum.waited += shard.waited;
+    }
+    return sum;
+}
+
+#if TP_LATENCY_HISTOGRAMS
+void ThreadPool::AggregateLatencyLocked(LatencyHistograms& out) const noexcept {
+    out = latency_retired_;
+    for (const WorkerSlot* slot : stats_shards_) {
+        slot->latency.queue_wait.AddTo(out.queue_wait);
+        slot->latency.execution.AddTo(out.execution);
+        slot->latency.end_to_end.AddTo(out.end_to_end);
+    }
+}
+#endif
+
+void ThreadPool::FoldWorkerStats(WorkerSlot& slot) noexcept {
+    std::lock_guard<std::mutex> lk(stats_mu_);
+    const auto shard = SnapshotShard(slot.stats);
+    stats_retired_.completed += shard.completed;
+    stats_retired_.failed += shard.failed;
+    stats_retired_.exec_time_ns += shard.exec_time_ns;
+    stats_retired_.wait_time_ns += shard.wait_time_ns;
+    stats_retired_.waited += shard.waited;
+#if TP_LATENCY_HISTOGRAMS
+    slot.latency.queue_wait.AddTo(latency_retired_.queue_wait);
+    slot.latency.execution.AddTo(latency_retired_.execution);
+    slot.latency.end_to_end.AddTo(latency_retired_.end_to_end);
+#endif
+    stats_shards_.erase(std::remove(stats_shards_.begin(), stats_shards_.end(), &slot), stats_shards_.end());
 }
 
 void ThreadPool::RecordTaskCancel() noexcept {
@@ -5,12 +5,14 @@ Blocking queue adapter tests
 #include "mpmc/blocking_queue_adapter.hpp"
 
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <thread>
 #include <future>
 #include <atomic>
 #include <vector>
 #include <chrono>
 #include <mutex>
+#include <iterator>
 
 using namespace std::chrono_literals;
 
@@ -63,6 +65,225 @@ TEST(BlockingQueueAdapter, DiscardCounter) {
     EXPECT_TRUE(q.DiscardCount() >= 1u);
 }
 
+// Overwrite keeps the queue full and hands back the oldest item
+TEST(BlockingQueueAdapter, OverwritePush) {
+    BlockingQueueAdapter<int> q(2);
+    int old = -1;
+    EXPECT_TRUE(q.OverwritePush(1, &old));
+    EXPECT_TRUE(q.OverwritePush(2, &old));
+    EXPECT_EQ(old, -1);
+    EXPECT_TRUE(q.OverwritePush(3, &old));
+    EXPECT_EQ(old, 1);
+    EXPECT_TRUE(q.OverwritePush(4, nullptr));
+    EXPECT_EQ(q.Size(), 2u);
+
+    int x = 0;
+    EXPECT_TRUE(q.TryPop(x));
+    EXPECT_EQ(x, 3);
+    EXPECT_TRUE(q.TryPop(x));
+    EXPECT_EQ(x, 4);
+    EXPECT_EQ(q.Size(), 0u);
+
+    q.Close();
+    EXPECT_FALSE(q.OverwritePush(5, &old));
+}
+
+// SPSC adapter: one producer thread, one consumer thread, blocking on both sides
+TEST(BlockingQueueAdapter, SingleProducerSingleConsumer) {
+    BlockingQueueAdapter<int, PaddedCellLayout, SingleProducer, SingleConsumer> q(4);
+    constexpr int kTotal = 20000;
+    std::thread producer([&] {
+        for (int i = 0; i < kTotal; ++i) {
+            ASSERT_TRUE(q.WaitPush(i));
+        }
+    });
+    int x = -1;
+    for (int i = 0; i < kTotal; ++i) {
+        ASSERT_TRUE(q.WaitPop(x));
+        ASSERT_EQ(x, i);
+    }
+    producer.join();
+    EXPECT_EQ(q.Size(), 0u);
+}
+
+// OwnerRing: the bound thread fills its own ring, others the shared one; consumers see both
+TEST(BlockingQueueAdapter, OwnerRing) {
+    EventCount ready;
+    BlockingQueueAdapter<int> q(2, ready, QueueStorage::OwnerRing);
+    EXPECT_TRUE(q.OwnerRing());
+    EXPECT_EQ(q.Capacity(), 4u);  // both rings
+    q.BindProducer();
+    EXPECT_TRUE(q.TryPush(1));
+    EXPECT_TRUE(q.TryPush(2));
+    EXPECT_FALSE(q.TryPush(3));  // owned ring full
+    std::thread other([&] {
+        EXPECT_TRUE(q.TryPush(10));
+        EXPECT_TRUE(q.TryPush(11));
+        EXPECT_FALSE(q.TryPush(12));  // shared ring full
+    });
+    other.join();
+    EXPECT_EQ(q.Size(), 4u);
+    EXPECT_EQ(q.MemoryFootprint(), 2 * BlockingQueueAdapter<int>(2).MemoryFootprint());
+
+    // A producer parked on the full owned ring is woken by pops from either ring
+    std::promise<void> pushed;
+    std::thread owner([&] {
+        q.BindProducer();
+        EXPECT_TRUE(q.WaitPush(4));
+        pushed.set_value();
+    });
+    std::vector<int> out;
+    q.TryPopBatch(std::back_inserter(out), 3);
+    ASSERT_EQ(out.size(), 3u);
+    EXPECT_EQ(pushed.get_future().wait_for(2s), std::future_status::ready);
+    owner.join();
+    int x = 0;
+    while (q.TryPop(x)) {
+        out.push_back(x);
+    }
+    EXPECT_EQ(q.Size(), 0u);
+    // Everything comes out once, in order within each ring
+    auto sorted = out;
+    std::sort(sorted.begin(), sorted.end());
+    EXPECT_EQ(sorted, (std::vector<int>{1, 2, 4, 10, 11}));
+    auto at = [&](int v) { return std::find(out.begin(), out.end(), v) - out.begin(); };
+    EXPECT_LT(at(1), at(2));
+    EXPECT_LT(at(2), at(4));
+    EXPECT_LT(at(10), at(11));
+}
+
+// OwnerRing: a shared ring that never runs dry does not starve the owner's tasks
+TEST(BlockingQueueAdapter, OwnerRingAlternatesRings) {
+    EventCount ready;
+    BlockingQueueAdapter<int> q(4, ready, QueueStorage::OwnerRing);
+    std::thread owner([&] {
+        q.BindProducer();
+        EXPECT_TRUE(q.TryPush(1));
+        EXPECT_TRUE(q.TryPush(2));
+    });
+    owner.join();
+    int next = 100;
+    while (q.TryPush(next)) {  // the shared ring
+        ++next;
+    }
+    std::vector<int> owned;
+    for (int i = 0; i < 4; ++i) {
+        int x = 0;
+        ASSERT_TRUE(q.TryPop(x));
+        if (x < 100) {
+            owned.push_back(x);
+        } else {
+            EXPECT_TRUE(q.TryPush(next++));  // keep the shared ring full
+        }
+    }
+    EXPECT_EQ(owned, (std::vector<int>{1, 2}));
+
+    // Batches alternate their starting ring the same way
+    std::thread again([&] {
+        q.BindProducer();
+        EXPECT_TRUE(q.TryPush(3));
+    });
+    again.join();
+    std::vector<int> out;
+    for (int i = 0; i < 2 && std::find(out.begin(), out.end(), 3) == out.end(); ++i) {
+        q.TryPopBatch(std::back_inserter(out), 1);
+        q.TryPush(next++);
+    }
+    EXPECT_NE(std::find(out.begin(), out.end(), 3), out.end());
+}
+
+// Sharded: capacity is split over the shards, a full home shard spills into the others, and
+// pops, Size() and Clear() cover every shard
+TEST(BlockingQueueAdapter, ShardedSpillsAndDrains) {
+    EventCount ready;
+    BlockingQueueAdapter<int> q(16, ready, QueueStorage::Sharded, 4);
+    EXPECT_EQ(q.Shards(), 4u);
+    EXPECT_EQ(q.Capacity(), 16u);
+    for (int i = 0; i < 16; ++i) {
+        ASSERT_TRUE(q.TryPush(i)) << i;
+    }
+    EXPECT_FALSE(q.TryPush(16));
+    EXPECT_EQ(q.Size(), 16u);
+    EXPECT_EQ(q.DiscardCount(), 1u);
+
+    std::vector<int> out;
+    EXPECT_EQ(q.TryPopBatch(std::back_inserter(out), 10), 10u);
+    std::vector<int> batch{100, 101, 102, 103, 104, 105};
+    EXPECT_EQ(q.TryPushBatch(batch.begin(), batch.end()), 6u);
+    EXPECT_EQ(q.Size(), 12u);
+    int x = 0;
+    while (q.TryPop(x)) {
+        out.push_back(x);
+    }
+    std::sort(out.begin(), out.end());
+    std::vector<int> expected;
+    for (int i = 0; i < 16; ++i) {
+        expected.push_back(i);
+    }
+    expected.insert(expected.end(), batch.begin(), batch.end());
+    EXPECT_EQ(out, expected);
+
+    q.TryPush(1);
+    q.TryPush(2);
+    q.Clear();
+    EXPECT_EQ(q.Size(), 0u);
+    EXPECT_FALSE(q.TryPop(x));
+}
+
+// Sharded overwrite only evicts once every shard is full
+TEST(BlockingQueueAdapter, ShardedOverwriteSpillsFirst) {
+    EventCount ready;
+    BlockingQueueAdapter<int> q(16, ready, QueueStorage::Sharded, 4);
+    int evicted = -1;
+    for (int i = 0; i < 16; ++i) {
+        ASSERT_TRUE(q.OverwritePush(int{i}, &evicted));
+        EXPECT_EQ(evicted, -1) << i;
+    }
+    EXPECT_EQ(q.Size(), 16u);
+    ASSERT_TRUE(q.OverwritePush(16, &evicted));
+    EXPECT_NE(evicted, -1);
+    EXPECT_EQ(q.Size(), 16u);
+}
+
+TEST(BlockingQueueAdapter, ShardedMultiThreaded) {
+    for (auto routing : {ShardRouting::Home, ShardRouting::TwoChoice}) {
+        EventCount ready;
+        BlockingQueueAdapter<int> q(64, ready, QueueStorage::Sharded, 4, routing);
+        constexpr int kProducers = 4;
+        constexpr int kPerProducer = 5000;
+        std::vector<std::atomic<int>> seen(kProducers * kPerProducer);
+        std::vector<std::thread> threads;
+        for (int p = 0; p < kProducers; ++p) {
+            threads.emplace_back([&, p] {
+                for (int i = 0; i < kPerProducer; ++i) {
+                    ASSERT_TRUE(q.WaitPush(p * kPerProducer + i));
+                }
+            });
+        }
+        for (int c = 0; c < 3; ++c) {
+            threads.emplace_back([&] {
+                int v = 0;
+                while (q.WaitPop(v)) {
+                    seen[v].fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+        }
+        for (int p = 0; p < kProducers; ++p) {
+            threads[p].join();
+        }
+        while (q.Size() != 0) {
+            std::this_thread::yield();
+        }
+        q.Close();
+        for (std::size_t t = kProducers; t < threads.size(); ++t) {
+            threads[t].join();
+        }
+        for (auto& s : seen) {
+            ASSERT_EQ(s.load(), 1);
+        }
+    }
+}
+
 // Blocking Pop
 TEST(BlockingQueueAdapter, WaitPop) {
     BlockingQueueAdapter<int> q(4);
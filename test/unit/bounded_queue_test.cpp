@@ -8,7 +8,10 @@ Ring buffer (bounded queue) tests
 #include <thread>
 #include <vector>
 #include <atomic>
+#include <mutex>
 #include <stdexcept>
+#include <iterator>
+#include <cstdint>
 
 // Constructor tests
 TEST(BoundedCircularQueueTest, Constructors) {
@@ -159,6 +162,364 @@ TEST(BoundedCircularQueueTest, MultiThreaded) {
     EXPECT_GE(count_seen, N * 95 / 100);
 }
 
+// Batch operations claim a contiguous range and stop at full/empty
+TEST(BoundedCircularQueueTest, BatchPushPop) {
+    BoundedCircularQueue<int> queue(8);
+    std::vector<int> in{1, 2, 3, 4, 5, 6};
+    EXPECT_EQ(queue.TryPushBatch(in.begin(), in.end()), 6u);
+    // Only two free cells remain
+    EXPECT_EQ(queue.TryPushBatch(in.begin(), in.end()), 2u);
+    EXPECT_TRUE(queue.Full());
+
+    std::vector<int> out;
+    EXPECT_EQ(queue.TryPopBatch(std::back_inserter(out), 5), 5u);
+    EXPECT_EQ(out, (std::vector<int>{1, 2, 3, 4, 5}));
+
+    // Wrap around the ring and drain the rest
+    EXPECT_EQ(queue.TryPushBatch(in.begin(), in.begin() + 4), 4u);
+    out.clear();
+    EXPECT_EQ(queue.TryPopBatch(std::back_inserter(out), 100), 7u);
+    EXPECT_EQ(out, (std::vector<int>{6, 1, 2, 1, 2, 3, 4}));
+    EXPECT_EQ(queue.TryPopBatch(std::back_inserter(out), 4), 0u);
+    EXPECT_TRUE(queue.Empty());
+}
+
+// Drop-oldest push reuses the oldest cell once the ring is full
+TEST(BoundedCircularQueueTest, OverwritePushDropsOldest) {
+    BoundedCircularQueue<int> queue(4);
+    std::vector<int> evicted;
+    auto keep = [&](int&& old) { evicted.push_back(old); };
+    for (int i = 1; i <= 4; ++i) {
+        EXPECT_FALSE(queue.OverwritePush(int{i}, keep));  // room left: a plain push
+    }
+    EXPECT_TRUE(queue.OverwritePush(5, keep));
+    EXPECT_TRUE(queue.OverwritePush(6, keep));
+    EXPECT_EQ(evicted, (std::vector<int>{1, 2}));
+    EXPECT_TRUE(queue.Full());
+
+    std::vector<int> out;
+    EXPECT_EQ(queue.TryPopBatch(std::back_inserter(out), 8), 4u);
+    EXPECT_EQ(out, (std::vector<int>{3, 4, 5, 6}));
+    EXPECT_FALSE(queue.OverwritePush(7, keep));
+    EXPECT_EQ(evicted.size(), 2u);
+}
+
+// Saturated producers racing consumers: every element is popped or evicted exactly once
+TEST(BoundedCircularQueueTest, OverwriteMultiThreaded) {
+    BoundedCircularQueue<int> queue(64);
+    constexpr int kProducers = 8;
+    constexpr int kPerProducer = 20000;
+    constexpr int kTotal = kProducers * kPerProducer;
+    std::vector<std::atomic<int>> hits(kTotal);
+    std::atomic<int> producers_left{kProducers};
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < kProducers; ++p) {
+        threads.emplace_back([&, p] {
+            for (int i = 0; i < kPerProducer; ++i) {
+                queue.OverwritePush(p * kPerProducer + i, [&](int&& old) {
+                    hits[old].fetch_add(1, std::memory_order_relaxed);
+                });
+            }
+            producers_left.fetch_sub(1, std::memory_order_release);
+        });
+    }
+    for (int c = 0; c < 2; ++c) {
+        threads.emplace_back([&] {
+            int item;
+            while (producers_left.load(std::memory_order_acquire) > 0) {
+                if (queue.TryPop(item)) {
+                    hits[item].fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    int item;
+    while (queue.TryPop(item)) {
+        hits[item].fetch_add(1, std::memory_order_relaxed);
+    }
+    for (int i = 0; i < kTotal; ++i) {
+        ASSERT_EQ(hits[i].load(), 1) << "element " << i;
+    }
+    EXPECT_TRUE(queue.Empty());
+}
+
+// Concurrent batch producers/consumers deliver every element exactly once
+TEST(BoundedCircularQueueTest, BatchMultiThreaded) {
+    BoundedCircularQueue<int> queue(256);
+    constexpr int kProducers = 3;
+    constexpr int kPerProducer = 30000;
+    constexpr int kTotal = kProducers * kPerProducer;
+    std::vector<std::atomic<int>> seen(kTotal);
+    std::atomic<int> consumed{0};
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < kProducers; ++p) {
+        threads.emplace_back([&queue, p] {
+            std::vector<int> batch;
+            int next = p * kPerProducer;
+            const int end = next + kPerProducer;
+            while (next < end) {
+                batch.clear();
+                for (int i = 0; i < 17 && next + i < end; ++i) {
+                    batch.push_back(next + i);
+                }
+                next += static_cast<int>(queue.TryPushBatch(batch.begin(), batch.end()));
+            }
+        });
+    }
+    for (int c = 0; c < 2; ++c) {
+        threads.emplace_back([&] {
+            while (consumed.load(std::memory_order_relaxed) < kTotal) {
+                const auto n = queue.TryConsumeBatch([&](int&& v) {
+                    seen[v].fetch_add(1, std::memory_order_relaxed);
+                }, 32);
+                consumed.fetch_add(static_cast<int>(n), std::memory_order_relaxed);
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    EXPECT_EQ(consumed.load(), kTotal);
+    for (int i = 0; i < kTotal; ++i) {
+        ASSERT_EQ(seen[i].load(), 1) << "value " << i;
+    }
+}
+
+// Every cell layout keeps FIFO order, wrap-around and batch behaviour
+template <typename Layout>
+class BoundedCircularQueueLayoutTest : public ::testing::Test {};
+using CellLayouts = ::testing::Types<PaddedCellLayout, PackedCellLayout, StripedCellLayout>;
+TYPED_TEST_SUITE(BoundedCircularQueueLayoutTest, CellLayouts);
+
+TYPED_TEST(BoundedCircularQueueLayoutTest, FifoAcrossWrapAround) {
+    BoundedCircularQueue<std::uint64_t, TypeParam> queue(64);
+    std::uint64_t next_in = 0;
+    std::uint64_t next_out = 0;
+    std::uint64_t item = 0;
+    for (int round = 0; round < 10; ++round) {
+        while (queue.TryPush(next_in)) {
+            ++next_in;
+        }
+        EXPECT_TRUE(queue.Full());
+        for (int i = 0; i < 40 && queue.TryPop(item); ++i) {
+            ASSERT_EQ(item, next_out++);
+        }
+    }
+    std::vector<std::uint64_t> rest;
+    queue.TryPopBatch(std::back_inserter(rest), 64);
+    for (auto v : rest) {
+        ASSERT_EQ(v, next_out++);
+    }
+    EXPECT_EQ(next_out, next_in);
+}
+
+TYPED_TEST(BoundedCircularQueueLayoutTest, MultiThreadedBatch) {
+    BoundedCircularQueue<std::uint64_t, TypeParam> queue(128);
+    constexpr std::uint64_t kTotal = 40000;
+    std::atomic<std::uint64_t> sum{0};
+    std::atomic<std::uint64_t> popped{0};
+
+    std::thread producer([&] {
+        std::uint64_t next = 1;
+        std::vector<std::uint64_t> batch;
+        while (next <= kTotal) {
+            batch.clear();
+            for (std::uint64_t v = next; v < next + 8 && v <= kTotal; ++v) {
+                batch.push_back(v);
+            }
+            next += queue.TryPushBatch(batch.begin(), batch.end());
+        }
+    });
+    std::vector<std::thread> consumers;
+    for (int c = 0; c < 2; ++c) {
+        consumers.emplace_back([&] {
+            std::uint64_t item = 0;
+            while (popped.load(std::memory_order_relaxed) < kTotal) {
+                if (queue.TryPop(item)) {
+                    sum.fetch_add(item, std::memory_order_relaxed);
+                    popped.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+    producer.join();
+    for (auto& t : consumers) {
+        t.join();
+    }
+    EXPECT_EQ(sum.load(), kTotal * (kTotal + 1) / 2);
+}
+
+// Packed/striped layouts drop the per-cell cache-line padding
+TEST(BoundedCircularQueueTest, LayoutFootprint) {
+    BoundedCircularQueue<std::uint64_t, PaddedCellLayout> padded(1024);
+    BoundedCircularQueue<std::uint64_t, PackedCellLayout> packed(1024);
+    BoundedCircularQueue<std::uint64_t, StripedCellLayout> striped(1024);
+    EXPECT_EQ(padded.MemoryFootprint(), 1024u * 64u);
+    EXPECT_EQ(packed.MemoryFootprint(), 1024u * 16u);
+    EXPECT_EQ(striped.MemoryFootprint(), packed.MemoryFootprint());
+}
+
+// Producer/consumer cardinality policies, each run with as many threads as it allows
+template <typename P, typename C, int kProducerThreads, int kConsumerThreads>
+struct Cardinality {
+    using Producers = P;
+    using Consumers = C;
+    static constexpr int kProducers = kProducerThreads;
+    static constexpr int kConsumers = kConsumerThreads;
+};
+template <typename Card>
+class BoundedCircularQueueCardinalityTest : public ::testing::Test {
+protected:
+    using Queue = BoundedCircularQueue<std::uint64_t, PaddedCellLayout,
+                                       typename Card::Producers, typename Card::Consumers>;
+};
+using Cardinalities = ::testing::Types<Cardinality<MultiProducer, MultiConsumer, 3, 3>,
+                                       Cardinality<MultiProducer, SingleConsumer, 3, 1>,
+                                       Cardinality<SingleProducer, MultiConsumer, 1, 3>,
+                                       Cardinality<SingleProducer, SingleConsumer, 1, 1>>;
+TYPED_TEST_SUITE(BoundedCircularQueueCardinalityTest, Cardinalities);
+
+TYPED_TEST(BoundedCircularQueueCardinalityTest, FifoAcrossWrapAround) {
+    typename TestFixture::Queue queue(16);
+    std::uint64_t next_in = 0;
+    std::uint64_t next_out = 0;
+    std::uint64_t item = 0;
+    EXPECT_FALSE(queue.TryPop(item));
+    for (int round = 0; round < 10; ++round) {
+        while (queue.TryPush(next_in)) {
+            ++next_in;
+        }
+        EXPECT_TRUE(queue.Full());
+        EXPECT_TRUE(queue.TryFront(item));
+        EXPECT_EQ(item, next_out);
+        for (int i = 0; i < 5 && queue.TryPop(item); ++i) {
+            ASSERT_EQ(item, next_out++);
+        }
+        std::vector<std::uint64_t> batch{next_in, next_in + 1, next_in + 2, next_in + 3};
+        next_in += queue.TryPushBatch(batch.begin(), batch.end());
+        queue.TryConsumeBatch([&](std::uint64_t&& v) {
+            ASSERT_EQ(v, next_out++);
+        }, 6);
+    }
+    std::vector<std::uint64_t> rest;
+    queue.TryPopBatch(std::back_inserter(rest), 16);
+    for (auto v : rest) {
+        ASSERT_EQ(v, next_out++);
+    }
+    EXPECT_EQ(next_out, next_in);
+    EXPECT_TRUE(queue.Empty());
+}
+
+TYPED_TEST(BoundedCircularQueueCardinalityTest, MultiThreaded) {
+    constexpr int kProducers = TypeParam::kProducers;
+    constexpr int kConsumers = TypeParam::kConsumers;
+    constexpr std::uint64_t kPerProducer = 10000;
+    constexpr std::uint64_t kTotal = kPerProducer * kProducers;
+    typename TestFixture::Queue queue(64);
+    std::vector<std::atomic<int>> seen(kTotal);
+    std::atomic<std::uint64_t> popped{0};
+    std::atomic<bool> in_order{true};
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < kProducers; ++p) {
+        threads.emplace_back([&, p] {
+            // Values p, p + kProducers, ...; every other round goes through TryPushBatch
+            std::uint64_t i = 0;
+            std::vector<std::uint64_t> batch;
+            while (i < kPerProducer) {
+                std::uint64_t pushed = 0;
+                if (i % 2 == 0) {
+                    pushed = queue.TryPush(i * kProducers + p) ? 1 : 0;
+                } else {
+                    batch.clear();
+                    for (std::uint64_t j = i; j < i + 5 && j < kPerProducer; ++j) {
+                        batch.push_back(j * kProducers + p);
+                    }
+                    pushed = queue.TryPushBatch(batch.begin(), batch.end());
+                }
+                if (pushed == 0) {
+                    std::this_thread::yield();
+                }
+                i += pushed;
+            }
+        });
+    }
+    for (int c = 0; c < kConsumers; ++c) {
+        threads.emplace_back([&] {
+            // A single consumer sees each producer's values in order
+            std::vector<std::uint64_t> last(kProducers, 0);
+            std::vector<bool> any(kProducers, false);
+            auto take = [&](std::uint64_t v) {
+                seen[v].fetch_add(1, std::memory_order_relaxed);
+                const auto p = v % kProducers;
+                if (kConsumers == 1 && any[p] && v <= last[p]) {
+                    in_order.store(false, std::memory_order_relaxed);
+                }
+                any[p] = true;
+                last[p] = v;
+            };
+            std::uint64_t item = 0;
+            while (popped.load(std::memory_order_relaxed) < kTotal) {
+                std::uint64_t n = 0;
+                if (queue.TryPop(item)) {
+                    take(item);
+                    ++n;
+                }
+                n += queue.TryConsumeBatch([&](std::uint64_t&& v) { take(v); }, 7);
+                if (n == 0) {
+                    std::this_thread::yield();
+                }
+                popped.fetch_add(n, std::memory_order_relaxed);
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    EXPECT_TRUE(in_order.load());
+    for (std::uint64_t v = 0; v < kTotal; ++v) {
+        ASSERT_EQ(seen[v].load(), 1) << "value " << v;
+    }
+}
+
+// A single producer takes its ticket back when construction throws
+struct ThrowOnNegative {
+    int v{0};
+    ThrowOnNegative() = default;
+    explicit ThrowOnNegative(int x) : v(x) {
+        if (x < 0) {
+            throw std::runtime_error("negative");
+        }
+    }
+};
+
+TEST(BoundedCircularQueueTest, SingleProducerThrowingPush) {
+    BoundedCircularQueue<ThrowOnNegative, PaddedCellLayout, SingleProducer, MultiConsumer> spmc(4);
+    BoundedCircularQueue<ThrowOnNegative, PaddedCellLayout, SingleProducer, SingleConsumer> spsc(4);
+    auto check = [](auto& queue) {
+        EXPECT_TRUE(queue.TryEmplace(1));
+        EXPECT_THROW(queue.TryEmplace(-1), std::runtime_error);
+        EXPECT_EQ(queue.ApproxSize(), 1u);
+        EXPECT_TRUE(queue.TryEmplace(2));
+        ThrowOnNegative out;
+        ASSERT_TRUE(queue.TryPop(out));
+        EXPECT_EQ(out.v, 1);
+        ASSERT_TRUE(queue.TryPop(out));
+        EXPECT_EQ(out.v, 2);
+        EXPECT_FALSE(queue.TryPop(out));
+    };
+    check(spmc);
+    check(spsc);
+}
+
 struct Counted {
     static std::atomic<int> live;
     int v;
@@ -0,0 +1,179 @@
+/*
+Coroutine support tests (THREADPOOL_ENABLE_COROUTINES builds only)
+*/
+
+#include "thread_pool/coroutine.hpp"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace coro = thread_pool::coro;
+
+namespace {
+
+coro::Task<std::thread::id> HopAndReportThread(thread_pool::ThreadPool& pool) {
+    co_await pool.Schedule();
+    co_return std::this_thread::get_id();
+}
+
+coro::Task<int> Square(thread_pool::ThreadPool& pool, int x) {
+    co_await pool.Schedule();
+    co_return x * x;
+}
+
+coro::Task<int> SumOfSquares(thread_pool::ThreadPool& pool, int n) {
+    int total = 0;
+    for (int i = 1; i <= n; ++i) {
+        total += co_await Square(pool, i);
+    }
+    co_return total;
+}
+
+// Resumed either way: on a worker, or by whoever cancels the queued resumption
+coro::Task<std::thread::id> HopOrCancelled(thread_pool::ThreadPool& pool, std::atomic<bool>& cancelled) {
+    try {
+        co_await pool.Schedule();
+    } catch (const std::runtime_error&) {
+        cancelled.store(true);
+    }
+    co_return std::this_thread::get_id();
+}
+
+coro::Task<int> Throws(thread_pool::ThreadPool& pool) {
+    co_await pool.Schedule();
+    throw std::runtime_error("step failed");
+}
+
+coro::Task<int> Depth(int n) {
+    if (n == 0) {
+        co_return 0;
+    }
+    co_return 1 + co_await Depth(n - 1);
+}
+
+coro::Task<std::unique_ptr<std::string>> MoveOnly() {
+    co_return std::make_unique<std::string>("moved");
+}
+
+}
+
+TEST(Coroutine, ScheduleResumesOnWorker) {
+    thread_pool::ThreadPool pool(2, 64);
+    pool.Start();
+    const auto worker = coro::SyncWait(HopAndReportThread(pool));
+    EXPECT_NE(worker, std::this_thread::get_id());
+    pool.Stop(thread_pool::StopMode::Graceful);
+}
+
+TEST(Coroutine, AwaitedTasksChainResults) {
+    thread_pool::ThreadPool pool(2, 64);
+    pool.Start();
+    EXPECT_EQ(coro::SyncWait(SumOfSquares(pool, 50)), 42925);
+    EXPECT_EQ(*coro::SyncWait(MoveOnly()), "moved");
+    EXPECT_EQ(coro::SyncWait(Depth(1000)), 1000);
+    pool.Stop(thread_pool::StopMode::Graceful);
+}
+
+// Synchronously completing awaits must not nest resumes, whatever the optimisation level
+TEST(Coroutine, LongAwaitLoopStaysFlat) {
+    auto loop = []() -> coro::Task<long> {
+        long total = 0;
+        for (int i = 0; i < 1000000; ++i) {
+            total += co_await Depth(0);
+        }
+        co_return total + 1;
+    };
+    EXPECT_EQ(coro::SyncWait(loop()), 1);
+}
+
+TEST(Coroutine, ExceptionsPropagateThroughAwait) {
+    thread_pool::ThreadPool pool(2, 64);
+    pool.Start();
+    EXPECT_THROW(coro::SyncWait(Throws(pool)), std::runtime_error);
+    pool.Stop(thread_pool::StopMode::Graceful);
+}
+
+TEST(Coroutine, ScheduleOnStoppedPoolThrowsInsteadOfHanging) {
+    thread_pool::ThreadPool pool(1, 16);
+    pool.Start();
+    pool.Stop(thread_pool::StopMode::Graceful);
+    EXPECT_THROW(coro::SyncWait(Square(pool, 3)), std::runtime_error);
+}
+
+TEST(Coroutine, SpawnRunsDetachedCoroutines) {
+    thread_pool::ThreadPool pool(4, 256);
+    pool.Start();
+    std::atomic<int> done{0};
+    constexpr int N = 200;
+    auto step = [](thread_pool::ThreadPool& p, std::atomic<int>& counter) -> coro::Task<void> {
+        for (int i = 0; i < 10; ++i) {
+            co_await p.Schedule(i % 2 ? thread_pool::TaskPriority::High : thread_pool::TaskPriority::Normal);
+        }
+        counter.fetch_add(1);
+    };
+    for (int i = 0; i < N; ++i) {
+        coro::Spawn(pool, step(pool, done));
+    }
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (done.load() < N && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(done.load(), N);
+    pool.Stop(thread_pool::StopMode::Graceful);
+}
+
+// A timer firing that overwrites a queued resumption leaves its Cancel() to a worker: the
+// coroutine must never resume on the timer thread
+TEST(Coroutine, TimerOverwriteResumesOnWorker) {
+    using namespace std::chrono_literals;
+    thread_pool::ThreadPoolConfig cfg;
+    cfg.core_threads = 1;
+    cfg.max_threads = 1;
+    cfg.queue_cap = 4;
+    cfg.queue_policy = thread_pool::QueueFullPolicy::Overwrite;
+    thread_pool::ThreadPool pool(cfg);
+    pool.Start();
+
+    std::atomic<bool> gate{false};
+    std::atomic<bool> started{false};
+    std::thread::id worker;
+    pool.Post([&] {
+        worker = std::this_thread::get_id();
+        started.store(true);
+        while (!gate.load()) {
+            std::this_thread::sleep_for(1ms);
+        }
+    });
+    while (!started.load()) {
+        std::this_thread::yield();
+    }
+
+    std::atomic<bool> cancelled{false};
+    std::atomic<bool> resumed{false};
+    std::thread::id resumed_on;
+    std::thread awaiter([&] {
+        resumed_on = coro::SyncWait(HopOrCancelled(pool, cancelled));
+        resumed.store(true);
+    });
+    while (pool.Pending() == 0) {
+        std::this_thread::yield();
+    }
+    while (pool.TryPost([] {})) {
+    }
+    ASSERT_NE(pool.ScheduleAfter(1ms, [] {}), 0u);  // evicts the resumption, the oldest task
+
+    std::this_thread::sleep_for(20ms);
+    EXPECT_FALSE(resumed.load());  // the only worker is still busy
+    gate.store(true);
+    awaiter.join();
+    EXPECT_TRUE(cancelled.load());
+    EXPECT_EQ(resumed_on, worker);
+    EXPECT_EQ(pool.GetStatistics().statistic_overwrite_cnt, 1u);
+    pool.Stop(thread_pool::StopMode::Graceful);
+}
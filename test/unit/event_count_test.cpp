@@ -0,0 +1,112 @@
+/*
+EventCount tests
+*/
+
+#include "mpmc/event_count.hpp"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+// Notify without a registered waiter is a no-op; a cancelled wait leaves no waiter behind
+TEST(EventCountTest, IdleNotifyAndCancel) {
+    EventCount ec;
+    ec.Notify();
+    ec.NotifyAll();
+    EXPECT_EQ(ec.Waiters(), 0u);
+
+    const auto key = ec.PrepareWait();
+    EXPECT_EQ(ec.Waiters(), 1u);
+    ec.CancelWait();
+    EXPECT_EQ(ec.Waiters(), 0u);
+
+    // The epoch did not move, so a timed wait on the same key must time out
+    const auto key2 = ec.PrepareWait();
+    EXPECT_EQ(key, key2);
+    EXPECT_FALSE(ec.WaitUntil(key2, std::chrono::steady_clock::now() + 10ms));
+    EXPECT_EQ(ec.Waiters(), 0u);
+}
+
+// A notify between PrepareWait and Wait is not lost
+TEST(EventCountTest, NotifyBeforeWaitIsObserved) {
+    EventCount ec;
+    const auto key = ec.PrepareWait();
+    ec.Notify();
+    ec.Wait(key); // Returns immediately
+    EXPECT_EQ(ec.Waiters(), 0u);
+}
+
+// Parked waiters wake on Notify; the flag they wait for is always visible after waking
+TEST(EventCountTest, WakesParkedWaiters) {
+    EventCount ec;
+    std::atomic<int> ready{0};
+    std::atomic<int> woken{0};
+    constexpr int kWaiters = 4;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kWaiters; ++i) {
+        threads.emplace_back([&] {
+            for (;;) {
+                if (ready.load(std::memory_order_acquire)) {
+                    break;
+                }
+                const auto key = ec.PrepareWait();
+                if (ready.load(std::memory_order_acquire)) {
+                    ec.CancelWait();
+                    break;
+                }
+                ec.Wait(key);
+            }
+            woken.fetch_add(1);
+        });
+    }
+    std::this_thread::sleep_for(20ms);
+    ready.store(1, std::memory_order_release);
+    ec.NotifyAll();
+    for (auto& t : threads) {
+        t.join();
+    }
+    EXPECT_EQ(woken.load(), kWaiters);
+    EXPECT_EQ(ec.Waiters(), 0u);
+}
+
+// Ping-pong handoff: every token must be delivered with no lost wake-ups
+TEST(EventCountTest, PingPongNoLostWakeups) {
+    EventCount ec;
+    std::atomic<int> turn{0};
+    constexpr int kRounds = 20000;
+
+    auto wait_for_turn = [&](int want) {
+        for (;;) {
+            if (turn.load(std::memory_order_acquire) == want) {
+                return;
+            }
+            const auto key = ec.PrepareWait();
+            if (turn.load(std::memory_order_acquire) == want) {
+                ec.CancelWait();
+                return;
+            }
+            ec.Wait(key);
+        }
+    };
+
+    std::thread other([&] {
+        for (int i = 0; i < kRounds; ++i) {
+            wait_for_turn(1);
+            turn.store(0, std::memory_order_release);
+            ec.NotifyAll();
+        }
+    });
+    for (int i = 0; i < kRounds; ++i) {
+        wait_for_turn(0);
+        turn.store(1, std::memory_order_release);
+        ec.NotifyAll();
+    }
+    wait_for_turn(0);
+    other.join();
+    EXPECT_EQ(turn.load(), 0);
+}
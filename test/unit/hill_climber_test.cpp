@@ -0,0 +1,74 @@
+/*
+HillClimber tests
+*/
+
+#include "thread_pool/hill_climber.hpp"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+using thread_pool::HillClimber;
+
+namespace {
+
+// Drive the climber against a throughput curve for `windows` saturated windows; returns the
+// count it ran most often over the last `tail` windows
+std::size_t Converge(HillClimber& climber, const std::function<double(std::size_t)>& curve,
+                     std::size_t windows, std::size_t tail, bool cpu_bound = false) {
+    std::vector<std::size_t> seen(64, 0);
+    for (std::size_t i = 0; i < windows; ++i) {
+        const auto n = climber.Current();
+        if (i + tail >= windows) {
+            ++seen[n];
+        }
+        climber.Update(curve(n), true, cpu_bound);
+    }
+    return static_cast<std::size_t>(std::max_element(seen.begin(), seen.end()) - seen.begin());
+}
+
+}
+
+TEST(HillClimberTest, ClimbsToThePeak) {
+    // Blocking work: throughput grows with workers until 12, then contention costs
+    HillClimber climber(2, 1, 32);
+    const auto peak = Converge(climber, [](std::size_t n) {
+        return n <= 12 ? 100.0 * n : 1200.0 - 50.0 * (n - 12);
+    }, 120, 40);
+    EXPECT_EQ(peak, 12u);
+}
+
+TEST(HillClimberTest, PrefersFewerWorkersOnAPlateau) {
+    // CPU-bound work on 4 cores: no gain past 4, so it should not sit above that
+    HillClimber climber(16, 1, 32);
+    const auto chosen = Converge(climber, [](std::size_t n) { return 1000.0 * std::min<std::size_t>(n, 4); }, 120, 40);
+    EXPECT_EQ(chosen, 4u);
+}
+
+TEST(HillClimberTest, StaysWithinBounds) {
+    HillClimber climber(50, 2, 8);
+    EXPECT_EQ(climber.Current(), 8u);
+    for (int i = 0; i < 100; ++i) {
+        const auto n = climber.Update(static_cast<double>(climber.Current()), true, false);
+        ASSERT_GE(n, 2u);
+        ASSERT_LE(n, 8u);
+    }
+    // Linear gains all the way: it ends up at the upper bound
+    EXPECT_EQ(Converge(climber, [](std::size_t n) { return 10.0 * n; }, 60, 20), 8u);
+}
+
+TEST(HillClimberTest, IgnoresDemandLimitedWindows) {
+    HillClimber climber(4, 1, 16);
+    for (int i = 0; i < 20; ++i) {
+        EXPECT_EQ(climber.Update(1.0 + i, false, false), 4u);
+    }
+}
+
+TEST(HillClimberTest, DoesNotClimbPastTheCpuQuota) {
+    HillClimber climber(4, 1, 16);
+    for (int i = 0; i < 20; ++i) {
+        ASSERT_LE(climber.Update(100.0 * climber.Current(), true, true), 4u);
+    }
+}
@@ -0,0 +1,88 @@
+/*
+Inline task storage tests (InlineFunction / Task)
+*/
+
+#include "thread_pool/fwd.hpp"
+
+#include <gtest/gtest.h>
+#include <array>
+#include <memory>
+#include <string>
+
+using thread_pool::InlineFunction;
+using thread_pool::SimpleTask;
+using thread_pool::Task;
+
+// Small callables are stored inline, large ones fall back to the heap
+TEST(InlineFunctionTest, InlineAndHeapStorage) {
+    int hits = 0;
+    auto small = [&hits] { ++hits; };
+    std::array<char, 256> big_payload{};
+    big_payload[0] = 3;
+    auto big = [&hits, big_payload] { hits += big_payload[0]; };
+
+    static_assert(InlineFunction<void()>::StoredInline<decltype(small)>());
+    static_assert(!InlineFunction<void()>::StoredInline<decltype(big)>());
+
+    InlineFunction<void()> f1(small);
+    InlineFunction<void()> f2(big);
+    f1();
+    f2();
+    EXPECT_EQ(hits, 4);
+}
+
+// Move-only captures are supported and ownership follows the moves
+TEST(InlineFunctionTest, MoveOnlyCallable) {
+    auto value = std::make_unique<int>(7);
+    InlineFunction<int()> f([v = std::move(value)] { return *v; });
+    ASSERT_TRUE(f);
+
+    InlineFunction<int()> moved(std::move(f));
+    EXPECT_FALSE(f);
+    ASSERT_TRUE(moved);
+    EXPECT_EQ(moved(), 7);
+
+    InlineFunction<int()> assigned;
+    assigned = std::move(moved);
+    EXPECT_EQ(assigned(), 7);
+    assigned = nullptr;
+    EXPECT_FALSE(assigned);
+}
+
+// Captured state is destroyed exactly once, whether inline or on the heap
+TEST(InlineFunctionTest, LifetimeSafety) {
+    auto tracker = std::make_shared<int>(0);
+    {
+        InlineFunction<void(int)> small([t = tracker](int v) { *t += v; });
+        std::array<char, 256> pad{};
+        InlineFunction<void(int)> big([t = tracker, pad](int v) { *t += v + pad[0]; });
+        EXPECT_EQ(tracker.use_count(), 3);
+
+        InlineFunction<void(int)> small_moved(std::move(small));
+        InlineFunction<void(int)> big_moved(std::move(big));
+        small_moved(1);
+        big_moved(2);
+        EXPECT_EQ(*tracker, 3);
+        EXPECT_EQ(tracker.use_count(), 3);
+    }
+    EXPECT_EQ(tracker.use_count(), 1);
+}
+
+// Pool task types live inside the Task handle and survive relocation
+TEST(TaskHandleTest, InlineTaskRelocates) {
+    static_assert(Task::StoredInline<SimpleTask>());
+
+    int hits = 0;
+    Task task = Task::Make<SimpleTask>(SimpleTask::Func([&hits] { ++hits; }));
+    ASSERT_TRUE(task);
+
+    Task moved(std::move(task));
+    EXPECT_FALSE(task);
+    ASSERT_TRUE(moved);
+    moved->Execute();
+    EXPECT_TRUE(moved->Success());
+    EXPECT_EQ(hits, 1);
+
+    moved.reset();
+    EXPECT_FALSE(moved);
+}
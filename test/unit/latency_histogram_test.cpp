@@ -0,0 +1,69 @@
+/*
+LatencyHistogram tests
+*/
+
+#include "thread_pool/latency_histogram.hpp"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdint>
+
+using thread_pool::LatencyHistogram;
+using thread_pool::LatencyRecorder;
+
+// Every value falls into a bucket whose bounds contain it, with at most 1/16 relative width
+TEST(LatencyHistogramTest, BucketBounds) {
+    for (std::uint64_t v : {0ull, 1ull, 15ull, 16ull, 17ull, 31ull, 32ull, 1000ull, 123456789ull,
+                            (1ull << 39) + 12345ull}) {
+        const auto i = LatencyHistogram::BucketIndex(v);
+        ASSERT_LT(i, LatencyHistogram::kBuckets);
+        EXPECT_GE(LatencyHistogram::BucketUpperBound(i), v);
+        const std::uint64_t lower = i == 0 ? 0 : LatencyHistogram::BucketUpperBound(i - 1) + 1;
+        EXPECT_LE(lower, v);
+        EXPECT_LE(LatencyHistogram::BucketUpperBound(i) - lower, v / 16);
+    }
+    // Out-of-range values are clamped into the last bucket
+    EXPECT_EQ(LatencyHistogram::BucketIndex(~0ull), LatencyHistogram::kBuckets - 1);
+    EXPECT_EQ(LatencyHistogram::BucketIndex(1ull << 40), LatencyHistogram::kBuckets - 1);
+}
+
+TEST(LatencyHistogramTest, Percentiles) {
+    LatencyHistogram h;
+    EXPECT_EQ(h.Percentile(0.5).count(), 0);
+    EXPECT_EQ(h.Max().count(), 0);
+
+    // 1..1000 us
+    for (std::uint64_t us = 1; us <= 1000; ++us) {
+        h.Record(us * 1000);
+    }
+    EXPECT_EQ(h.Count(), 1000u);
+    auto near = [](std::chrono::nanoseconds got, double want_ns) {
+        EXPECT_GE(static_cast<double>(got.count()), want_ns);
+        EXPECT_LE(static_cast<double>(got.count()), want_ns * 1.07);
+    };
+    near(h.Percentile(0.5), 500000.0);
+    near(h.Percentile(0.99), 990000.0);
+    near(h.Max(), 1000000.0);
+}
+
+// Recorder snapshots merge across shards, and subtracting a baseline leaves only newer samples
+TEST(LatencyHistogramTest, RecorderMergeAndBaseline) {
+    LatencyRecorder a;
+    LatencyRecorder b;
+    for (int i = 0; i < 10; ++i) {
+        a.Record(100);
+        b.Record(5000);
+    }
+    LatencyHistogram base;
+    a.AddTo(base);
+    b.AddTo(base);
+    EXPECT_EQ(base.Count(), 20u);
+
+    b.Record(5000);
+    LatencyHistogram now;
+    a.AddTo(now);
+    b.AddTo(now);
+    now.Subtract(base);
+    EXPECT_EQ(now.Count(), 1u);
+    EXPECT_EQ(now.BucketCount(LatencyHistogram::BucketIndex(5000)), 1u);
+}
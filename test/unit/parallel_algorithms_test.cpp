@@ -0,0 +1,155 @@
+/*
+ParallelFor / ParallelReduce / ParallelInclusiveScan tests
+*/
+
+#include "thread_pool/parallel.hpp"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+class ParallelAlgorithms : public ::testing::Test {
+protected:
+    void SetUp() override {
+        pool_.Start();
+    }
+    void TearDown() override {
+        pool_.Stop(thread_pool::StopMode::Graceful);
+    }
+    thread_pool::ThreadPool pool_{4, 256};
+};
+
+TEST_F(ParallelAlgorithms, ForVisitsEveryIndexOnce) {
+    for (long long grain : {0LL, 1LL, 7LL, 1000LL, 1000000LL}) {
+        constexpr long long N = 10007;
+        std::vector<std::atomic<int>> hits(N);
+        thread_pool::ParallelFor(pool_, 0LL, N, grain, [&](long long i) {
+            hits[static_cast<std::size_t>(i)].fetch_add(1, std::memory_order_relaxed);
+        });
+        for (long long i = 0; i < N; ++i) {
+            ASSERT_EQ(hits[static_cast<std::size_t>(i)].load(), 1) << "grain=" << grain << " i=" << i;
+        }
+    }
+
+    // Empty and offset ranges
+    int calls = 0;
+    thread_pool::ParallelFor(pool_, 5, 5, [&](int) { ++calls; });
+    thread_pool::ParallelFor(pool_, 9, 3, [&](int) { ++calls; });
+    EXPECT_EQ(calls, 0);
+    std::atomic<long long> sum{0};
+    thread_pool::ParallelFor(pool_, std::size_t{100}, std::size_t{200}, std::size_t{3}, [&](std::size_t i) {
+        sum.fetch_add(static_cast<long long>(i));
+    });
+    EXPECT_EQ(sum.load(), 14950);
+}
+
+TEST_F(ParallelAlgorithms, ForOnStoppedPoolRunsOnCaller) {
+    thread_pool::ThreadPool idle(2, 16);  // never started
+    const auto caller = std::this_thread::get_id();
+    std::atomic<int> elsewhere{0};
+    thread_pool::ParallelFor(idle, 0, 1000, 10, [&](int) {
+        if (std::this_thread::get_id() != caller) {
+            elsewhere.fetch_add(1);
+        }
+    });
+    EXPECT_EQ(elsewhere.load(), 0);
+    EXPECT_EQ(idle.GetStatistics().statistic_total_rejected, 0u);
+}
+
+// Every worker blocks inside an outer ParallelFor that runs an inner one: the callers
+// have to pick up their own halves instead of waiting for a free worker
+TEST_F(ParallelAlgorithms, NestedFromWorkersDoesNotDeadlock) {
+    std::atomic<long long> total{0};
+    thread_pool::ParallelFor(pool_, 0, 16, 1, [&](int) {
+        thread_pool::ParallelFor(pool_, 0, 1000, 10, [&](int j) {
+            total.fetch_add(j, std::memory_order_relaxed);
+        });
+    });
+    EXPECT_EQ(total.load(), 16LL * 499500LL);
+}
+
+TEST_F(ParallelAlgorithms, ExceptionPropagatesToCaller) {
+    std::atomic<int> ran{0};
+    EXPECT_THROW(
+        thread_pool::ParallelFor(pool_, 0, 10000, 10, [&](int i) {
+            ran.fetch_add(1);
+            if (i == 4321) {
+                throw std::runtime_error("boom");
+            }
+        }),
+        std::runtime_error);
+    EXPECT_GT(ran.load(), 0);
+
+    // The pool is still usable afterwards
+    std::atomic<int> after{0};
+    thread_pool::ParallelFor(pool_, 0, 100, [&](int) { after.fetch_add(1); });
+    EXPECT_EQ(after.load(), 100);
+}
+
+TEST_F(ParallelAlgorithms, ReduceMatchesSerial) {
+    constexpr std::int64_t N = 1000003;
+    const auto sum = thread_pool::ParallelReduce(
+        pool_, std::int64_t{0}, N, std::int64_t{0}, std::int64_t{0},
+        [](std::int64_t lo, std::int64_t hi, std::int64_t acc) {
+            for (auto i = lo; i < hi; ++i) {
+                acc += i * i % 7;
+            }
+            return acc;
+        },
+        [](std::int64_t a, std::int64_t b) { return a + b; });
+    std::int64_t want = 0;
+    for (std::int64_t i = 0; i < N; ++i) {
+        want += i * i % 7;
+    }
+    EXPECT_EQ(sum, want);
+
+    // Chunk results are combined in order: a non-commutative fold keeps its order
+    const auto text = thread_pool::ParallelReduce(
+        pool_, 0, 26, 3, std::string{},
+        [](int lo, int hi, std::string acc) {
+            for (int i = lo; i < hi; ++i) {
+                acc.push_back(static_cast<char>('a' + i));
+            }
+            return acc;
+        },
+        [](std::string a, const std::string& b) { return a + b; });
+    EXPECT_EQ(text, "abcdefghijklmnopqrstuvwxyz");
+
+    EXPECT_EQ(thread_pool::ParallelReduce(pool_, 3, 3, 0, 42, [](int, int, int acc) { return acc; },
+                                          [](int a, int b) { return a + b; }),
+              42);
+}
+
+TEST_F(ParallelAlgorithms, InclusiveScanMatchesPartialSum) {
+    for (std::size_t n : {1u, 2u, 17u, 1000u, 100003u}) {
+        std::vector<std::int64_t> in(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            in[i] = static_cast<std::int64_t>(i % 13) - 6;
+        }
+        std::vector<std::int64_t> want(n);
+        std::vector<std::int64_t> got(n);
+        std::partial_sum(in.begin(), in.end(), want.begin());
+        const auto end = thread_pool::ParallelInclusiveScan(pool_, in.begin(), in.end(), got.begin());
+        EXPECT_EQ(end, got.end());
+        EXPECT_EQ(got, want) << "n=" << n;
+    }
+
+    // Non-commutative op with an explicit grain
+    std::vector<std::string> words{"a", "b", "c", "d", "e", "f", "g"};
+    std::vector<std::string> out(words.size());
+    thread_pool::ParallelInclusiveScan(pool_, words.begin(), words.end(), out.begin(),
+                                       [](const std::string& x, const std::string& y) { return x + y; }, 2);
+    EXPECT_EQ(out.back(), "abcdefg");
+    EXPECT_EQ(out[3], "abcd");
+
+    // In place
+    std::vector<int> ones(5000, 1);
+    thread_pool::ParallelInclusiveScan(pool_, ones.begin(), ones.end(), ones.begin());
+    EXPECT_EQ(ones.front(), 1);
+    EXPECT_EQ(ones.back(), 5000);
+}
@@ -0,0 +1,174 @@
+/*
+Segmented (unbounded) queue tests
+*/
+
+#include "mpmc/segmented_queue.hpp"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <iterator>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using Queue = SegmentedQueue<int>;
+
+// FIFO across many segments; never full
+TEST(SegmentedQueueTest, PushPopAcrossSegments) {
+    Queue queue;
+    constexpr int kCount = 1000;  // ~16 segments
+    for (int i = 0; i < kCount; ++i) {
+        ASSERT_TRUE(queue.TryPush(i));
+    }
+    EXPECT_EQ(queue.ApproxSize(), static_cast<std::size_t>(kCount));
+    EXPECT_FALSE(queue.Full());
+    int out = -1;
+    for (int i = 0; i < kCount; ++i) {
+        ASSERT_TRUE(queue.TryPop(out));
+        ASSERT_EQ(out, i);
+    }
+    EXPECT_FALSE(queue.TryPop(out));
+    EXPECT_TRUE(queue.Empty());
+}
+
+// Batch calls claim up to a segment end per CAS and carry on into the next one
+TEST(SegmentedQueueTest, BatchPushPop) {
+    Queue queue;
+    std::vector<int> in(200);
+    for (int i = 0; i < 200; ++i) {
+        in[i] = i;
+    }
+    EXPECT_EQ(queue.TryPushBatch(in.begin(), in.begin() + 50), 50u);
+    EXPECT_EQ(queue.TryPushBatch(in.begin() + 50, in.end()), 150u);
+
+    std::vector<int> out;
+    EXPECT_EQ(queue.TryPopBatch(std::back_inserter(out), 70), 70u);
+    EXPECT_EQ(queue.TryPopBatch(std::back_inserter(out), 1000), 130u);
+    EXPECT_EQ(out, in);
+    EXPECT_EQ(queue.TryPopBatch(std::back_inserter(out), 4), 0u);
+}
+
+// Memory follows the backlog: segments come back once drained
+TEST(SegmentedQueueTest, MemoryFollowsBacklog) {
+    Queue queue;
+    const auto idle = queue.MemoryFootprint();
+    for (int i = 0; i < 10000; ++i) {
+        queue.TryPush(i);
+    }
+    EXPECT_GE(queue.MemoryFootprint(), 10000 / Queue::kSegmentSlots * Queue::SegmentBytes());
+    int out;
+    while (queue.TryPop(out)) {}
+    EXPECT_LE(queue.MemoryFootprint(), idle + (Queue::kSpareSegments + 1) * Queue::SegmentBytes());
+
+    // Steady traffic recycles the spares instead of allocating
+    const auto steady = queue.MemoryFootprint();
+    for (int i = 0; i < 100000; ++i) {
+        queue.TryPush(i);
+        ASSERT_TRUE(queue.TryPop(out));
+    }
+    EXPECT_EQ(queue.MemoryFootprint(), steady);
+}
+
+// A throwing constructor spends its slot; consumers skip it
+TEST(SegmentedQueueTest, ThrowingPushIsSkipped) {
+    Queue queue;
+    queue.TryPush(1);
+    EXPECT_THROW(queue.TryPushWith([](void*) { throw std::runtime_error("ctor"); }), std::runtime_error);
+    queue.TryPush(2);
+    int out = 0;
+    ASSERT_TRUE(queue.TryPop(out));
+    EXPECT_EQ(out, 1);
+    ASSERT_TRUE(queue.TryPop(out));
+    EXPECT_EQ(out, 2);
+    EXPECT_FALSE(queue.TryPop(out));
+}
+
+// Concurrent single and batch producers/consumers deliver every element exactly once
+TEST(SegmentedQueueTest, MultiThreaded) {
+    Queue queue;
+    constexpr int kProducers = 4;
+    constexpr int kPerProducer = 50000;
+    constexpr int kTotal = kProducers * kPerProducer;
+    std::vector<std::atomic<int>> hits(kTotal);
+    std::atomic<int> consumed{0};
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < kProducers; ++p) {
+        threads.emplace_back([&, p] {
+            const int base = p * kPerProducer;
+            if (p % 2 == 0) {
+                for (int i = 0; i < kPerProducer; ++i) {
+                    queue.TryPush(base + i);
+                }
+            } else {
+                std::vector<int> batch;
+                for (int i = 0; i < kPerProducer; i += 37) {
+                    batch.clear();
+                    for (int j = i; j < std::min(i + 37, kPerProducer); ++j) {
+                        batch.push_back(base + j);
+                    }
+                    queue.TryPushBatch(batch.begin(), batch.end());
+                }
+            }
+        });
+    }
+    for (int c = 0; c < 3; ++c) {
+        threads.emplace_back([&, c] {
+            int item;
+            while (consumed.load(std::memory_order_relaxed) < kTotal) {
+                std::size_t got = 0;
+                if (c == 0) {
+                    got = queue.TryConsumeBatch([&](int&& v) {
+                        hits[v].fetch_add(1, std::memory_order_relaxed);
+                    }, 50);
+                } else if (queue.TryPop(item)) {
+                    hits[item].fetch_add(1, std::memory_order_relaxed);
+                    got = 1;
+                }
+                if (got == 0) {
+                    std::this_thread::yield();
+                }
+                consumed.fetch_add(static_cast<int>(got), std::memory_order_relaxed);
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    for (int i = 0; i < kTotal; ++i) {
+        ASSERT_EQ(hits[i].load(), 1) << "element " << i;
+    }
+    EXPECT_TRUE(queue.Empty());
+}
+
+struct Counted {
+    static std::atomic<int> live;
+    int v;
+    explicit Counted(int x = 0) : v(x) {
+        live.fetch_add(1, std::memory_order_relaxed);
+    }
+    Counted(const Counted& o) : v(o.v) {
+        live.fetch_add(1, std::memory_order_relaxed);
+    }
+    Counted& operator=(const Counted&) = default;
+    ~Counted() {
+        live.fetch_sub(1, std::memory_order_relaxed);
+    }
+};
+std::atomic<int> Counted::live{0};
+
+// Elements still queued at destruction are destroyed with the queue
+TEST(SegmentedQueueTest, LifetimeSafety) {
+    {
+        SegmentedQueue<Counted> queue;
+        for (int i = 0; i < 500; ++i) {
+            queue.TryPush(Counted{i});
+        }
+        Counted out;
+        for (int i = 0; i < 200; ++i) {
+            ASSERT_TRUE(queue.TryPop(out));
+            EXPECT_EQ(out.v, i);
+        }
+    }
+    EXPECT_EQ(Counted::live.load(), 0);
+}
@@ -55,6 +55,154 @@ TEST(ConfigLoader, FromJson) {
     EXPECT_EQ(cfg.queue_policy, thread_pool::QueueFullPolicy::Block);
 }
 
+TEST(ConfigLoader, DeprecatedKeysAreIgnored) {
+    auto loadout = thread_pool::ThreadPoolConfigLoader::FromString(R"({"pending_low": 4, "scale_down_threshold": 0.1})");
+    ASSERT_TRUE(loadout.has_value());
+    const auto dumped = loadout->Dump();
+    EXPECT_EQ(dumped.find("pending_low"), std::string::npos);
+    EXPECT_EQ(dumped.find("scale_down_threshold"), std::string::npos);
+}
+
+TEST(ConfigLoader, SchedulingMode) {
+    const std::string str = R"({
+        "core_threads": 2,
+        "scheduling_mode": "WorkStealing",
+        "local_queue_cap": 128
+    })";
+
+    auto loadout = thread_pool::ThreadPoolConfigLoader::FromString(str);
+    ASSERT_TRUE(loadout.has_value());
+    const auto cfg = loadout->GetConfig();
+    EXPECT_EQ(cfg.scheduling, thread_pool::SchedulingMode::WorkStealing);
+    EXPECT_EQ(cfg.local_queue_cap, 128u);
+    EXPECT_NE(loadout->Dump().find("WorkStealing"), std::string::npos);
+
+    // Unknown modes are rejected
+    EXPECT_FALSE(thread_pool::ThreadPoolConfigLoader::FromString(R"({"scheduling_mode": "Random"})").has_value());
+}
+
+TEST(ConfigLoader, IdleStrategy) {
+    const std::string str = R"({
+        "idle_strategy": "SpinThenPark",
+        "idle_spin_max": 1024,
+        "idle_yield_count": 2,
+        "max_spinning_workers": 3
+    })";
+
+    auto loadout = thread_pool::ThreadPoolConfigLoader::FromString(str);
+    ASSERT_TRUE(loadout.has_value());
+    const auto cfg = loadout->GetConfig();
+    EXPECT_EQ(cfg.idle_strategy, thread_pool::IdleStrategy::SpinThenPark);
+    EXPECT_EQ(cfg.idle_spin_max, 1024u);
+    EXPECT_EQ(cfg.idle_yield_count, 2u);
+    EXPECT_EQ(cfg.max_spinning_workers, 3u);
+    EXPECT_NE(loadout->Dump().find("SpinThenPark"), std::string::npos);
+
+    EXPECT_FALSE(thread_pool::ThreadPoolConfigLoader::FromString(R"({"idle_strategy": "Sleep"})").has_value());
+}
+
+TEST(ConfigLoader, PriorityLanes) {
+    auto loadout = thread_pool::ThreadPoolConfigLoader::FromString(R"({
+        "priority_lane_cap": 64,
+        "priority_aging": 0
+    })");
+    ASSERT_TRUE(loadout.has_value());
+    const auto cfg = loadout->GetConfig();
+    EXPECT_EQ(cfg.priority_lane_cap, 64u);
+    EXPECT_EQ(cfg.priority_aging, 0u);
+    EXPECT_NE(loadout->Dump().find("priority_lane_cap"), std::string::npos);
+}
+
+TEST(ConfigLoader, TimerTick) {
+    auto loadout = thread_pool::ThreadPoolConfigLoader::FromString(R"({"timer_tick_us": 250})");
+    ASSERT_TRUE(loadout.has_value());
+    EXPECT_EQ(loadout->GetConfig().timer_tick, std::chrono::microseconds(250));
+    EXPECT_NE(loadout->Dump().find("timer_tick_us"), std::string::npos);
+
+    auto zero = thread_pool::ThreadPoolConfigLoader::FromString(R"({"timer_tick_us": 0})");
+    ASSERT_TRUE(zero.has_value());
+    EXPECT_EQ(zero->GetConfig().timer_tick, std::chrono::microseconds(1));
+}
+
+TEST(ConfigLoader, AutoscaleMode) {
+    auto loadout = thread_pool::ThreadPoolConfigLoader::FromString(R"({
+        "autoscale_mode": "Sojourn",
+        "sojourn_target_us": 500,
+        "sojourn_kp": 0.25,
+        "sojourn_ki": -3.0
+    })");
+    ASSERT_TRUE(loadout.has_value());
+    const auto cfg = loadout->GetConfig();
+    EXPECT_EQ(cfg.autoscale_mode, thread_pool::AutoscaleMode::Sojourn);
+    EXPECT_EQ(cfg.sojourn_target, std::chrono::microseconds(500));
+    EXPECT_DOUBLE_EQ(cfg.sojourn_kp, 0.25);
+    EXPECT_DOUBLE_EQ(cfg.sojourn_ki, 0.0);  // negative gains are clamped
+    EXPECT_NE(loadout->Dump().find("Sojourn"), std::string::npos);
+
+    EXPECT_FALSE(thread_pool::ThreadPoolConfigLoader::FromString(R"({"autoscale_mode": "Magic"})").has_value());
+
+    auto climb = thread_pool::ThreadPoolConfigLoader::FromString(R"({
+        "autoscale_mode": "HillClimb",
+        "load_check_interval_ms": 50,
+        "hill_climb_window_ms": 10
+    })");
+    ASSERT_TRUE(climb.has_value());
+    EXPECT_EQ(climb->GetConfig().autoscale_mode, thread_pool::AutoscaleMode::HillClimb);
+    EXPECT_EQ(climb->GetConfig().hill_climb_window, std::chrono::milliseconds(50));  // at least one tick
+}
+
+TEST(ConfigLoader, MaxBlockingThreads) {
+    auto loadout = thread_pool::ThreadPoolConfigLoader::FromString(R"({"max_blocking_threads": 3})");
+    ASSERT_TRUE(loadout.has_value());
+    EXPECT_EQ(loadout->GetConfig().max_blocking_threads, 3u);
+    EXPECT_NE(loadout->Dump().find("max_blocking_threads"), std::string::npos);
+}
+
+TEST(ConfigLoader, CallerRunsAndBlockForPolicies) {
+    auto caller = thread_pool::ThreadPoolConfigLoader::FromString(R"({"queue_policy": "CallerRuns"})");
+    ASSERT_TRUE(caller.has_value());
+    EXPECT_EQ(caller->GetConfig().queue_policy, thread_pool::QueueFullPolicy::CallerRuns);
+    EXPECT_NE(caller->Dump().find("CallerRuns"), std::string::npos);
+
+    auto bounded = thread_pool::ThreadPoolConfigLoader::FromString(R"({
+        "queue_policy": "BlockFor",
+        "queue_block_timeout_ms": 25
+    })");
+    ASSERT_TRUE(bounded.has_value());
+    EXPECT_EQ(bounded->GetConfig().queue_policy, thread_pool::QueueFullPolicy::BlockFor);
+    EXPECT_EQ(bounded->GetConfig().queue_block_timeout, std::chrono::milliseconds(25));
+    EXPECT_NE(bounded->Dump().find("queue_block_timeout_ms"), std::string::npos);
+}
+
+TEST(ConfigLoader, QueueBackend) {
+    auto loadout = thread_pool::ThreadPoolConfigLoader::FromString(R"({"queue_backend": "Segmented"})");
+    ASSERT_TRUE(loadout.has_value());
+    EXPECT_EQ(loadout->GetConfig().queue_backend, thread_pool::QueueBackend::Segmented);
+    EXPECT_NE(loadout->Dump().find("Segmented"), std::string::npos);
+    EXPECT_FALSE(thread_pool::ThreadPoolConfigLoader::FromString(R"({"queue_backend": "Linked"})").has_value());
+}
+
+TEST(ConfigLoader, SingleSubmitter) {
+    auto loadout = thread_pool::ThreadPoolConfigLoader::FromString(R"({"single_submitter": true})");
+    ASSERT_TRUE(loadout.has_value());
+    EXPECT_TRUE(loadout->GetConfig().single_submitter);
+    EXPECT_NE(loadout->Dump().find("single_submitter"), std::string::npos);
+    EXPECT_FALSE(thread_pool::ThreadPoolConfigLoader::FromString(R"({"single_submitter": "yes"})").has_value());
+}
+
+TEST(ConfigLoader, QueueShards) {
+    auto loadout = thread_pool::ThreadPoolConfigLoader::FromString(R"({"queue_shards": 8, "queue_routing": "TwoChoice"})");
+    ASSERT_TRUE(loadout.has_value());
+    EXPECT_EQ(loadout->GetConfig().queue_shards, 8u);
+    EXPECT_EQ(loadout->GetConfig().queue_routing, thread_pool::QueueRouting::TwoChoice);
+    EXPECT_NE(loadout->Dump().find("TwoChoice"), std::string::npos);
+
+    auto zero = thread_pool::ThreadPoolConfigLoader::FromString(R"({"queue_shards": 0})");
+    ASSERT_TRUE(zero.has_value());
+    EXPECT_EQ(zero->GetConfig().queue_shards, 1u);
+    EXPECT_FALSE(thread_pool::ThreadPoolConfigLoader::FromString(R"({"queue_routing": "Random"})").has_value());
+}
+
 namespace fs = std::filesystem;
 
 TEST(ConfigLoader, FromFile) {
@@ -100,7 +100,7 @@ TEST(ThreadPoolDynamicStress, KeepsWorkers) {
     pool.Start();
 
     std::atomic<bool> release{false};
-    std::vector<std::future<void>> keepers;
+    std::vector<thread_pool::Future<void>> keepers;
     keepers.reserve(cfg.max_threads);
     for (std::size_t i = 0; i < cfg.max_threads; ++i) {
         keepers.push_back(pool.Submit([&] {
@@ -126,7 +126,7 @@ TEST(ThreadPoolDynamicStress, KeepsWorkers) {
 
     release.store(true, std::memory_order_relaxed);
     for (auto& fut : keepers) {
-        fut.get();
+        fut.Get();
     }
 
     EXPECT_TRUE(WaitUntil(
@@ -138,6 +138,136 @@ TEST(ThreadPoolDynamicStress, KeepsWorkers) {
     pool.Stop();
 }
 
+TEST(ThreadPoolDynamicStress, IdleWorkersRetireAfterKeepAlive) {
+    // Grow with manual kicks only; the balancer never samples on its own, so any shrink
+    // comes from the workers themselves
+    thread_pool::ThreadPoolConfig cfg;
+    cfg.queue_cap = 64;
+    cfg.core_threads = 1;
+    cfg.max_threads = 4;
+    cfg.load_check_interval = 10s;
+    cfg.keep_alive = 150ms;
+    cfg.scale_up_threshold = 0.5;
+    cfg.pending_hi = 2;
+    cfg.debounce_hits = 1;
+    cfg.cooldown = 1ms;
+
+    thread_pool::ThreadPool pool(cfg);
+    pool.Start();
+
+    std::atomic<bool> release{false};
+    std::atomic<int> done{0};
+    const int total = static_cast<int>(cfg.max_threads) * 3;
+    for (int i = 0; i < total; ++i) {
+        pool.Post([&] {
+            while (!release.load(std::memory_order_relaxed)) {
+                std::this_thread::sleep_for(50us);
+            }
+            done.fetch_add(1, std::memory_order_relaxed);
+        });
+    }
+    ASSERT_TRUE(WaitUntil(
+        [&] { return pool.CurrentThreads() == cfg.max_threads; },
+        [&] { pool.TriggerLoadCheck(); },
+        1s,
+        1ms));
+
+    release.store(true, std::memory_order_relaxed);
+    ASSERT_TRUE(WaitUntil([&] { return done.load(std::memory_order_acquire) == total; }, [] {}, 1s, 1ms));
+    EXPECT_GT(pool.CurrentThreads(), cfg.core_threads);  // still inside keep_alive
+
+    EXPECT_TRUE(WaitUntil([&] { return pool.CurrentThreads() == cfg.core_threads; }, [] {}, 2s, 2ms));
+    std::this_thread::sleep_for(cfg.keep_alive * 2);
+    EXPECT_EQ(pool.CurrentThreads(), cfg.core_threads);  // never below core
+    EXPECT_EQ(pool.GetStatistics().statistic_total_threads_destroyed, cfg.max_threads - cfg.core_threads);
+
+    // The survivor still runs work
+    EXPECT_EQ(pool.Submit([] { return 7; }).Get(), 7);
+    pool.Stop();
+}
+
+TEST(ThreadPoolDynamicStress, ScaleUpStepSizedFromLoad) {
+    // A 1 s cooldown leaves room for a single scale-up decision in this test: it has to be
+    // big enough on its own
+    thread_pool::ThreadPoolConfig cfg;
+    cfg.queue_cap = 1024;
+    cfg.core_threads = 1;
+    cfg.max_threads = 8;
+    cfg.load_check_interval = 20ms;
+    cfg.keep_alive = 10s;
+    cfg.pending_hi = 16;
+    cfg.debounce_hits = 2;  // the deciding tick has a full window of timed completions
+    cfg.cooldown = 1s;
+
+    thread_pool::ThreadPool pool(cfg);
+    pool.Start();
+
+    // 8 s of backlog: clearing it within one cooldown takes every worker up to max_threads
+    for (int i = 0; i < 400; ++i) {
+        pool.Post([] { std::this_thread::sleep_for(20ms); });
+    }
+    EXPECT_TRUE(WaitUntil([&] { return pool.CurrentThreads() == cfg.max_threads; }, [] {}, 500ms, 1ms));
+    pool.Stop(thread_pool::StopMode::Force);
+}
+
+TEST(ThreadPoolDynamicStress, SojournControllerTracksQueueWait) {
+#if !TP_LATENCY_HISTOGRAMS
+    GTEST_SKIP() << "Sojourn falls back to Thresholds without enqueue stamps";
+#endif
+    // keep_alive is far beyond the test: shrinking has to come from the controller's cap
+    thread_pool::ThreadPoolConfig cfg;
+    cfg.queue_cap = 1024;
+    cfg.core_threads = 1;
+    cfg.max_threads = 6;
+    cfg.load_check_interval = 20ms;
+    cfg.keep_alive = 30s;
+    cfg.autoscale_mode = thread_pool::AutoscaleMode::Sojourn;
+    cfg.sojourn_target = 1000us;
+    cfg.sojourn_kp = 0.5;
+    cfg.sojourn_ki = 4.0;
+
+    thread_pool::ThreadPool pool(cfg);
+    pool.Start();
+
+    for (int i = 0; i < 300; ++i) {
+        pool.Post([] { std::this_thread::sleep_for(5ms); });
+    }
+    EXPECT_TRUE(WaitUntil([&] { return pool.CurrentThreads() == cfg.max_threads; }, [] {}, 2s, 1ms));
+    EXPECT_GT(pool.GetStatistics().statistic_queue_wait_ewma, std::chrono::nanoseconds(cfg.sojourn_target));
+    EXPECT_TRUE(WaitUntil([&] { return pool.GetStatistics().statistic_busy_ratio > 0.0; }, [] {}, 1s, 1ms));
+
+    EXPECT_TRUE(WaitUntil([&] { return pool.Pending() == 0; }, [] {}, 5s, 1ms));
+    EXPECT_TRUE(WaitUntil([&] { return pool.CurrentThreads() == cfg.core_threads; }, [] {}, 3s, 5ms));
+    EXPECT_LT(pool.GetStatistics().statistic_queue_wait_ewma, std::chrono::nanoseconds(cfg.sojourn_target));
+    pool.Stop(thread_pool::StopMode::Graceful);
+}
+
+TEST(ThreadPoolDynamicStress, HillClimbAddsWorkersForBlockingTasks) {
+    // Sleeping tasks: every extra worker adds throughput, even on one core
+    thread_pool::ThreadPoolConfig cfg;
+    cfg.queue_cap = 8192;
+    cfg.core_threads = 2;
+    cfg.max_threads = 16;
+    cfg.load_check_interval = 10ms;
+    cfg.autoscale_mode = thread_pool::AutoscaleMode::HillClimb;
+    cfg.hill_climb_window = 50ms;
+
+    thread_pool::ThreadPool pool(cfg);
+    pool.Start();
+    for (int i = 0; i < 8000; ++i) {
+        pool.Post([] { std::this_thread::sleep_for(2ms); });
+    }
+    EXPECT_TRUE(WaitUntil([&] { return pool.GetStatistics().statistic_tuned_threads >= 8; }, [] {}, 5s, 5ms));
+    const auto stats = pool.GetStatistics();
+    ASSERT_FALSE(stats.statistic_tuner_samples.empty());
+    EXPECT_TRUE(stats.statistic_tuner_samples.back().saturated);
+    EXPECT_GT(stats.statistic_tuner_samples.back().throughput, 0.0);
+    EXPECT_LE(stats.statistic_tuned_threads, cfg.max_threads);
+    EXPECT_GE(pool.CurrentThreads(), 8u);
+    EXPECT_GT(stats.statistic_busy_ratio, 0.0);
+    pool.Stop(thread_pool::StopMode::Force);
+}
+
 TEST(ThreadPoolDynamicStress, HighConcurrency) {
     // Simulate a high-concurrency burst
     thread_pool::ThreadPoolConfig cfg;
@@ -92,13 +92,13 @@ TEST(ThreadPoolLogger, Statistics_Normal) {
     pool.Start();
 
     constexpr int task_nums = 100;
-    std::vector<std::future<void>> futures;
+    std::vector<thread_pool::Future<void>> futures;
     futures.reserve(task_nums);
     for (int i = 0; i < task_nums; ++i) {
         futures.emplace_back(pool.Submit([]{}));
     }
     for (auto& fut : futures) {
-        fut.get();
+        fut.Get();
     }
 
     pool.Stop(thread_pool::StopMode::Graceful);
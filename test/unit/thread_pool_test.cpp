@@ -5,8 +5,13 @@ Basic thread pool tests
 #include "thread_pool/thread_pool.hpp"
 
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <utility>
 #include <thread>
 #include <vector>
 #include <stdexcept>
@@ -35,17 +40,55 @@ TEST(ThreadPoolBasic, ExceptionPropagation) {
     pool.Start();
 
     auto ok = pool.Submit([](int a, int b){ return a + b; }, 7, 5);
-    EXPECT_EQ(ok.get(), 12);
+    EXPECT_EQ(ok.Get(), 12);
 
     auto bad = pool.Submit([]() -> int {
         throw std::runtime_error("error");
     });
-    EXPECT_THROW((void)bad.get(), std::runtime_error);
+    EXPECT_THROW((void)bad.Get(), std::runtime_error);
 
     pool.Stop(thread_pool::StopMode::Graceful);
     EXPECT_EQ(pool.State(), thread_pool::PoolState::STOPPED);
 }
 
+// Future: non-blocking Ready()/TryGet(), timed wait and std::future interop
+TEST(ThreadPoolBasic, FutureReadyTryGetAndConversion) {
+    thread_pool::ThreadPool pool(2, 64);
+    pool.Start();
+
+    std::promise<void> gate;
+    auto gate_fut = gate.get_future().share();
+    auto fut = pool.Submit([gate_fut] { gate_fut.wait(); return 42; });
+
+    int out = 0;
+    EXPECT_TRUE(fut.Valid());
+    EXPECT_FALSE(fut.Ready());
+    EXPECT_FALSE(fut.TryGet(out));
+    EXPECT_FALSE(fut.WaitFor(std::chrono::milliseconds(10)));
+
+    gate.set_value();
+    EXPECT_TRUE(fut.WaitFor(std::chrono::seconds(5)));
+    EXPECT_TRUE(fut.Ready());
+    EXPECT_TRUE(fut.TryGet(out));
+    EXPECT_EQ(out, 42);
+    EXPECT_FALSE(fut.Valid());
+    EXPECT_THROW((void)fut.Get(), std::future_error);
+
+    auto done = pool.Submit([] {});
+    done.Wait();
+    EXPECT_TRUE(done.TryGet());
+
+    // Explicit conversion works before and after completion, including errors
+    auto std_ok = static_cast<std::future<int>>(pool.Submit([] { return 7; }));
+    EXPECT_EQ(std_ok.get(), 7);
+    auto finished = pool.Submit([]() -> int { throw std::runtime_error("late"); });
+    finished.Wait();
+    auto std_bad = static_cast<std::future<int>>(std::move(finished));
+    EXPECT_THROW((void)std_bad.get(), std::runtime_error);
+
+    pool.Stop(thread_pool::StopMode::Graceful);
+}
+
 // Force stop
 TEST(ThreadPoolBasic, ForceStop) {
     thread_pool::ThreadPool pool(4, 256);
@@ -132,10 +175,10 @@ TEST(ThreadPoolBasic, Submit_Return) {
     auto fut1 = pool.Submit([](int a, int b) {
         return a + b;
     }, 10, 20);
-    EXPECT_EQ(fut1.get(), 30);
+    EXPECT_EQ(fut1.Get(), 30);
 
     constexpr int N = 1000;
-    std::vector<std::future<int>> futures;
+    std::vector<thread_pool::Future<int>> futures;
     futures.reserve(N);
     for (int i = 1; i <= N; ++i) {
         futures.push_back(pool.Submit([i]{ return i * i; }));
@@ -143,7 +186,7 @@ TEST(ThreadPoolBasic, Submit_Return) {
 
     long long sum = 0;
     for (auto& f : futures) {
-        sum += f.get();
+        sum += f.Get();
     }
 
     const long long expected = 1LL * N * (N + 1) * (2 * N + 1) / 6;
@@ -152,7 +195,7 @@ TEST(ThreadPoolBasic, Submit_Return) {
     auto fut_err = pool.Submit([]() -> int {
         throw std::runtime_error("Error");
     });
-    EXPECT_THROW(fut_err.get(), std::runtime_error);
+    EXPECT_THROW(fut_err.Get(), std::runtime_error);
 
     pool.Stop(thread_pool::StopMode::Graceful);
     EXPECT_EQ(pool.State(), thread_pool::PoolState::STOPPED);
@@ -197,7 +240,7 @@ TEST(ThreadPoolBasic, Policy_Block) {
 
     // Release the worker
     gate.store(true, std::memory_order_relaxed);
-    hold.get();
+    hold.Get();
 
     EXPECT_EQ(ready.wait_for(500ms), std::future_status::ready);
     t.join();
@@ -231,18 +274,18 @@ TEST(ThreadPoolBasic, Policy_Discard) {
 
     // Submit one more, it should be discarded
     auto f1 = pool.Submit([]{ return 1; });
-    EXPECT_THROW((void)f1.get(), std::runtime_error);
+    EXPECT_THROW((void)f1.Get(), std::runtime_error);
     EXPECT_EQ(pool.DiscardedTasks(), 1u);
 
     // Submit another one, it should be discarded
     auto f2 = pool.Submit([]{ return 2; });
-    EXPECT_THROW((void)f2.get(), std::runtime_error);
+    EXPECT_THROW((void)f2.Get(), std::runtime_error);
     EXPECT_EQ(pool.DiscardedTasks(), 2u);
 
 
     // Release the worker
     gate.store(true, std::memory_order_relaxed);
-    hold.get();
+    hold.Get();
 
     pool.Stop(thread_pool::StopMode::Graceful);
     EXPECT_EQ(pool.State(), thread_pool::PoolState::STOPPED);
@@ -265,14 +308,14 @@ TEST(ThreadPoolBasic, Policy_Overwrite) {
         }
     });
     started.get_future().wait();
-    std::future<int> old_futs[4];
+    thread_pool::Future<int> old_futs[4];
     for (int i = 0; i < 4; ++i) {
         old_futs[i] = pool.Submit([i]{ return 100 + i; });
     }
     EXPECT_EQ(pool.Pending(), 4u);
 
     // Submit 3 new tasks
-    std::future<int> new_futs[3];
+    thread_pool::Future<int> new_futs[3];
     for (int j = 0; j < 3; ++j) {
         new_futs[j] = pool.Submit([j]{ return 200 + j; });
     }
@@ -282,20 +325,20 @@ TEST(ThreadPoolBasic, Policy_Overwrite) {
 
     // Release the worker
     gate.store(true, std::memory_order_relaxed);
-    hold.get();
+    hold.Get();
 
     // Among the old tasks, the 3 overwritten ones should throw
     for (int i = 0; i < 3; ++i) {
-        EXPECT_THROW((void)old_futs[i].get(), std::runtime_error);
+        EXPECT_THROW((void)old_futs[i].Get(), std::runtime_error);
     }
     EXPECT_NO_THROW({
-        int v = old_futs[3].get();
+        int v = old_futs[3].Get();
         EXPECT_EQ(v, 103);
     });
 
     for (int j = 0; j < 3; ++j) {
         EXPECT_NO_THROW({
-            int v = new_futs[j].get();
+            int v = new_futs[j].Get();
             EXPECT_EQ(v, 200 + j);
         });
     }
@@ -304,6 +347,424 @@ TEST(ThreadPoolBasic, Policy_Overwrite) {
     EXPECT_EQ(pool.State(), thread_pool::PoolState::STOPPED);
 }
 
+TEST(ThreadPoolBasic, Policy_CallerRuns) {
+    thread_pool::ThreadPool pool(1, 4);
+    pool.Start();
+    pool.SetQueueFullPolicy(thread_pool::QueueFullPolicy::CallerRuns);
+
+    std::atomic<bool> gate{false};
+    std::promise<void> started;
+
+    // Occupy the worker and fill the queue
+    auto hold = pool.Submit([&]{
+        started.set_value();
+        while (!gate.load(std::memory_order_relaxed)) {
+            std::this_thread::yield();
+        }
+    });
+    started.get_future().wait();
+    for (int i = 0; i < 4; ++i) {
+        pool.Post([]{});
+    }
+    EXPECT_EQ(pool.Pending(), 4u);
+
+    // Overflow runs on this thread before Submit/Post return
+    const auto caller = std::this_thread::get_id();
+    auto f = pool.Submit([]{ return std::this_thread::get_id(); });
+    ASSERT_TRUE(f.Ready());
+    EXPECT_EQ(f.Get(), caller);
+
+    std::thread::id posted_on;
+    pool.Post([&]{ posted_on = std::this_thread::get_id(); });
+    EXPECT_EQ(posted_on, caller);
+
+    std::vector<std::function<void()>> batch(3, [&]{ posted_on = std::thread::id(); });
+    EXPECT_EQ(pool.PostBatch(batch.begin(), batch.end()), 3u);
+    EXPECT_EQ(posted_on, std::thread::id());
+
+    const auto stats = pool.GetStatistics();
+    EXPECT_EQ(stats.statistic_caller_runs, 5u);
+    EXPECT_EQ(stats.statistic_total_rejected, 0u);
+    EXPECT_EQ(pool.DiscardedTasks(), 0u);
+
+    gate.store(true, std::memory_order_relaxed);
+    hold.Get();
+    pool.Stop(thread_pool::StopMode::Graceful);
+}
+
+// Pause() also holds back CallerRuns overflow: a submitter already past Post's state check
+// parks instead of running its task inline once Pause() has returned
+TEST(ThreadPoolBasic, Policy_CallerRunsRespectsPause) {
+    using namespace std::chrono_literals;
+    thread_pool::ThreadPool pool(1, 4);
+    pool.Start();
+    pool.SetQueueFullPolicy(thread_pool::QueueFullPolicy::CallerRuns);
+
+    std::atomic<bool> gate{false};
+    std::promise<void> started;
+    auto hold = pool.Submit([&]{
+        started.set_value();
+        while (!gate.load(std::memory_order_relaxed)) {
+            std::this_thread::yield();
+        }
+    });
+    started.get_future().wait();
+    for (int i = 0; i < 4; ++i) {
+        pool.Post([]{});
+    }
+
+    // Every Post from here on overflows and runs on its submitter
+    std::atomic<bool> stop{false};
+    std::atomic<int> ran{0};
+    std::vector<std::thread> submitters;
+    for (int t = 0; t < 2; ++t) {
+        submitters.emplace_back([&] {
+            while (!stop.load(std::memory_order_relaxed)) {
+                pool.Post([&] { ran.fetch_add(1, std::memory_order_relaxed); });
+            }
+        });
+    }
+    for (int round = 0; round < 5; ++round) {
+        std::this_thread::sleep_for(5ms);
+        pool.Pause();
+        std::this_thread::sleep_for(10ms);  // tasks admitted before Pause() returned may still be entering
+        const int at_pause = ran.load();
+        std::this_thread::sleep_for(30ms);
+        EXPECT_EQ(ran.load(), at_pause) << "round " << round;
+        pool.Resume();
+    }
+    stop.store(true);
+    for (auto& t : submitters) {
+        t.join();
+    }
+    EXPECT_GT(pool.GetStatistics().statistic_caller_runs, 0u);
+    gate.store(true, std::memory_order_relaxed);
+    hold.Get();
+    pool.Stop(thread_pool::StopMode::Graceful);
+}
+
+TEST(ThreadPoolBasic, Policy_BlockFor) {
+    using namespace std::chrono_literals;
+    thread_pool::ThreadPoolConfig cfg;
+    cfg.core_threads = 1;
+    cfg.max_threads = 1;
+    cfg.queue_cap = 4;
+    cfg.queue_policy = thread_pool::QueueFullPolicy::BlockFor;
+    cfg.queue_block_timeout = 200ms;
+    thread_pool::ThreadPool pool(cfg);
+    pool.Start();
+
+    std::atomic<bool> gate{false};
+    std::promise<void> started;
+    auto hold = pool.Submit([&]{
+        started.set_value();
+        while (!gate.load(std::memory_order_relaxed)) {
+            std::this_thread::yield();
+        }
+    });
+    started.get_future().wait();
+    for (int i = 0; i < 4; ++i) {
+        pool.Post([]{});
+    }
+
+    // No space for the whole timeout: the task is dropped, never before the timeout
+    auto start = std::chrono::steady_clock::now();
+    auto late = pool.Submit([]{ return 1; });
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 200ms);
+    EXPECT_THROW((void)late.Get(), std::runtime_error);
+    EXPECT_EQ(pool.DiscardedTasks(), 1u);
+
+    std::vector<std::function<void()>> batch(2, []{});
+    start = std::chrono::steady_clock::now();
+    EXPECT_EQ(pool.PostBatch(batch.begin(), batch.end()), 0u);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 200ms);
+    EXPECT_EQ(pool.DiscardedTasks(), 3u);
+
+    // Space freed within the timeout: the submitter gets in
+    std::thread release([&]{
+        std::this_thread::sleep_for(5ms);
+        gate.store(true, std::memory_order_relaxed);
+    });
+    auto f = pool.Submit([]{ return 2; });
+    release.join();
+    EXPECT_EQ(f.Get(), 2);
+    EXPECT_EQ(pool.DiscardedTasks(), 3u);
+
+    hold.Get();
+    pool.Stop(thread_pool::StopMode::Graceful);
+}
+
+TEST(ThreadPoolBasic, SegmentedBackendAbsorbsBursts) {
+    thread_pool::ThreadPoolConfig cfg;
+    cfg.core_threads = 1;
+    cfg.max_threads = 1;
+    cfg.queue_cap = 4;
+    cfg.queue_policy = thread_pool::QueueFullPolicy::Discard;
+    cfg.queue_backend = thread_pool::QueueBackend::Segmented;
+    thread_pool::ThreadPool pool(cfg);
+    pool.Start();
+
+    std::atomic<bool> gate{false};
+    std::promise<void> started;
+    auto hold = pool.Submit([&]{
+        started.set_value();
+        while (!gate.load(std::memory_order_relaxed)) {
+            std::this_thread::yield();
+        }
+    });
+    started.get_future().wait();
+    const auto idle_bytes = pool.GetStatistics().statistic_queue_bytes;
+
+    // Far past queue_cap: nothing is discarded and the queue grows with the backlog
+    constexpr int kBurst = 2000;
+    std::atomic<int> ran{0};
+    for (int i = 0; i < kBurst; ++i) {
+        pool.Post([&ran]{ ran.fetch_add(1, std::memory_order_relaxed); });
+    }
+    EXPECT_EQ(pool.DiscardedTasks(), 0u);
+    EXPECT_EQ(pool.Pending(), static_cast<std::size_t>(kBurst));
+    const auto burst_bytes = pool.GetStatistics().statistic_queue_bytes;
+    EXPECT_GT(burst_bytes, idle_bytes);
+
+    gate.store(true, std::memory_order_relaxed);
+    hold.Get();
+    while (ran.load(std::memory_order_relaxed) < kBurst) {
+        std::this_thread::yield();
+    }
+    // Drained segments are freed again
+    EXPECT_LT(pool.GetStatistics().statistic_queue_bytes, burst_bytes);
+    pool.Stop(thread_pool::StopMode::Graceful);
+}
+
+TEST(ThreadPoolBasic, SingleSubmitter) {
+    thread_pool::ThreadPoolConfig cfg;
+    cfg.core_threads = 4;
+    cfg.max_threads = 4;
+    cfg.queue_cap = 64;
+    cfg.single_submitter = true;
+    thread_pool::ThreadPool pool(cfg);
+    pool.Start();
+
+    // The submitter feeds its own ring; tasks posting from workers go through the shared one
+    constexpr int kTasks = 5000;
+    std::atomic<int> ran{0};
+    for (int i = 0; i < kTasks; ++i) {
+        pool.Post([&pool, &ran, i] {
+            if (i % 10 == 0) {
+                pool.Post([&ran] { ran.fetch_add(1, std::memory_order_relaxed); });
+            }
+            ran.fetch_add(1, std::memory_order_relaxed);
+        });
+    }
+    std::vector<std::function<void()>> batch(100, [&ran] { ran.fetch_add(1, std::memory_order_relaxed); });
+    std::size_t queued = 0;
+    while (queued < batch.size()) {
+        queued += pool.PostBatch(batch.begin() + static_cast<std::ptrdiff_t>(queued), batch.end());
+    }
+    auto f = pool.Submit([] { return 7; });
+    EXPECT_EQ(f.Get(), 7);
+
+    constexpr int kExpected = kTasks + kTasks / 10 + 100;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (ran.load() < kExpected && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(ran.load(), kExpected);
+    pool.Stop(thread_pool::StopMode::Graceful);
+    EXPECT_EQ(pool.Pending(), 0u);
+}
+
+TEST(ThreadPoolBasic, ShardedQueue) {
+    for (auto routing : {thread_pool::QueueRouting::Home, thread_pool::QueueRouting::TwoChoice}) {
+        thread_pool::ThreadPoolConfig cfg;
+        cfg.core_threads = 4;
+        cfg.max_threads = 4;
+        cfg.queue_cap = 256;
+        cfg.queue_shards = 4;
+        cfg.queue_routing = routing;
+        thread_pool::ThreadPool pool(cfg);
+        pool.Start();
+
+        // Several submitters; Pending() counts tasks in every shard
+        std::atomic<bool> gate{false};
+        std::atomic<int> ran{0};
+        std::vector<std::thread> submitters;
+        for (int s = 0; s < 4; ++s) {
+            submitters.emplace_back([&] {
+                for (int i = 0; i < 2000; ++i) {
+                    pool.Post([&] {
+                        while (!gate.load(std::memory_order_relaxed)) {
+                            std::this_thread::yield();
+                        }
+                        ran.fetch_add(1, std::memory_order_relaxed);
+                    });
+                    if (i == 100) {
+                        gate.store(true, std::memory_order_relaxed);
+                    }
+                }
+            });
+        }
+        for (auto& t : submitters) {
+            t.join();
+        }
+        pool.Stop(thread_pool::StopMode::Graceful);
+        EXPECT_EQ(ran.load(), 8000);
+        EXPECT_EQ(pool.Pending(), 0u);
+    }
+}
+
+TEST(ThreadPoolBasic, SubmitBufferFlushes) {
+    thread_pool::ThreadPool pool(2, 64);
+    pool.Start();
+    std::atomic<int> ran{0};
+    {
+        // Nothing reaches the queue until `capacity` tasks are buffered or Flush() is called
+        thread_pool::ThreadPool::SubmitBuffer buffer(pool, 8, std::chrono::microseconds{0});
+        for (int i = 0; i < 7; ++i) {
+            buffer.Post([&ran] { ran.fetch_add(1, std::memory_order_relaxed); });
+        }
+        EXPECT_EQ(buffer.Size(), 7u);
+        auto stats = pool.GetStatistics();
+        EXPECT_EQ(stats.statistic_buffered_tasks, 7u);
+        EXPECT_EQ(stats.statistic_total_submitted, 0u);
+        EXPECT_EQ(stats.statistic_buffer_flushes, 0u);
+
+        buffer.Post([&ran] { ran.fetch_add(1, std::memory_order_relaxed); });
+        EXPECT_EQ(buffer.Size(), 0u);
+        buffer.Post([&ran] { ran.fetch_add(1, std::memory_order_relaxed); });
+        EXPECT_EQ(buffer.Flush(), 1u);
+        EXPECT_EQ(buffer.Flush(), 0u);
+        stats = pool.GetStatistics();
+        EXPECT_EQ(stats.statistic_buffered_tasks, 0u);
+        EXPECT_EQ(stats.statistic_total_submitted, 9u);
+        EXPECT_EQ(stats.statistic_buffer_flushes, 2u);
+
+        // The rest goes out on destruction
+        buffer.Post([&ran] { ran.fetch_add(1, std::memory_order_relaxed); });
+    }
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (ran.load() < 10 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(ran.load(), 10);
+    pool.Stop(thread_pool::StopMode::Graceful);
+}
+
+TEST(ThreadPoolBasic, SubmitBufferLinger) {
+    thread_pool::ThreadPool pool(2, 64);
+    pool.Start();
+    std::atomic<int> ran{0};
+    thread_pool::ThreadPool::SubmitBuffer buffer(pool, 1024, std::chrono::milliseconds(2));
+    for (int i = 0; i < 3; ++i) {
+        buffer.Post([&ran] { ran.fetch_add(1, std::memory_order_relaxed); });
+    }
+    // No further Post or Flush: the sweep timer hands them over
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (ran.load() < 3 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(ran.load(), 3);
+    EXPECT_EQ(buffer.Size(), 0u);
+    pool.Stop(thread_pool::StopMode::Graceful);
+}
+
+// The linger flush runs on the timer thread and never blocks: with one worker and a lane far
+// smaller than the buffer it queues what fits each sweep instead of parking a worker
+TEST(ThreadPoolBasic, SubmitBufferLingerNeverBlocks) {
+    thread_pool::ThreadPool pool(1, 4);
+    pool.Start();
+    ASSERT_EQ(pool.GetQueueFullPolicy(), thread_pool::QueueFullPolicy::Block);
+    std::atomic<int> ran{0};
+    thread_pool::ThreadPool::SubmitBuffer buffer(pool, 1024, std::chrono::milliseconds(2));
+    for (int i = 0; i < 32; ++i) {
+        buffer.Post([&ran] { ran.fetch_add(1, std::memory_order_relaxed); });
+    }
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (ran.load() < 32 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(ran.load(), 32);
+    const auto stats = pool.GetStatistics();
+    EXPECT_EQ(stats.statistic_total_submitted, 32u);
+    EXPECT_EQ(stats.statistic_pending_timers, 0u);  // the sweep timer is not reported
+    pool.Stop(thread_pool::StopMode::Graceful);
+}
+
+// A lingering buffer used outside RUNNING/PAUSED does not arm the sweep or count rejections
+TEST(ThreadPoolBasic, SubmitBufferBeforeStart) {
+    thread_pool::ThreadPool pool(1, 16);
+    std::atomic<int> ran{0};
+    thread_pool::ThreadPool::SubmitBuffer buffer(pool, 64, std::chrono::milliseconds(1));
+    for (int i = 0; i < 3; ++i) {
+        buffer.Post([&ran] { ran.fetch_add(1, std::memory_order_relaxed); });
+    }
+    EXPECT_EQ(pool.GetStatistics().statistic_total_rejected, 0u);
+    pool.Start();
+    EXPECT_EQ(buffer.Flush(), 3u);
+    pool.Stop(thread_pool::StopMode::Graceful);
+    EXPECT_EQ(ran.load(), 3);
+
+    buffer.Post([] {});
+    EXPECT_EQ(buffer.Flush(), 0u);
+    EXPECT_EQ(pool.GetStatistics().statistic_total_rejected, 1u);  // only the real one
+}
+
+TEST(ThreadPoolBasic, SubmitBufferStop) {
+    // Graceful stop runs what the buffers hold
+    {
+        thread_pool::ThreadPool pool(1, 8);
+        pool.Start();
+        std::atomic<int> ran{0};
+        thread_pool::ThreadPool::SubmitBuffer buffer(pool, 64, std::chrono::microseconds{0});
+        for (int i = 0; i < 20; ++i) {
+            buffer.Post([&ran] { ran.fetch_add(1, std::memory_order_relaxed); });
+        }
+        pool.Stop(thread_pool::StopMode::Graceful);
+        EXPECT_EQ(ran.load(), 20);
+        EXPECT_EQ(buffer.Size(), 0u);
+        EXPECT_EQ(pool.Pending(), 0u);
+    }
+    // Force stop rejects them
+    {
+        thread_pool::ThreadPool pool(1, 8);
+        pool.Start();
+        std::atomic<int> ran{0};
+        thread_pool::ThreadPool::SubmitBuffer buffer(pool, 64, std::chrono::microseconds{0});
+        for (int i = 0; i < 5; ++i) {
+            buffer.Post([&ran] { ran.fetch_add(1, std::memory_order_relaxed); });
+        }
+        pool.Stop(thread_pool::StopMode::Force);
+        EXPECT_EQ(ran.load(), 0);
+        EXPECT_EQ(pool.GetStatistics().statistic_total_rejected, 5u);
+        buffer.Post([] {});
+        EXPECT_EQ(buffer.Flush(), 0u);
+        EXPECT_EQ(pool.GetStatistics().statistic_total_rejected, 6u);
+    }
+}
+
+TEST(ThreadPoolBasic, SubmitBufferManySubmitters) {
+    // A small queue under Block: whatever a batch push cannot place waits like a Post
+    thread_pool::ThreadPool pool(4, 32);
+    pool.Start();
+    std::atomic<int> ran{0};
+    std::vector<std::thread> submitters;
+    for (int s = 0; s < 4; ++s) {
+        submitters.emplace_back([&] {
+            thread_pool::ThreadPool::SubmitBuffer buffer(pool, 24);
+            for (int i = 0; i < 3000; ++i) {
+                buffer.Post([&ran] { ran.fetch_add(1, std::memory_order_relaxed); });
+            }
+        });
+    }
+    for (auto& t : submitters) {
+        t.join();
+    }
+    pool.Stop(thread_pool::StopMode::Graceful);
+    EXPECT_EQ(ran.load(), 12000);
+    EXPECT_EQ(pool.Pending(), 0u);
+    EXPECT_EQ(pool.GetStatistics().statistic_buffered_tasks, 0u);
+}
+
 TEST(ThreadPoolBasic, Pause) {
     using namespace std::chrono_literals;
     thread_pool::ThreadPool pool(1, 4);
@@ -323,7 +784,7 @@ TEST(ThreadPoolBasic, Pause) {
     EXPECT_EQ(submit_future.wait_for(500ms), std::future_status::ready);
     auto fut = submit_future.get();
     EXPECT_NO_THROW({
-        int v = fut.get();
+        int v = fut.Get();
         EXPECT_EQ(v, 555);
     });
 
@@ -350,7 +811,7 @@ TEST(ThreadPoolBasic, Pause_ConsumerDoesNotRun) {
     pool.Resume();
 
     auto f = fut.get();
-    EXPECT_EQ(f.get(), 1);
+    EXPECT_EQ(f.Get(), 1);
     pool.Stop(thread_pool::StopMode::Graceful);
 }
 
@@ -370,7 +831,7 @@ TEST(ThreadPoolBasic, Pause_ThenStop_Graceful) {
 
     pool.Stop(thread_pool::StopMode::Graceful);
     auto f = af.get();
-    EXPECT_EQ(f.get(), 7); // executed successfully
+    EXPECT_EQ(f.Get(), 7); // executed successfully
     EXPECT_EQ(pool.State(), thread_pool::PoolState::STOPPED);
 }
 
@@ -389,10 +850,37 @@ TEST(ThreadPoolBasic, Pause_ThenStop_Force) {
     pool.Stop(thread_pool::StopMode::Force);
 
     auto f = af.get();
-    EXPECT_THROW({ (void)f.get(); }, std::exception); // canceled
+    EXPECT_THROW({ (void)f.Get(); }, std::exception); // canceled
     EXPECT_EQ(pool.State(), thread_pool::PoolState::STOPPED);
 }
 
+// Once Pause() returns no further task may start, even with a backlog already queued
+TEST(ThreadPoolBasic, Pause_NoTaskStartsAfterReturn) {
+    using namespace std::chrono_literals;
+    thread_pool::ThreadPool pool(4, 4096);
+    pool.Start();
+
+    constexpr int N = 4000;
+    std::atomic<int> started{0};
+    for (int i = 0; i < N; ++i) {
+        pool.Post([&started] {
+            started.fetch_add(1, std::memory_order_relaxed);
+            std::this_thread::sleep_for(std::chrono::microseconds(20));
+        });
+    }
+    pool.Pause();
+    // Tasks admitted before Pause() returned may still be entering their body
+    std::this_thread::sleep_for(10ms);
+    const int at_pause = started.load(std::memory_order_acquire);
+    EXPECT_LT(at_pause, N);
+    std::this_thread::sleep_for(100ms);
+    EXPECT_EQ(started.load(std::memory_order_acquire), at_pause);
+
+    pool.Resume();
+    pool.Stop(thread_pool::StopMode::Graceful);
+    EXPECT_EQ(started.load(), N);
+}
+
 TEST(ThreadPoolBasic, PauseResume_Safety) {
     thread_pool::ThreadPool pool(2, 16); 
     pool.Start();
@@ -404,7 +892,7 @@ TEST(ThreadPoolBasic, PauseResume_Safety) {
     EXPECT_FALSE(pool.Paused());
 
     // Repeated submissions
-    std::vector<std::future<int>> futs;
+    std::vector<thread_pool::Future<int>> futs;
     for (int i=0;i<100;i++) {
     futs.push_back(pool.Submit(
         [i]{ 
@@ -413,9 +901,652 @@ TEST(ThreadPoolBasic, PauseResume_Safety) {
     );
     }
     for (int i=0;i<100;i++) {
-    EXPECT_EQ(futs[i].get(), i);
+    EXPECT_EQ(futs[i].Get(), i);
     }
 
     pool.Stop(thread_pool::StopMode::Graceful);
 }
 
+// Sharded counters: totals survive reset, concurrent snapshots and worker exit
+TEST(ThreadPoolBasic, Statistics_ShardedTotals) {
+    thread_pool::ThreadPool pool(4, 1024);
+    pool.Start();
+
+    auto run = [&pool](int n, bool fail) {
+        std::vector<thread_pool::Future<int>> futs;
+        for (int i = 0; i < n; ++i) {
+            futs.push_back(pool.Submit([fail]() -> int {
+                if (fail) {
+                    throw std::runtime_error("boom");
+                }
+                return 1;
+            }));
+        }
+        for (auto& f : futs) {
+            try { (void)f.Get(); } catch (...) {}
+        }
+    };
+
+    run(100, false);
+    pool.ResetStatistics();
+
+    // Snapshots taken while workers update their shards must stay monotonic
+    std::atomic<bool> reading{true};
+    std::thread reader([&] {
+        std::size_t last = 0;
+        while (reading.load(std::memory_order_acquire)) {
+            const auto done = pool.GetStatistics().statistic_total_completed;
+            EXPECT_GE(done, last);
+            last = done;
+        }
+    });
+    run(2000, false);
+    run(50, true);
+    reading.store(false, std::memory_order_release);
+    reader.join();
+
+    // Exited workers fold their counters into the pool totals
+    pool.Stop(thread_pool::StopMode::Graceful);
+    const auto stats = pool.GetStatistics();
+    EXPECT_EQ(stats.statistic_total_completed, 2000u);
+    EXPECT_EQ(stats.statistic_total_failed, 50u);
+}
+
+#if TP_LATENCY_HISTOGRAMS
+// One worker and 2ms tasks: later tasks wait behind earlier ones, and end-to-end covers both
+TEST(ThreadPoolBasic, LatencyHistograms) {
+    using namespace std::chrono_literals;
+    thread_pool::ThreadPool pool(1, 64);
+    pool.Start();
+
+    pool.Submit([] {}).Get();
+    pool.ResetStatistics();
+    EXPECT_EQ(pool.GetLatencyHistograms().end_to_end.Count(), 0u);
+
+    std::vector<thread_pool::Future<void>> futs;
+    for (int i = 0; i < 5; ++i) {
+        futs.push_back(pool.Submit([] { std::this_thread::sleep_for(2ms); }));
+    }
+    pool.Post([] { std::this_thread::sleep_for(2ms); });
+    for (auto& f : futs) {
+        f.Get();
+    }
+    pool.Stop(thread_pool::StopMode::Graceful);
+
+    // Recorded after the future is set, so read once the worker has exited
+    const auto lat = pool.GetLatencyHistograms();
+    EXPECT_EQ(lat.execution.Count(), 6u);
+    EXPECT_EQ(lat.queue_wait.Count(), 6u);
+    EXPECT_EQ(lat.end_to_end.Count(), 6u);
+    EXPECT_GE(lat.execution.Percentile(0.5), 2ms);
+    EXPECT_GE(lat.queue_wait.Max(), 8ms);  // the last task queued behind four others
+    EXPECT_GE(lat.end_to_end.Max(), lat.execution.Max());
+}
+#endif
+
+
+// Work-stealing scheduling
+
+TEST(ThreadPoolWorkStealing, NestedSubmitStaysLocal) {
+    using namespace std::chrono_literals;
+    thread_pool::ThreadPoolConfig cfg;
+    cfg.core_threads = 1;
+    cfg.max_threads = 1;
+    cfg.queue_cap = 64;
+    cfg.scheduling = thread_pool::SchedulingMode::WorkStealing;
+    cfg.local_queue_cap = 16;
+
+    thread_pool::ThreadPool pool(cfg);
+    pool.Start();
+    EXPECT_EQ(pool.Scheduling(), thread_pool::SchedulingMode::WorkStealing);
+
+    constexpr int children = 10;
+    std::atomic<int> ran{0};
+    std::atomic<std::size_t> pending_seen{0};
+    auto root = pool.Submit([&] {
+        for (int i = 0; i < children; ++i) {
+            pool.Post([&ran] { ran.fetch_add(1, std::memory_order_relaxed); });
+        }
+        // Only worker is busy here, so children wait on its deque and are still counted as pending
+        pending_seen.store(pool.Pending(), std::memory_order_relaxed);
+    });
+    root.Get();
+    EXPECT_EQ(pending_seen.load(), static_cast<std::size_t>(children));
+
+    pool.Stop(thread_pool::StopMode::Graceful);
+    EXPECT_EQ(ran.load(), children);
+    EXPECT_EQ(pool.Pending(), 0u);
+}
+
+TEST(ThreadPoolWorkStealing, FanOutCompletes) {
+    using namespace std::chrono_literals;
+    thread_pool::ThreadPoolConfig cfg;
+    cfg.core_threads = 4;
+    cfg.max_threads = 4;
+    cfg.queue_cap = 8192; // Room for every overflowing child: a full queue under Block would stall the posting workers
+    cfg.scheduling = thread_pool::SchedulingMode::WorkStealing;
+    cfg.local_queue_cap = 8; // Small deque so overflow falls back to the shared queue
+
+    thread_pool::ThreadPool pool(cfg);
+    pool.Start();
+
+    constexpr int roots = 200;
+    constexpr int fanout = 20;
+    std::atomic<int> ran{0};
+    std::vector<thread_pool::Future<int>> results;
+    results.reserve(roots);
+    for (int r = 0; r < roots; ++r) {
+        results.push_back(pool.Submit([&pool, &ran, r] {
+            for (int i = 0; i < fanout; ++i) {
+                pool.Post([&ran] { ran.fetch_add(1, std::memory_order_relaxed); });
+            }
+            return r;
+        }));
+    }
+    for (int r = 0; r < roots; ++r) {
+        EXPECT_EQ(results[r].Get(), r);
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (ran.load(std::memory_order_acquire) < roots * fanout
+           && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(1ms);
+    }
+    EXPECT_EQ(ran.load(), roots * fanout);
+
+    pool.Stop(thread_pool::StopMode::Graceful);
+    EXPECT_EQ(pool.Pending(), 0u);
+    EXPECT_EQ(pool.ActiveTasks(), 0u);
+}
+
+// Priority lanes
+
+namespace {
+// One worker held by a gate task while lanes fill up; returns the execution order of the rest
+std::vector<int> RunGated(std::size_t aging, const std::vector<std::pair<thread_pool::TaskPriority, int>>& tasks,
+                          thread_pool::Statistics* while_gated = nullptr) {
+    thread_pool::ThreadPoolConfig cfg;
+    cfg.core_threads = 1;
+    cfg.max_threads = 1;
+    cfg.queue_cap = 256;
+    cfg.priority_lane_cap = 256;
+    cfg.priority_aging = aging;
+    thread_pool::ThreadPool pool(cfg);
+    pool.Start();
+
+    std::promise<void> gate;
+    std::shared_future<void> open = gate.get_future().share();
+    std::atomic<bool> started{false};
+    pool.Post([open, &started] {
+        started.store(true);
+        open.wait();
+    });
+    while (!started.load()) {
+        std::this_thread::yield();
+    }
+
+    std::mutex mu;
+    std::vector<int> order;
+    for (const auto& [priority, id] : tasks) {
+        pool.Post(priority, [&mu, &order, id = id] {
+            std::lock_guard<std::mutex> lk(mu);
+            order.push_back(id);
+        });
+    }
+    if (while_gated) {
+        *while_gated = pool.GetStatistics();
+    }
+    gate.set_value();
+    pool.Stop(thread_pool::StopMode::Graceful);
+    return order;
+}
+}
+
+TEST(ThreadPoolPriority, StrictOrderWithoutAging) {
+    using P = thread_pool::TaskPriority;
+    std::vector<std::pair<P, int>> tasks;
+    for (int i = 0; i < 5; ++i) {
+        tasks.push_back({P::Low, 300 + i});
+        tasks.push_back({P::Normal, 200 + i});
+        tasks.push_back({P::High, 100 + i});
+    }
+    thread_pool::Statistics gated;
+    const auto order = RunGated(0, tasks, &gated);
+    ASSERT_EQ(order.size(), tasks.size());
+    // Lanes drain High, Normal, Low; FIFO within a lane
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        EXPECT_EQ(order[i], static_cast<int>(100 * (i / 5 + 1) + i % 5));
+    }
+    EXPECT_EQ(gated.statistic_pending_high, 5u);
+    EXPECT_EQ(gated.statistic_pending_normal, 5u);
+    EXPECT_EQ(gated.statistic_pending_low, 5u);
+    EXPECT_EQ(gated.statistic_pending_tasks, 15u);
+}
+
+TEST(ThreadPoolPriority, AgingServesLowLane) {
+    using P = thread_pool::TaskPriority;
+    std::vector<std::pair<P, int>> tasks;
+    for (int i = 0; i < 40; ++i) {
+        tasks.push_back({P::High, 100 + i});
+    }
+    for (int i = 0; i < 5; ++i) {
+        tasks.push_back({P::Low, 300 + i});
+    }
+    const auto order = RunGated(4, tasks);
+    ASSERT_EQ(order.size(), tasks.size());
+    // Low gets an aged pick at least once every 2 * aging picks while High is backlogged
+    const auto first_low = std::find_if(order.begin(), order.end(), [](int id) { return id >= 300; });
+    ASSERT_NE(first_low, order.end());
+    EXPECT_LT(std::distance(order.begin(), first_low), 8);
+    EXPECT_EQ(*first_low, 300);
+}
+
+TEST(ThreadPoolPriority, SubmitWithPriority) {
+    thread_pool::ThreadPool pool(2, 64);
+    pool.Start();
+    auto high = pool.Submit(thread_pool::TaskPriority::High, [](int x) { return x * 2; }, 21);
+    auto low = pool.Submit(thread_pool::TaskPriority::Low, [] { return 7; });
+    EXPECT_EQ(high.Get(), 42);
+    EXPECT_EQ(low.Get(), 7);
+    pool.Stop(thread_pool::StopMode::Graceful);
+    EXPECT_EQ(pool.Pending(), 0u);
+}
+
+// Delayed and periodic tasks
+
+TEST(ThreadPoolTimer, ScheduleAfterNeverFiresEarly) {
+    using namespace std::chrono_literals;
+    thread_pool::ThreadPool pool(2, 64);
+    pool.Start();
+
+    constexpr int N = 20;
+    std::mutex mu;
+    std::vector<std::chrono::steady_clock::duration> early;
+    std::atomic<int> ran{0};
+    for (int i = 0; i < N; ++i) {
+        const auto delay = std::chrono::milliseconds(1 + i * 2);
+        const auto due = std::chrono::steady_clock::now() + delay;
+        const auto id = pool.ScheduleAfter(delay, [&, due] {
+            const auto now = std::chrono::steady_clock::now();
+            if (now < due) {
+                std::lock_guard<std::mutex> lk(mu);
+                early.push_back(due - now);
+            }
+            ran.fetch_add(1);
+        }, i % 2 ? thread_pool::TaskPriority::High : thread_pool::TaskPriority::Normal);
+        EXPECT_NE(id, 0u);
+    }
+    const auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (ran.load() < N && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(1ms);
+    }
+    EXPECT_EQ(ran.load(), N);
+    EXPECT_TRUE(early.empty());
+    EXPECT_EQ(pool.PendingTimers(), 0u);
+    EXPECT_EQ(pool.GetStatistics().statistic_timers_fired, static_cast<std::size_t>(N));
+    pool.Stop(thread_pool::StopMode::Graceful);
+}
+
+TEST(ThreadPoolTimer, CancelAndStopDropPendingTimers) {
+    using namespace std::chrono_literals;
+    thread_pool::ThreadPool pool(2, 64);
+    pool.Start();
+
+    std::atomic<int> ran{0};
+    const auto cancelled = pool.ScheduleAfter(20ms, [&ran] { ran.fetch_add(100); });
+    pool.ScheduleAt(std::chrono::steady_clock::now() + 1h, [&ran] { ran.fetch_add(1000); });
+    pool.ScheduleAfter(1ms, [&ran] { ran.fetch_add(1); });
+    EXPECT_EQ(pool.PendingTimers(), 3u);
+    EXPECT_TRUE(pool.CancelTimer(cancelled));
+    EXPECT_FALSE(pool.CancelTimer(cancelled));
+    EXPECT_EQ(pool.GetStatistics().statistic_pending_timers, 2u);
+
+    std::this_thread::sleep_for(60ms);
+    EXPECT_EQ(ran.load(), 1);
+    pool.Stop(thread_pool::StopMode::Graceful);
+    EXPECT_EQ(pool.PendingTimers(), 0u);
+    EXPECT_EQ(ran.load(), 1);
+
+    // Rejected once the pool is stopped
+    EXPECT_EQ(pool.ScheduleAfter(1ms, [] {}), 0u);
+}
+
+// A full lane never stalls the timer thread: under Block it does not wait for space and under
+// CallerRuns it does not run the task itself; the firing is retried once the lane drains
+TEST(ThreadPoolTimer, FullLaneNeverStallsTimerThread) {
+    using namespace std::chrono_literals;
+    for (auto policy : {thread_pool::QueueFullPolicy::Block, thread_pool::QueueFullPolicy::CallerRuns}) {
+        thread_pool::ThreadPoolConfig cfg;
+        cfg.core_threads = 1;
+        cfg.max_threads = 1;
+        cfg.queue_cap = 4;
+        cfg.queue_policy = policy;
+        thread_pool::ThreadPool pool(cfg);
+        pool.Start();
+
+        std::atomic<bool> gate{false};
+        std::atomic<bool> started{false};
+        pool.Post([&] {
+            started.store(true);
+            while (!gate.load()) {
+                std::this_thread::sleep_for(1ms);
+            }
+        });
+        while (!started.load()) {
+            std::this_thread::yield();
+        }
+        while (pool.TryPost([] {})) {
+        }
+
+        std::atomic<int> normal_ran{0};
+        std::atomic<int> high_ran{0};
+        ASSERT_NE(pool.ScheduleAfter(1ms, [&] { normal_ran.fetch_add(1); }), 0u);
+        ASSERT_NE(pool.ScheduleAfter(3ms, [&] { high_ran.fetch_add(1); }, thread_pool::TaskPriority::High), 0u);
+
+        // The High firing reaches its lane although the Normal one is stuck behind a full lane
+        const auto deadline = std::chrono::steady_clock::now() + 5s;
+        while (pool.Pending(thread_pool::TaskPriority::High) == 0 && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(1ms);
+        }
+        EXPECT_EQ(pool.Pending(thread_pool::TaskPriority::High), 1u);
+        std::this_thread::sleep_for(10ms);
+        EXPECT_EQ(normal_ran.load(), 0);  // neither run inline nor dropped
+        EXPECT_EQ(pool.GetStatistics().statistic_caller_runs, 0u);
+
+        gate.store(true);
+        while ((normal_ran.load() == 0 || high_ran.load() == 0) && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(1ms);
+        }
+        EXPECT_EQ(normal_ran.load(), 1);
+        EXPECT_EQ(high_ran.load(), 1);
+        EXPECT_EQ(pool.GetStatistics().statistic_timers_fired, 2u);
+        pool.Stop(thread_pool::StopMode::Graceful);
+    }
+}
+
+// A firing still waiting for a full lane when the pool stops is counted, not silently lost
+TEST(ThreadPoolTimer, StopCountsFiringsHeldForFullLane) {
+    using namespace std::chrono_literals;
+    thread_pool::ThreadPoolConfig cfg;
+    cfg.core_threads = 1;
+    cfg.max_threads = 1;
+    cfg.queue_cap = 4;
+    cfg.queue_policy = thread_pool::QueueFullPolicy::Block;
+    thread_pool::ThreadPool pool(cfg);
+    pool.Start();
+
+    std::atomic<bool> gate{false};
+    std::atomic<bool> started{false};
+    pool.Post([&] {
+        started.store(true);
+        while (!gate.load()) {
+            std::this_thread::sleep_for(1ms);
+        }
+    });
+    while (!started.load()) {
+        std::this_thread::yield();
+    }
+    while (pool.TryPost([] {})) {
+    }
+    std::atomic<int> ran{0};
+    ASSERT_NE(pool.ScheduleAfter(1ms, [&ran] { ran.fetch_add(1); }), 0u);
+    std::this_thread::sleep_for(10ms);
+    EXPECT_EQ(pool.PendingTimers(), 0u);  // due: held by the timer thread, not in the wheel
+
+    std::thread release([&] {
+        std::this_thread::sleep_for(20ms);
+        gate.store(true);
+    });
+    pool.Stop(thread_pool::StopMode::Force);
+    release.join();
+    EXPECT_EQ(ran.load(), 0);
+    EXPECT_EQ(pool.GetStatistics().statistic_total_rejected, 1u);
+}
+
+TEST(ThreadPoolTimer, FixedRateRepeatsUntilCancelled) {
+    using namespace std::chrono_literals;
+    thread_pool::ThreadPoolConfig cfg;
+    cfg.core_threads = 2;
+    cfg.max_threads = 2;
+    cfg.timer_tick = std::chrono::microseconds(500);
+    thread_pool::ThreadPool pool(cfg);
+    pool.Start();
+
+    std::atomic<int> ran{0};
+    std::atomic<int> overlap{0};
+    std::atomic<bool> inside{false};
+    const auto id = pool.ScheduleAtFixedRate(2ms, [&] {
+        if (inside.exchange(true)) {
+            overlap.fetch_add(1);
+        }
+        ran.fetch_add(1);
+        inside.store(false);
+    });
+    ASSERT_NE(id, 0u);
+    const auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (ran.load() < 5 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(1ms);
+    }
+    EXPECT_GE(ran.load(), 5);
+    EXPECT_EQ(pool.PendingTimers(), 1u);  // still armed
+
+    EXPECT_TRUE(pool.CancelTimer(id));
+    std::this_thread::sleep_for(10ms);  // a firing already queued may still run
+    const int after_cancel = ran.load();
+    std::this_thread::sleep_for(20ms);
+    EXPECT_EQ(ran.load(), after_cancel);
+    EXPECT_EQ(overlap.load(), 0);
+    pool.Stop(thread_pool::StopMode::Graceful);
+}
+
+TEST(ThreadPoolTimer, FixedRateSlowerThanPeriodNeverQueuesUp) {
+    using namespace std::chrono_literals;
+    thread_pool::ThreadPoolConfig cfg;
+    cfg.core_threads = 1;
+    cfg.max_threads = 1;
+    cfg.timer_tick = std::chrono::microseconds(500);
+    thread_pool::ThreadPool pool(cfg);
+    pool.Start();
+
+    std::atomic<int> ran{0};
+    std::atomic<std::size_t> max_queued{0};
+    const auto id = pool.ScheduleAtFixedRate(1ms, [&] {
+        // While a firing runs no other one may exist, in a lane or on the timer thread
+        const auto queued = pool.Pending();
+        if (queued > max_queued.load()) {
+            max_queued.store(queued);
+        }
+        ran.fetch_add(1);
+        std::this_thread::sleep_for(5ms);
+    });
+    ASSERT_NE(id, 0u);
+    const auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (ran.load() < 5 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(1ms);
+    }
+    EXPECT_GE(ran.load(), 5);
+    EXPECT_TRUE(pool.CancelTimer(id));
+    const int at_cancel = ran.load();
+    std::this_thread::sleep_for(30ms);
+    EXPECT_LE(ran.load(), at_cancel + 1);  // no catch-up once cancelled
+    EXPECT_EQ(max_queued.load(), 0u);
+    pool.Stop(thread_pool::StopMode::Graceful);
+}
+
+TEST(ThreadPoolTimer, FixedRateBehindFullLaneKeepsOneFiring) {
+    using namespace std::chrono_literals;
+    thread_pool::ThreadPoolConfig cfg;
+    cfg.core_threads = 1;
+    cfg.max_threads = 1;
+    cfg.queue_cap = 4;
+    cfg.queue_policy = thread_pool::QueueFullPolicy::Block;
+    cfg.timer_tick = std::chrono::microseconds(500);
+    thread_pool::ThreadPool pool(cfg);
+    pool.Start();
+
+    std::atomic<bool> gate{false};
+    std::atomic<bool> started{false};
+    pool.Post([&] {
+        started.store(true);
+        while (!gate.load()) {
+            std::this_thread::sleep_for(1ms);
+        }
+    });
+    while (!started.load()) {
+        std::this_thread::yield();
+    }
+    while (pool.TryPost([] {})) {
+    }
+
+    // The first run cancels the timer: any further firing built up behind the lane would still run
+    std::atomic<int> ran{0};
+    std::atomic<thread_pool::ThreadPool::TimerId> id{0};
+    id.store(pool.ScheduleAtFixedRate(1ms, [&] {
+        ran.fetch_add(1);
+        pool.CancelTimer(id.load());
+    }));
+    ASSERT_NE(id.load(), 0u);
+    std::this_thread::sleep_for(30ms);  // ~30 periods come due against the full lane
+    EXPECT_EQ(ran.load(), 0);
+
+    gate.store(true);
+    const auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (ran.load() == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(1ms);
+    }
+    std::this_thread::sleep_for(20ms);
+    EXPECT_EQ(ran.load(), 1);
+    EXPECT_EQ(pool.GetStatistics().statistic_timers_fired, 1u);
+    EXPECT_EQ(pool.PendingTimers(), 0u);
+    pool.Stop(thread_pool::StopMode::Graceful);
+}
+
+// Idle strategy
+
+TEST(ThreadPoolIdle, SpinThenParkCompletesBursts) {
+    using namespace std::chrono_literals;
+    thread_pool::ThreadPoolConfig cfg;
+    cfg.core_threads = 4;
+    cfg.max_threads = 4;
+    cfg.queue_cap = 1024;
+    cfg.idle_strategy = thread_pool::IdleStrategy::SpinThenPark;
+    cfg.idle_spin_max = 1 << 14;
+    cfg.max_spinning_workers = 2;
+
+    thread_pool::ThreadPool pool(cfg);
+    pool.Start();
+
+    constexpr int bursts = 50;
+    constexpr int burst_size = 100;
+    std::atomic<int> ran{0};
+    for (int b = 0; b < bursts; ++b) {
+        for (int i = 0; i < burst_size; ++i) {
+            pool.Post([&ran] { ran.fetch_add(1, std::memory_order_relaxed); });
+        }
+        std::this_thread::sleep_for(1ms); // Gap between bursts lets workers go idle
+    }
+
+    pool.Stop(thread_pool::StopMode::Graceful);
+    EXPECT_EQ(ran.load(), bursts * burst_size);
+
+    const auto stats = pool.GetStatistics();
+    EXPECT_GT(stats.statistic_spin_hits + stats.statistic_park_cnt, 0u);
+}
+
+TEST(ThreadPoolIdle, ParkStrategyNeverSpins) {
+    thread_pool::ThreadPool pool(2, 64);
+    pool.Start();
+    for (int i = 0; i < 100; ++i) {
+        pool.Post([] {});
+    }
+    pool.Stop(thread_pool::StopMode::Graceful);
+
+    const auto stats = pool.GetStatistics();
+    EXPECT_EQ(stats.statistic_spin_hits, 0u);
+    EXPECT_GT(stats.statistic_park_cnt, 0u);
+}
+
+TEST(ThreadPoolBlocking, RegionStartsCompensatingWorker) {
+    using namespace std::chrono_literals;
+    // Fixed at two workers: only BlockingRegion can add threads
+    thread_pool::ThreadPoolConfig cfg;
+    cfg.core_threads = 2;
+    cfg.max_threads = 2;
+    cfg.queue_cap = 64;
+    thread_pool::ThreadPool pool(cfg);
+    pool.Start();
+
+    std::atomic<bool> release{false};
+    std::atomic<int> blocked{0};
+    std::vector<thread_pool::Future<int>> blockers;
+    for (int i = 0; i < 2; ++i) {
+        blockers.push_back(pool.Submit([&] {
+            return pool.RunBlocking([&] {
+                blocked.fetch_add(1);
+                while (!release.load()) {
+                    std::this_thread::sleep_for(100us);
+                }
+                return 1;
+            });
+        }));
+    }
+    // Both workers are stuck, yet queued work still runs
+    EXPECT_EQ(pool.Submit([] { return 7; }).Get(), 7);
+    EXPECT_EQ(blocked.load(), 2);
+    auto stats = pool.GetStatistics();
+    EXPECT_EQ(stats.statistic_blocked_workers, 2u);
+    EXPECT_GE(stats.statistic_blocking_compensations, 1u);
+    EXPECT_GT(pool.CurrentThreads(), cfg.max_threads);
+
+    release.store(true);
+    for (auto& f : blockers) {
+        EXPECT_EQ(f.Get(), 1);
+    }
+    // The extra workers are given back once the regions end
+    const auto deadline = std::chrono::steady_clock::now() + 2s;
+    while (pool.CurrentThreads() > cfg.max_threads && std::chrono::steady_clock::now() < deadline) {
+        pool.Post([] {});
+        std::this_thread::sleep_for(1ms);
+    }
+    EXPECT_EQ(pool.CurrentThreads(), cfg.max_threads);
+    EXPECT_EQ(pool.GetStatistics().statistic_blocked_workers, 0u);
+    pool.Stop(thread_pool::StopMode::Graceful);
+}
+
+TEST(ThreadPoolBlocking, CapAndOffPoolCalls) {
+    using namespace std::chrono_literals;
+    thread_pool::ThreadPoolConfig cfg;
+    cfg.core_threads = 1;
+    cfg.max_threads = 1;
+    cfg.queue_cap = 64;
+    cfg.max_blocking_threads = 1;
+    thread_pool::ThreadPool pool(cfg);
+    pool.Start();
+
+    // Not on a worker: runs inline, no bookkeeping
+    EXPECT_EQ(pool.RunBlocking([] { return 3; }), 3);
+    EXPECT_EQ(pool.GetStatistics().statistic_blocking_compensations, 0u);
+
+    std::atomic<bool> release{false};
+    auto block = [&] {
+        pool.RunBlocking([&] {
+            while (!release.load()) {
+                std::this_thread::sleep_for(100us);
+            }
+        });
+    };
+    auto first = pool.Submit(block);
+    auto second = pool.Submit(block);  // runs on the compensating worker, which may not add another
+    const auto deadline = std::chrono::steady_clock::now() + 2s;
+    while (pool.GetStatistics().statistic_blocked_workers < 2 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(1ms);
+    }
+    EXPECT_EQ(pool.GetStatistics().statistic_blocked_workers, 2u);
+    EXPECT_EQ(pool.GetStatistics().statistic_blocking_compensations, 1u);
+    EXPECT_EQ(pool.CurrentThreads(), 2u);
+
+    release.store(true);
+    first.Get();
+    second.Get();
+    pool.Stop(thread_pool::StopMode::Graceful);
+}
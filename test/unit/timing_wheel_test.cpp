@@ -0,0 +1,141 @@
+/*
+TimingWheel tests
+*/
+
+#include "thread_pool/timing_wheel.hpp"
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+using Wheel = thread_pool::TimingWheel<int>;
+
+namespace {
+
+// Advance to `to`, collecting (payload, tick fired) pairs for one-shot timers
+std::vector<std::pair<int, std::uint64_t>> AdvanceCollect(Wheel& wheel, std::uint64_t to) {
+    std::vector<std::pair<int, std::uint64_t>> fired;
+    wheel.Advance(to, [&](Wheel::TimerId, int& v, std::uint64_t) {
+        fired.emplace_back(v, wheel.Now());
+        return Wheel::kNever;
+    });
+    return fired;
+}
+
+}
+
+TEST(TimingWheelTest, FiresExactlyAtDeadline) {
+    Wheel wheel;
+    // Deadlines on every level: level 0, 1 (>= 256), 2 (>= 65536) and a cascade boundary
+    const std::vector<std::uint64_t> deadlines{1, 5, 255, 256, 257, 1000, 65535, 65536, 70000, 300000};
+    for (std::size_t i = 0; i < deadlines.size(); ++i) {
+        wheel.Add(deadlines[i], static_cast<int>(i));
+    }
+    EXPECT_EQ(wheel.Size(), deadlines.size());
+
+    const auto fired = AdvanceCollect(wheel, 400000);
+    ASSERT_EQ(fired.size(), deadlines.size());
+    for (std::size_t i = 0; i < fired.size(); ++i) {
+        EXPECT_EQ(fired[i].first, static_cast<int>(i));
+        EXPECT_EQ(fired[i].second, deadlines[i]);
+    }
+    EXPECT_EQ(wheel.Size(), 0u);
+}
+
+TEST(TimingWheelTest, StepwiseAdvanceAndPastDeadlines) {
+    Wheel wheel(1000);
+    wheel.Add(10, 1);    // already past: fires on the next tick
+    wheel.Add(1300, 2);
+    EXPECT_EQ(wheel.NextTick(), 1001u);
+
+    auto fired = AdvanceCollect(wheel, 1001);
+    ASSERT_EQ(fired.size(), 1u);
+    EXPECT_EQ(fired[0].first, 1);
+
+    // Tick-by-tick advance must give the same answer as one big jump
+    std::uint64_t at = 0;
+    for (std::uint64_t t = 1002; t <= 1400 && at == 0; ++t) {
+        fired = AdvanceCollect(wheel, t);
+        if (!fired.empty()) {
+            at = fired[0].second;
+        }
+    }
+    EXPECT_EQ(at, 1300u);
+    EXPECT_EQ(wheel.NextTick(), Wheel::kNever);
+}
+
+TEST(TimingWheelTest, FarDeadlineBeyondHorizon) {
+    Wheel wheel;
+    const std::uint64_t far = (std::uint64_t{1} << 32) + 12345;
+    wheel.Add(far, 7);
+    std::uint64_t at = 0;
+    wheel.Advance(far + 10, [&](Wheel::TimerId, int&, std::uint64_t deadline) {
+        EXPECT_EQ(deadline, far);
+        at = wheel.Now();
+        return Wheel::kNever;
+    });
+    EXPECT_EQ(at, far);
+}
+
+TEST(TimingWheelTest, CancelIsExactAndIdsAreNotReused) {
+    Wheel wheel;
+    const auto a = wheel.Add(50, 1);
+    const auto b = wheel.Add(50, 2);
+    const auto c = wheel.Add(70000, 3);
+    EXPECT_NE(a, Wheel::kInvalidTimer);
+    EXPECT_TRUE(wheel.Cancel(b));
+    EXPECT_FALSE(wheel.Cancel(b));
+    EXPECT_TRUE(wheel.Cancel(c));
+    EXPECT_FALSE(wheel.Cancel(Wheel::kInvalidTimer));
+    EXPECT_EQ(wheel.Size(), 1u);
+
+    // The freed node is recycled under a new generation: the stale id stays dead
+    const auto d = wheel.Add(60, 4);
+    EXPECT_NE(d, b);
+    EXPECT_FALSE(wheel.Cancel(b));
+
+    const auto fired = AdvanceCollect(wheel, 100);
+    ASSERT_EQ(fired.size(), 2u);
+    EXPECT_EQ(fired[0].first, 1);
+    EXPECT_EQ(fired[1].first, 4);
+    EXPECT_FALSE(wheel.Cancel(a));  // already fired
+}
+
+TEST(TimingWheelTest, RearmKeepsId) {
+    Wheel wheel;
+    const auto id = wheel.Add(100, 0);
+    std::vector<std::uint64_t> ticks;
+    wheel.Advance(1000, [&](Wheel::TimerId fired, int&, std::uint64_t deadline) {
+        EXPECT_EQ(fired, id);
+        ticks.push_back(wheel.Now());
+        return ticks.size() < 4 ? deadline + 250 : Wheel::kNever;
+    });
+    EXPECT_EQ(ticks, (std::vector<std::uint64_t>{100, 350, 600, 850}));
+    EXPECT_EQ(wheel.Size(), 0u);
+}
+
+TEST(TimingWheelTest, ManyTimersAndClear) {
+    Wheel wheel;
+    constexpr int N = 100000;
+    for (int i = 0; i < N; ++i) {
+        wheel.Add(static_cast<std::uint64_t>(i % 5000) + 1, i);
+    }
+    EXPECT_EQ(wheel.Size(), static_cast<std::size_t>(N));
+    EXPECT_GT(wheel.MemoryFootprint(), N * sizeof(int));
+
+    std::size_t fired = 0;
+    std::uint64_t last = 0;
+    wheel.Advance(2500, [&](Wheel::TimerId, int&, std::uint64_t deadline) {
+        EXPECT_GE(deadline, last);
+        last = deadline;
+        ++fired;
+        return Wheel::kNever;
+    });
+    EXPECT_EQ(fired, static_cast<std::size_t>(N) / 2);
+
+    wheel.Clear();
+    EXPECT_EQ(wheel.Size(), 0u);
+    EXPECT_EQ(wheel.NextTick(), Wheel::kNever);
+    EXPECT_EQ(AdvanceCollect(wheel, 10000).size(), 0u);
+}
@@ -0,0 +1,127 @@
+/*
+Work-stealing deque tests
+*/
+
+#include "mpmc/work_stealing_deque.hpp"
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <memory>
+
+// Owner side is LIFO, thief side is FIFO
+TEST(WorkStealingDequeTest, OwnerLifoThiefFifo) {
+    WorkStealingDeque<int> deque(8);
+    EXPECT_EQ(deque.Capacity(), 8u);
+    int item = -1;
+
+    EXPECT_FALSE(deque.TryPop(item));
+    EXPECT_FALSE(deque.TrySteal(item));
+
+    for (int i = 1; i <= 4; ++i) {
+        EXPECT_TRUE(deque.TryPush(int{i}));
+    }
+    EXPECT_EQ(deque.ApproxSize(), 4u);
+
+    EXPECT_TRUE(deque.TryPop(item));
+    EXPECT_EQ(item, 4);
+    EXPECT_TRUE(deque.TrySteal(item));
+    EXPECT_EQ(item, 1);
+    EXPECT_TRUE(deque.TryPop(item));
+    EXPECT_EQ(item, 3);
+    EXPECT_TRUE(deque.TrySteal(item));
+    EXPECT_EQ(item, 2);
+
+    EXPECT_TRUE(deque.Empty());
+    EXPECT_FALSE(deque.TryPop(item));
+}
+
+// Push fails when full and leaves the item untouched
+TEST(WorkStealingDequeTest, FullKeepsItem) {
+    WorkStealingDeque<std::unique_ptr<int>> deque(2);
+    EXPECT_TRUE(deque.TryPush(std::make_unique<int>(1)));
+    EXPECT_TRUE(deque.TryPush(std::make_unique<int>(2)));
+
+    auto extra = std::make_unique<int>(3);
+    EXPECT_FALSE(deque.TryPush(std::move(extra)));
+    ASSERT_TRUE(extra);
+    EXPECT_EQ(*extra, 3);
+
+    std::unique_ptr<int> out;
+    EXPECT_TRUE(deque.TrySteal(out));
+    EXPECT_EQ(*out, 1);
+    EXPECT_TRUE(deque.TryPush(std::move(extra)));
+}
+
+// Remaining elements are destroyed with the deque
+TEST(WorkStealingDequeTest, LifetimeSafety) {
+    auto tracker = std::make_shared<int>(0);
+    {
+        WorkStealingDeque<std::shared_ptr<int>> deque(16);
+        for (int i = 0; i < 10; ++i) {
+            EXPECT_TRUE(deque.TryPush(std::shared_ptr<int>(tracker)));
+        }
+        std::shared_ptr<int> out;
+        EXPECT_TRUE(deque.TryPop(out));
+        EXPECT_TRUE(deque.TrySteal(out));
+        out.reset();
+        EXPECT_EQ(tracker.use_count(), 9);
+    }
+    EXPECT_EQ(tracker.use_count(), 1);
+}
+
+// One owner pushing/popping while thieves steal: every element is taken exactly once
+TEST(WorkStealingDequeTest, ConcurrentSteal) {
+    constexpr int N = 100000;
+    constexpr int Thieves = 3;
+    WorkStealingDeque<int> deque(256);
+    std::vector<std::atomic<int>> seen(N);
+    std::atomic<int> taken{0};
+    std::atomic<bool> done{false};
+
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < Thieves; ++t) {
+        thieves.emplace_back([&] {
+            int item;
+            while (!done.load(std::memory_order_acquire)) {
+                if (deque.TrySteal(item)) {
+                    seen[item].fetch_add(1, std::memory_order_relaxed);
+                    taken.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    int item;
+    for (int i = 0; i < N; ++i) {
+        while (!deque.TryPush(int{i})) {
+            if (deque.TryPop(item)) {
+                seen[item].fetch_add(1, std::memory_order_relaxed);
+                taken.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        if (i % 3 == 0 && deque.TryPop(item)) {
+            seen[item].fetch_add(1, std::memory_order_relaxed);
+            taken.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    while (deque.TryPop(item)) {
+        seen[item].fetch_add(1, std::memory_order_relaxed);
+        taken.fetch_add(1, std::memory_order_relaxed);
+    }
+    while (taken.load(std::memory_order_acquire) < N) {
+        std::this_thread::yield();
+    }
+    done.store(true, std::memory_order_release);
+    for (auto& th : thieves) {
+        th.join();
+    }
+
+    EXPECT_EQ(taken.load(), N);
+    for (int i = 0; i < N; ++i) {
+        EXPECT_EQ(seen[i].load(std::memory_order_relaxed), 1) << "element " << i;
+    }
+}